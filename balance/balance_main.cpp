@@ -0,0 +1,374 @@
+// LastStandBalance: plays thousands of full matches headless to see how a map, tower layout and
+// difficulty hold up against the current TowerRegistry stats and WaveManager scaling.
+//
+//   LastStandBalance [--map <name>] [--layout <file>] [--difficulty easy|normal|hard] [--games N]
+//                    [--threads N] [--seed N] [--csv <file>]
+//
+// Game i is seeded with seed + i and played by the scripted hero from systems/match.hpp, with towers
+// bought in layout order as gold allows (or along the path when no layout is given). Each worker
+// thread owns its Game, so registries, random streams and managers are never shared, and results
+// don't depend on the thread count.
+//
+// Layout files list towers in build order; levels above 1 are bought right after the tower:
+//   {"towers": [{"type": "arrow", "x": 6, "y": 4, "level": 2}, {"type": "ice", "x": 9, "y": 7}]}
+#include "core/game.hpp"
+#include "core/profiler.hpp"
+#include "systems/match.hpp"
+#include "systems/systems.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <expected>
+#include <fstream>
+#include <memory>
+#include <nlohmann/json.hpp>
+#include <raylib.h>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+#ifndef LASTSTAND_ASSET_DIR
+#define LASTSTAND_ASSET_DIR "assets"
+#endif
+
+namespace {
+
+using namespace ls;
+using Clock = std::chrono::steady_clock;
+
+constexpr float TICK = 1.0f / 60.0f;
+constexpr float MAX_GAME_SECONDS = 4.0f * 60.0f * 60.0f; // a match that runs longer than this counts as lost
+
+struct Options {
+    std::string map{"forest"};
+    std::string layout_path;
+    std::string csv_path;
+    Difficulty difficulty{Difficulty::Normal};
+    int games{1000};
+    int threads{0}; // 0: one per hardware thread
+    uint32_t seed{1};
+};
+
+// One purchase in a layout: a new tower, or the next level of the tower already on `cell`
+struct BuildStep {
+    TowerType type;
+    GridPos cell;
+    int from_level; // 0 places the tower
+};
+
+struct GameResult {
+    bool won{};
+    bool timed_out{};
+    WaveNum wave{}; // last wave that started
+    int kills{};
+    std::vector<int> lives_lost;  // per wave
+    std::vector<int> gold;        // on hand as each wave finished spawning; -1 for waves not reached
+    std::vector<int> gold_earned; // cumulative coin pickups at the same points
+};
+
+// Collects a GameResult from the match events of one worker's Game
+struct Recorder {
+    Game& game;
+    GameResult result;
+    bool over{false};
+
+    size_t wave_index(WaveNum wave) const {
+        auto total = static_cast<WaveNum>(result.lives_lost.size());
+        return static_cast<size_t>(std::clamp<WaveNum>(wave, 1, total) - 1);
+    }
+
+    void reset() {
+        auto waves = static_cast<size_t>(game.wave_manager.total_waves());
+        result = GameResult{};
+        result.lives_lost.assign(waves, 0);
+        result.gold.assign(waves, -1);
+        result.gold_earned.assign(waves, -1);
+        over = false;
+    }
+};
+
+void on_lives_lost(Recorder& r, const EnemyReachedExitEvent& evt) {
+    r.result.lives_lost[r.wave_index(r.game.play.current_wave)] += evt.damage;
+}
+
+void on_wave_complete(Recorder& r, const WaveCompleteEvent& evt) {
+    // The wave system keeps raising this for the waves past the last one until the field is clear
+    if (evt.wave < 1 || evt.wave > r.game.wave_manager.total_waves()) return;
+    auto i = static_cast<size_t>(evt.wave - 1);
+    r.result.gold[i] = r.game.play.gold;
+    r.result.gold_earned[i] = r.game.play.stats.gold_earned;
+}
+
+void on_game_over(Recorder& r, const GameOverEvent&) { r.over = true; }
+
+void on_victory(Recorder& r, const VictoryEvent&) {
+    r.result.won = true;
+    r.over = true;
+}
+
+std::expected<TowerType, std::string> parse_tower_type(std::string_view name) {
+    constexpr std::pair<std::string_view, TowerType> TYPES[] = {
+        {"arrow", TowerType::Arrow},         {"cannon", TowerType::Cannon}, {"ice", TowerType::Ice},
+        {"lightning", TowerType::Lightning}, {"poison", TowerType::Poison}, {"laser", TowerType::Laser},
+        {"ballista", TowerType::Ballista},
+    };
+    for (auto& [n, type] : TYPES) {
+        if (n == name) return type;
+    }
+    return std::unexpected("unknown tower type: " + std::string(name));
+}
+
+std::expected<Difficulty, std::string> parse_difficulty(std::string_view name) {
+    if (name == "easy") return Difficulty::Easy;
+    if (name == "normal") return Difficulty::Normal;
+    if (name == "hard") return Difficulty::Hard;
+    return std::unexpected("unknown difficulty: " + std::string(name));
+}
+
+const char* difficulty_name(Difficulty d) {
+    switch (d) {
+    case Difficulty::Easy:
+        return "easy";
+    case Difficulty::Normal:
+        return "normal";
+    case Difficulty::Hard:
+        return "hard";
+    }
+    return "?";
+}
+
+std::expected<std::vector<BuildStep>, std::string> load_layout(const std::string& path, const MapData& map) {
+    std::ifstream file(path);
+    if (!file.is_open()) return std::unexpected("Cannot open layout: " + path);
+
+    std::vector<BuildStep> steps;
+    std::unordered_set<GridPos, GridPosHash> used;
+    try {
+        nlohmann::json j;
+        file >> j;
+        for (auto& t : j.at("towers")) {
+            auto type = parse_tower_type(t.at("type").get<std::string>());
+            if (!type) return std::unexpected(type.error());
+            GridPos cell{t.at("x").get<int>(), t.at("y").get<int>()};
+            int level = t.value("level", 1);
+            if (level < 1 || level > TowerRegistry::MAX_LEVEL) {
+                return std::unexpected("tower level out of range at (" + std::to_string(cell.x) + ", " +
+                                       std::to_string(cell.y) + ")");
+            }
+            if (!map.is_buildable(cell) || !used.insert(cell).second) {
+                return std::unexpected("cell (" + std::to_string(cell.x) + ", " + std::to_string(cell.y) +
+                                       ") is not buildable on " + map.name);
+            }
+            for (int l = 0; l < level; ++l) steps.push_back({*type, cell, l});
+        }
+    } catch (const std::exception& e) {
+        return std::unexpected(std::string("Layout parse error: ") + e.what());
+    }
+    return steps;
+}
+
+// Buys the next layout step once it's affordable; steps are strictly in order, like a build plan
+void layout_commands(const Game& game, const std::vector<BuildStep>& layout, size_t& next,
+                     std::vector<InputCommand>& out) {
+    if (next >= layout.size()) return;
+    auto& step = layout[next];
+    int cost = step.from_level == 0 ? game.tower_registry.get(step.type, 1).cost
+                                    : game.tower_registry.upgrade_cost(step.type, step.from_level);
+    if (game.play.gold < cost) return;
+    if (step.from_level == 0) {
+        out.push_back({CommandType::PlaceTower, step.type, step.cell});
+    } else {
+        out.push_back({CommandType::UpgradeTower, {}, step.cell});
+    }
+    ++next;
+}
+
+GameResult play_game(Game& game, Recorder& rec, const std::vector<BuildStep>& layout, uint32_t seed) {
+    reset_match(game);
+    setup_new_match(game);
+    game.rng.seed(seed);
+    game.input = InputFrame{};
+    rec.reset();
+
+    size_t next_step = 0;
+    float elapsed = 0.0f;
+    while (!rec.over) {
+        auto& in = game.input;
+        in.commands.clear();
+        scripted_hero_input(game, in);
+        if (layout.empty()) {
+            scripted_build_commands(game, in.commands);
+        } else {
+            layout_commands(game, layout, next_step, in.commands);
+        }
+        systems::command_system(game);
+        systems::simulate(game, TICK);
+
+        elapsed += TICK;
+        if (elapsed > MAX_GAME_SECONDS) {
+            rec.result.timed_out = true;
+            break;
+        }
+    }
+    rec.result.wave = std::min(game.play.current_wave, game.wave_manager.total_waves());
+    rec.result.kills = game.play.stats.total_kills;
+    return std::move(rec.result);
+}
+
+void worker(const MapData& map, const Options& opts, const std::vector<BuildStep>& layout, std::atomic<int>& next_game,
+            std::vector<GameResult>& results) {
+    profile_this_thread = false;
+    auto game = std::make_unique<Game>();
+    game->current_map = map;
+    game->difficulty = opts.difficulty;
+
+    Recorder rec{*game, {}};
+    connect_match_events(*game);
+    game->dispatcher.sink<EnemyReachedExitEvent>().connect<&on_lives_lost>(rec);
+    game->dispatcher.sink<WaveCompleteEvent>().connect<&on_wave_complete>(rec);
+    game->dispatcher.sink<GameOverEvent>().connect<&on_game_over>(rec);
+    game->dispatcher.sink<VictoryEvent>().connect<&on_victory>(rec);
+
+    for (int i = next_game.fetch_add(1); i < opts.games; i = next_game.fetch_add(1)) {
+        results[static_cast<size_t>(i)] = play_game(*game, rec, layout, opts.seed + static_cast<uint32_t>(i));
+    }
+}
+
+double mean(const std::vector<double>& v) {
+    if (v.empty()) return 0.0;
+    double sum = 0.0;
+    for (double x : v) sum += x;
+    return sum / static_cast<double>(v.size());
+}
+
+double percentile(std::vector<double> v, int p) {
+    if (v.empty()) return 0.0;
+    std::sort(v.begin(), v.end());
+    return v[(v.size() - 1) * static_cast<size_t>(p) / 100];
+}
+
+void report(const Options& opts, const std::vector<GameResult>& results, WaveNum waves, double seconds,
+            std::ofstream* csv) {
+    int won = 0, timed_out = 0;
+    std::vector<double> reached;
+    for (auto& r : results) {
+        won += r.won;
+        timed_out += r.timed_out;
+        reached.push_back(static_cast<double>(r.wave));
+    }
+    double n = static_cast<double>(results.size());
+    std::printf("Survival: %.1f%% (%d/%zu)  wave reached: mean %.1f, p10 %.0f, min %.0f\n", 100.0 * won / n, won,
+                results.size(), mean(reached), percentile(reached, 10), percentile(reached, 0));
+    if (timed_out > 0) std::printf("Timed out: %d games ran past %.0f minutes\n", timed_out, MAX_GAME_SECONDS / 60);
+    std::printf("Throughput: %.0f games/min (%.1f s on %d threads)\n\n", n / seconds * 60.0, seconds, opts.threads);
+
+    // Per-wave figures are over the games that got that far
+    std::printf("%5s %8s %11s %10s %9s %9s %12s\n", "wave", "reached", "lives_lost", "gold_mean", "gold_p10",
+                "gold_p90", "earned_mean");
+    for (WaveNum w = 1; w <= waves; ++w) {
+        auto i = static_cast<size_t>(w - 1);
+        std::vector<double> lives, gold, earned;
+        for (auto& r : results) {
+            if (r.wave < w) continue;
+            lives.push_back(r.lives_lost[i]);
+            if (r.gold[i] < 0) continue;
+            gold.push_back(r.gold[i]);
+            earned.push_back(r.gold_earned[i]);
+        }
+        double pct = 100.0 * static_cast<double>(lives.size()) / n;
+        std::printf("%5u %7.1f%% %11.2f %10.0f %9.0f %9.0f %12.0f\n", w, pct, mean(lives), mean(gold),
+                    percentile(gold, 10), percentile(gold, 90), mean(earned));
+        if (csv) {
+            *csv << opts.map << ',' << difficulty_name(opts.difficulty) << ',' << w << ',' << pct << ','
+                 << mean(lives) << ',' << mean(gold) << ',' << percentile(gold, 10) << ',' << percentile(gold, 90)
+                 << ',' << mean(earned) << '\n';
+        }
+    }
+}
+
+std::expected<Options, std::string> parse_args(int argc, char** argv) {
+    Options opts;
+    for (int i = 1; i < argc; ++i) {
+        std::string_view arg = argv[i];
+        if (arg == "--map" && i + 1 < argc) {
+            opts.map = argv[++i];
+        } else if (arg == "--layout" && i + 1 < argc) {
+            opts.layout_path = argv[++i];
+        } else if (arg == "--difficulty" && i + 1 < argc) {
+            auto d = parse_difficulty(argv[++i]);
+            if (!d) return std::unexpected(d.error());
+            opts.difficulty = *d;
+        } else if (arg == "--games" && i + 1 < argc) {
+            opts.games = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--threads" && i + 1 < argc) {
+            opts.threads = std::max(0, std::atoi(argv[++i]));
+        } else if (arg == "--seed" && i + 1 < argc) {
+            opts.seed = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (arg == "--csv" && i + 1 < argc) {
+            opts.csv_path = argv[++i];
+        } else {
+            return std::unexpected("Unknown argument: " + std::string(arg));
+        }
+    }
+    if (opts.threads == 0) opts.threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    opts.threads = std::min(opts.threads, opts.games);
+    return opts;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    auto opts = parse_args(argc, argv);
+    if (!opts) {
+        std::fprintf(stderr, "%s\n", opts.error().c_str());
+        return 1;
+    }
+    SetTraceLogLevel(LOG_WARNING);
+
+    MapManager maps;
+    auto map = maps.load(std::string(LASTSTAND_ASSET_DIR "/maps/") + opts->map + ".json");
+    if (!map) {
+        std::fprintf(stderr, "%s\n", map.error().c_str());
+        return 1;
+    }
+    std::vector<BuildStep> layout;
+    if (!opts->layout_path.empty()) {
+        auto loaded = load_layout(opts->layout_path, *map);
+        if (!loaded) {
+            std::fprintf(stderr, "%s\n", loaded.error().c_str());
+            return 1;
+        }
+        layout = std::move(*loaded);
+    }
+
+    std::ofstream csv_file;
+    std::ofstream* csv = nullptr;
+    if (!opts->csv_path.empty()) {
+        csv_file.open(opts->csv_path);
+        csv_file << "map,difficulty,wave,reached_pct,lives_lost_mean,gold_mean,gold_p10,gold_p90,earned_mean\n";
+        csv = &csv_file;
+    }
+
+    std::printf("Balance: map %s, %s, layout %s, %d games on %d threads\n", map->name.c_str(),
+                difficulty_name(opts->difficulty), layout.empty() ? "auto" : opts->layout_path.c_str(), opts->games,
+                opts->threads);
+
+    std::vector<GameResult> results(static_cast<size_t>(opts->games));
+    std::atomic<int> next_game{0};
+    auto start = Clock::now();
+    {
+        std::vector<std::jthread> workers;
+        for (int t = 0; t < opts->threads; ++t) {
+            workers.emplace_back(worker, std::cref(*map), std::cref(*opts), std::cref(layout), std::ref(next_game),
+                                 std::ref(results));
+        }
+    }
+    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    report(*opts, results, WaveManager{}.total_waves(), seconds, csv);
+    return 0;
+}
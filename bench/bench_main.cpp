@@ -0,0 +1,406 @@
+// LastStandBench: times each gameplay system against synthetic registries of increasing size.
+//
+//   LastStandBench [--filter <substr>] [--sweep <name>] [--samples N] [--quick] [--csv <file>] [--render]
+//
+// Every sample rebuilds the population on a fresh Game (untimed), runs one warm-up tick, then
+// times a handful of ticks of the system under test. The median per-call time is reported along
+// with ns per entity and the log-log slope across the sweep (1.0 = linear, 2.0 = quadratic).
+#include "ai/pathfinding.hpp"
+#include "core/game.hpp"
+#include "factory/enemy_factory.hpp"
+#include "factory/hero_factory.hpp"
+#include "factory/projectile_factory.hpp"
+#include "factory/tower_factory.hpp"
+#include "systems/systems.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <expected>
+#include <fstream>
+#include <memory>
+#include <raylib.h>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#ifndef LASTSTAND_ASSET_DIR
+#define LASTSTAND_ASSET_DIR "assets"
+#endif
+
+namespace {
+
+using namespace ls;
+using Clock = std::chrono::steady_clock;
+
+constexpr float BENCH_DT = 1.0f / 60.0f;
+constexpr double CALL_BUDGET_NS = 2e9; // stop a sweep once one call takes longer than this
+const char* const SHIPPED_MAPS[] = {"forest", "desert", "castle"};
+
+struct Options {
+    std::string filter;
+    std::string sweep;
+    std::string csv_path;
+    int samples{7};
+    bool quick{false};
+    bool render{false};
+};
+
+struct Population {
+    int enemies{0};
+    int towers{0};
+    int projectiles{0};
+    int particles{0};
+};
+
+// A sweep varies one population axis; `scaled` points at the member being varied
+struct Sweep {
+    const char* name;
+    Population base;
+    int Population::* scaled;
+    std::vector<int> sizes;
+    std::vector<int> quick_sizes;
+};
+
+using SystemFn = void (*)(Game&, float);
+
+struct SystemEntry {
+    const char* name;
+    SystemFn fn;
+};
+
+const SystemEntry UPDATE_SYSTEMS[] = {
+    {"simulate", systems::simulate},
+    {"hero_system", systems::hero_system},
+    {"enemy_spawn_system", systems::enemy_spawn_system},
+    {"path_follow_system", systems::path_follow_system},
+    {"boss_system", systems::boss_system},
+    {"movement_system", systems::movement_system},
+    {"body_collision_system", systems::body_collision_system},
+    {"enemy_combat_system", systems::enemy_combat_system},
+    {"tower_targeting_system", systems::tower_targeting_system},
+    {"tower_attack_system", systems::tower_attack_system},
+    {"projectile_system", systems::projectile_system},
+    {"aura_system", systems::aura_system},
+    {"effect_system", systems::effect_system},
+    {"damage_system", systems::damage_system},
+    {"health_system", systems::health_system},
+    {"economy_system", systems::economy_system},
+    {"tower_health_system", systems::tower_health_system},
+    {"collision_system", systems::collision_system},
+    {"lifetime_system", systems::lifetime_system},
+    {"particle_system", systems::particle_system},
+    {"coin_system", systems::coin_system},
+    {"animated_sprite_system", systems::animated_sprite_system},
+    {"command_system", [](Game& g, float) { systems::command_system(g); }},
+    {"render_system", [](Game& g, float) { systems::render_system(g); }},
+    {"ui_system", [](Game& g, float) { systems::ui_system(g); }},
+};
+
+bool is_draw_system(std::string_view name) { return name == "render_system" || name == "ui_system"; }
+
+std::vector<Sweep> make_sweeps() {
+    return {
+        {"enemies", {.towers = 50}, &Population::enemies, {100, 1000, 5000, 10000, 50000}, {100, 1000, 10000}},
+        {"towers", {.enemies = 1000}, &Population::towers, {10, 50, 100, 250, 500}, {10, 100, 500}},
+        {"projectiles", {.enemies = 500, .towers = 50}, &Population::projectiles, {1000, 10000, 50000}, {1000, 10000}},
+        {"particles", {}, &Population::particles, {1000, 10000, 50000}, {1000, 10000}},
+    };
+}
+
+std::expected<MapData, std::string> load_map(const char* name) {
+    MapManager maps;
+    return maps.load(std::string(LASTSTAND_ASSET_DIR "/maps/") + name + ".json");
+}
+
+// Cells for synthetic towers, nearest to the path first so they actually engage enemies.
+// Any non-path cell qualifies: the bench wants 500 towers even where the map has fewer pads.
+std::vector<GridPos> tower_cells(const MapData& map, const std::vector<Vec2>& path) {
+    std::vector<std::pair<float, GridPos>> cells;
+    for (int y = 0; y < map.rows; ++y) {
+        for (int x = 0; x < map.cols; ++x) {
+            auto t = map.tile_at({x, y});
+            if (t == TileType::Path || t == TileType::Spawn || t == TileType::Exit) continue;
+            Vec2 c = map.grid_to_world({x, y});
+            float best = 1e30f;
+            for (auto& p : path) best = std::min(best, c.distance_to(p));
+            cells.push_back({best, {x, y}});
+        }
+    }
+    std::stable_sort(cells.begin(), cells.end(), [](auto& a, auto& b) { return a.first < b.first; });
+    std::vector<GridPos> out;
+    out.reserve(cells.size());
+    for (auto& [d, pos] : cells) out.push_back(pos);
+    return out;
+}
+
+// Builds a mid-wave match: hero at spawn, enemies spread along the path, towers hugging it,
+// projectiles in flight and a particle cloud. The wave timer is parked so no spawns happen.
+std::unique_ptr<Game> build_game(const MapData& map, const Population& pop, uint64_t seed) {
+    auto game = std::make_unique<Game>();
+    game->current_map = map;
+    game->recalculate_path();
+    game->rng.seed(seed);
+    game->play.gold = 1'000'000;
+    game->play.lives = 1'000'000;
+    game->play.current_wave = 10;
+    game->play.wave_active = false;
+    game->play.wave_timer = 1e9f;
+
+    auto& reg = game->registry;
+    auto& path = game->play.enemy_path;
+    Pcg32 rng(seed, 0xBE7C);
+
+    game->play.hero = create_hero(reg, map.grid_to_world(map.spawn));
+
+    auto cells = tower_cells(map, *path);
+    int towers = std::min<int>(pop.towers, static_cast<int>(cells.size()));
+    for (int i = 0; i < towers; ++i) {
+        auto type = static_cast<TowerType>(i % TOWER_TYPE_COUNT);
+        int level = 1 + rng.range(0, TowerRegistry::MAX_LEVEL - 1);
+        auto cell = cells[static_cast<size_t>(i)];
+        game->play.towers.place(cell, create_tower(reg, game->tower_registry.get(type, level), cell, map));
+    }
+
+    std::vector<entt::entity> enemies;
+    enemies.reserve(static_cast<size_t>(pop.enemies));
+    for (int i = 0; i < pop.enemies; ++i) {
+        // Mostly ground units with a sprinkling of every type; bosses are rare like in real waves
+        auto type = static_cast<EnemyType>(rng.range(0, 4));
+        if (i % 500 == 499) type = EnemyType::Boss;
+        bool flying = type == EnemyType::Flying;
+        auto& route = flying ? game->play.flying_path : path;
+        auto e = create_enemy(reg, type, route, 2.0f, game->play.current_wave);
+        if (e == entt::null) continue;
+        auto& pf = reg.get<PathFollower>(e);
+        auto& pts = *route;
+        if (pts.size() > 1) {
+            size_t seg = static_cast<size_t>(rng.range(0, static_cast<int>(pts.size()) - 2));
+            float t = rng.uniform();
+            pf.distance = pts.arc(seg) + (pts.arc(seg + 1) - pts.arc(seg)) * t;
+            pf.current_index = pts.next_index(pf.distance);
+            reg.get<Transform>(e).position = pts.at(pf.distance);
+        }
+        enemies.push_back(e);
+    }
+    game->play.enemies_alive = static_cast<int>(enemies.size());
+
+    for (int i = 0; i < pop.projectiles; ++i) {
+        Vec2 origin = towers > 0 ? map.grid_to_world(cells[static_cast<size_t>(i % towers)])
+                                 : map.grid_to_world(map.spawn);
+        entt::entity target = entt::null;
+        Vec2 target_pos = origin + Vec2{rng.range(-200.0f, 200.0f), rng.range(-200.0f, 200.0f)};
+        if (!enemies.empty()) {
+            target = enemies[static_cast<size_t>(rng.range(0, static_cast<int>(enemies.size()) - 1))];
+            target_pos = reg.get<Transform>(target).position;
+        }
+        game->play.shots.fire({.target = target,
+                               .origin = origin,
+                               .target_pos = target_pos,
+                               .speed = PROJECTILE_SPEED,
+                               .damage = 10,
+                               .aoe_radius = (i % 4 == 0) ? 60.0f : 0.0f,
+                               .trail_color = Color{255, 200, 50, 255}});
+    }
+
+    for (int i = 0; i < pop.particles; ++i) {
+        Vec2 pos = map.grid_to_world({rng.range(0, map.cols - 1), rng.range(0, map.rows - 1)});
+        Vec2 vel{rng.range(-80.0f, 80.0f), rng.range(-80.0f, 80.0f)};
+        // Long lifetimes so the population does not thin out while it is being timed
+        create_particle(reg, pos, vel, Color{255, 120, 40, 255}, 3.0f, 1000.0f);
+    }
+
+    return game;
+}
+
+int population_size(const Population& pop) { return pop.enemies + pop.towers + pop.projectiles + pop.particles; }
+
+double median(std::vector<double> v) {
+    std::sort(v.begin(), v.end());
+    size_t n = v.size();
+    return n % 2 ? v[n / 2] : 0.5 * (v[n / 2 - 1] + v[n / 2]);
+}
+
+// Least-squares slope of log(ns) over log(n)
+double scaling_exponent(const std::vector<std::pair<int, double>>& points) {
+    if (points.size() < 2) return 0.0;
+    double sx = 0, sy = 0, sxx = 0, sxy = 0;
+    for (auto& [n, ns] : points) {
+        double x = std::log(static_cast<double>(n));
+        double y = std::log(std::max(ns, 1.0));
+        sx += x;
+        sy += y;
+        sxx += x * x;
+        sxy += x * y;
+    }
+    double k = static_cast<double>(points.size());
+    double denom = k * sxx - sx * sx;
+    return denom != 0.0 ? (k * sxy - sx * sy) / denom : 0.0;
+}
+
+double time_system(const MapData& map, const Population& pop, const SystemEntry& sys, const Options& opts) {
+    bool draw = is_draw_system(sys.name);
+    int iterations = opts.quick ? 3 : 10;
+    std::vector<double> samples;
+    for (int s = 0; s < opts.samples; ++s) {
+        auto game = build_game(map, pop, 0x5EED + static_cast<uint64_t>(s));
+        if (draw) {
+            load_assets(*game);
+            systems::bake_tile_layer(*game);
+        }
+
+        auto call = [&] {
+            if (draw) BeginDrawing();
+            sys.fn(*game, BENCH_DT);
+            if (draw) EndDrawing();
+        };
+        call(); // warm-up: first-touch allocations, view pools
+
+        auto start = Clock::now();
+        for (int i = 0; i < iterations; ++i) call();
+        auto elapsed = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+        samples.push_back(elapsed / iterations);
+
+        if (draw) systems::unload_tile_layer(*game);
+        if (samples.back() > CALL_BUDGET_NS) break;
+    }
+    return median(std::move(samples));
+}
+
+void run_system_sweeps(const MapData& map, const Options& opts, std::ofstream* csv) {
+    for (auto& sweep : make_sweeps()) {
+        if (!opts.sweep.empty() && opts.sweep != sweep.name) continue;
+        auto& sizes = opts.quick ? sweep.quick_sizes : sweep.sizes;
+
+        std::printf("\n== sweep: %s (map %s) ==\n", sweep.name, map.name.c_str());
+        std::printf("%-24s", "system");
+        for (int n : sizes) std::printf(" %14d", n);
+        std::printf(" %8s\n", "slope");
+
+        for (auto& sys : UPDATE_SYSTEMS) {
+            if (!opts.filter.empty() && std::string_view(sys.name).find(opts.filter) == std::string_view::npos) {
+                continue;
+            }
+            if (is_draw_system(sys.name) && !opts.render) continue;
+
+            std::printf("%-24s", sys.name);
+            std::fflush(stdout);
+            std::vector<std::pair<int, double>> points;
+            bool over_budget = false;
+            for (int n : sizes) {
+                if (over_budget) {
+                    std::printf(" %14s", "-");
+                    continue;
+                }
+                Population pop = sweep.base;
+                pop.*sweep.scaled = n;
+                double ns = time_system(map, pop, sys, opts);
+                points.push_back({n, ns});
+                over_budget = ns > CALL_BUDGET_NS;
+                std::printf(" %11.0f ns", ns);
+                std::fflush(stdout);
+                if (csv) {
+                    *csv << sweep.name << ',' << sys.name << ',' << map.name << ',' << n << ',' << ns << ','
+                         << ns / n << ',' << ns / std::max(population_size(pop), 1) << '\n';
+                }
+            }
+            std::printf(" %8.2f\n", scaling_exponent(points));
+
+            // ns per entity of the swept kind at the largest size that ran
+            if (!points.empty()) {
+                auto [n, ns] = points.back();
+                std::printf("%-24s %.1f ns/entity at n=%d\n", "", ns / n, n);
+            }
+        }
+    }
+}
+
+void run_pathfinding(const Options& opts, std::ofstream* csv) {
+    if (!opts.filter.empty() && std::string_view("find_path").find(opts.filter) == std::string_view::npos) return;
+    if (!opts.sweep.empty() && opts.sweep != "pathfinding") return;
+
+    std::printf("\n== Pathfinder::find_path (spawn -> exit) ==\n");
+    std::printf("%-10s %8s %8s %14s %12s\n", "map", "tiles", "length", "ns/call", "ns/tile");
+    int iterations = opts.quick ? 20 : 200;
+    for (auto* name : SHIPPED_MAPS) {
+        auto map = load_map(name);
+        if (!map) {
+            std::printf("%-10s %s\n", name, map.error().c_str());
+            continue;
+        }
+        std::vector<double> samples;
+        size_t length = 0;
+        for (int s = 0; s < opts.samples; ++s) {
+            auto start = Clock::now();
+            for (int i = 0; i < iterations; ++i) {
+                auto path = Pathfinder::find_path(*map, map->spawn, map->exit_pos);
+                length = path.size();
+            }
+            samples.push_back(std::chrono::duration<double, std::nano>(Clock::now() - start).count() / iterations);
+        }
+        double ns = median(std::move(samples));
+        int tiles = map->cols * map->rows;
+        std::printf("%-10s %8d %8zu %14.0f %12.2f\n", name, tiles, length, ns, ns / tiles);
+        if (csv) *csv << "pathfinding,find_path," << map->name << ',' << tiles << ',' << ns << ',' << ns / tiles << ",\n";
+    }
+}
+
+Options parse_args(int argc, char** argv) {
+    Options opts;
+    for (int i = 1; i < argc; ++i) {
+        std::string_view arg = argv[i];
+        if (arg == "--filter" && i + 1 < argc) {
+            opts.filter = argv[++i];
+        } else if (arg == "--sweep" && i + 1 < argc) {
+            opts.sweep = argv[++i];
+        } else if (arg == "--samples" && i + 1 < argc) {
+            opts.samples = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--csv" && i + 1 < argc) {
+            opts.csv_path = argv[++i];
+        } else if (arg == "--quick") {
+            opts.quick = true;
+            opts.samples = std::min(opts.samples, 3);
+        } else if (arg == "--render") {
+            opts.render = true;
+        } else {
+            std::fprintf(stderr, "Unknown argument: %s\n", argv[i]);
+        }
+    }
+    return opts;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    auto opts = parse_args(argc, argv);
+    SetTraceLogLevel(LOG_WARNING);
+
+    std::ofstream csv_file;
+    std::ofstream* csv = nullptr;
+    if (!opts.csv_path.empty()) {
+        csv_file.open(opts.csv_path);
+        csv_file << "sweep,system,map,n,ns_per_call,ns_per_entity,ns_per_total_entity\n";
+        csv = &csv_file;
+    }
+
+    // Draw systems need a GL context; a hidden window keeps the numbers free of compositor noise
+    if (opts.render) {
+        SetConfigFlags(FLAG_WINDOW_HIDDEN);
+        InitWindow(SCREEN_WIDTH, SCREEN_HEIGHT, "LastStandBench");
+        SetTargetFPS(0);
+        ChangeDirectory(LASTSTAND_ASSET_DIR "/.."); // load_assets uses paths relative to the repo root
+    }
+
+    // Entity sweeps run on the first shipped map; the path shape matters far less than the counts
+    auto map = load_map(SHIPPED_MAPS[0]);
+    if (!map) {
+        std::fprintf(stderr, "%s\n", map.error().c_str());
+        return 1;
+    }
+    run_system_sweeps(*map, opts, csv);
+    run_pathfinding(opts, csv);
+
+    if (opts.render) CloseWindow();
+    return 0;
+}
@@ -1,6 +1,9 @@
 #pragma once
+#include "core/path.hpp"
 #include "core/types.hpp"
+#include <array>
 #include <entt/entt.hpp>
+#include <memory>
 #include <optional>
 #include <string>
 #include <vector>
@@ -118,14 +121,21 @@ struct Tower {
     float effect_duration{};
     float aoe_radius{};
     int chain_count{};
+    int pierce{};
+    TargetMode target_mode{TargetMode::First};
 };
 
 // === Projectile ===
 
+// A shot in flight. Shots aren't entities: each flies a straight line from `origin` to an intercept
+// point fixed when it is fired, so it lives in PlayState::shots (an ImpactQueue) until impact_time
+// and render draws it where it would be by then.
 struct Projectile {
-    entt::entity source{entt::null};
     entt::entity target{entt::null};
+    Vec2 origin{};
     Vec2 target_pos{};
+    float fire_time{};
+    float impact_time{};
     float speed{300.0f};
     int damage{};
     DamageType damage_type{DamageType::Physical};
@@ -134,6 +144,37 @@ struct Projectile {
     float effect_duration{};
     int chain_count{};
     Color trail_color{WHITE};
+    TowerType sprite{TowerType::Arrow}; // whose projectile texture to draw
+    float size{8.0f};
+};
+
+// A shot that flies straight and hits whatever its path crosses instead of one chosen target (the
+// Ballista's bolts). Each tick's step is swept against an enemy broadphase, so however fast it goes it
+// can't step over an enemy between ticks.
+struct Bolt {
+    static constexpr int MAX_HITS = 8;
+
+    Vec2 position{};
+    Vec2 direction{}; // unit
+    float speed{};
+    float travel{}; // distance left before it drops
+    float radius{};
+    int damage{};
+    int pierce{}; // enemies it passes through after the first
+    int hit_count{};
+    std::array<entt::entity, MAX_HITS> hit{}; // enemies already struck, which it never strikes again
+    Color color{WHITE};
+};
+
+// A lightning chain drawn as one polyline through every enemy it struck, fading out over its life.
+// The hops are resolved the moment the first shot lands, so this is only the picture of them.
+struct ChainArc {
+    static constexpr int MAX_POINTS = 8;
+
+    std::array<Vec2, MAX_POINTS> points{};
+    int count{};
+    float life{}; // seconds left
+    Color color{WHITE};
 };
 
 // === Enemy ===
@@ -148,11 +189,14 @@ struct Enemy {
     float collision_radius{10.0f};
 };
 
+// Position is path->at(distance) plus whatever sideways offset pushes have left, which drifts back to
+// the path. current_index is the waypoint being walked toward, kept in step with distance.
 struct PathFollower {
-    std::vector<Vec2> path;
+    SharedPath path;
     size_t current_index{};
     float speed{};
     float base_speed{};
+    float distance{};
 };
 
 struct Boss {
@@ -0,0 +1,23 @@
+#pragma once
+#include <cstdint>
+
+// Allocation counting is opt-in (cmake -DLASTSTAND_ALLOC_TRACKING=ON). The counters only move in
+// executables that link src/core/alloc_hooks.cpp, which replaces the global operator new.
+#ifndef LASTSTAND_ALLOC_TRACKING
+#define LASTSTAND_ALLOC_TRACKING 0
+#endif
+
+namespace ls {
+
+inline constexpr bool ALLOC_TRACKING = LASTSTAND_ALLOC_TRACKING != 0;
+
+// Running totals for the calling thread. Only ever grows; measure by taking the difference
+// between two reads on the same thread.
+struct AllocCounters {
+    uint64_t count{};
+    uint64_t bytes{};
+};
+
+inline thread_local AllocCounters alloc_counters{};
+
+} // namespace ls
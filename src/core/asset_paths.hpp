@@ -44,6 +44,7 @@ inline constexpr const char* TOWER_ICE = "tower_ice";
 inline constexpr const char* TOWER_LIGHTNING = "tower_lightning";
 inline constexpr const char* TOWER_POISON = "tower_poison";
 inline constexpr const char* TOWER_LASER = "tower_laser";
+inline constexpr const char* TOWER_BALLISTA = "tower_ballista";
 
 // === Enemies ===
 inline constexpr const char* ENEMY_GRUNT = "enemy_grunt";
@@ -62,6 +63,7 @@ inline constexpr const char* PROJ_CANNON = "proj_cannon";
 inline constexpr const char* PROJ_ICE = "proj_ice";
 inline constexpr const char* PROJ_LIGHTNING = "proj_lightning";
 inline constexpr const char* PROJ_POISON = "proj_poison";
+inline constexpr const char* PROJ_BOLT = "proj_bolt";
 
 // === Pickups ===
 inline constexpr const char* COIN_SPRITE = "coin_sprite";
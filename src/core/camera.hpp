@@ -0,0 +1,47 @@
+#pragma once
+#include "constants.hpp"
+#include "types.hpp"
+#include <algorithm>
+
+namespace ls {
+
+// Render detail tier picked from the camera zoom
+enum class LodLevel : uint8_t { Full, Reduced, Minimal };
+
+// Smallest zoom that still fits the whole map on screen
+inline float min_zoom(int cols, int rows) {
+    float fit_w = static_cast<float>(SCREEN_WIDTH) / static_cast<float>(cols * TILE_SIZE);
+    float fit_h = static_cast<float>(SCREEN_HEIGHT) / static_cast<float>(rows * TILE_SIZE);
+    return std::min({fit_w, fit_h, 1.0f});
+}
+
+inline LodLevel lod_for_zoom(float zoom) {
+    if (zoom < LOD_MINIMAL_ZOOM) return LodLevel::Minimal;
+    if (zoom < LOD_REDUCED_ZOOM) return LodLevel::Reduced;
+    return LodLevel::Full;
+}
+
+// Only every Nth particle is drawn at lower detail tiers
+inline int lod_particle_stride(LodLevel lod) {
+    switch (lod) {
+    case LodLevel::Full:
+        return 1;
+    case LodLevel::Reduced:
+        return 2;
+    case LodLevel::Minimal:
+        return 4;
+    }
+    return 1;
+}
+
+// Keep the view inside the world; centre an axis when the world is smaller than the view
+inline Vec2 clamp_camera_target(Vec2 target, float zoom, float world_w, float world_h) {
+    float half_w = SCREEN_WIDTH / (2.0f * zoom);
+    float half_h = SCREEN_HEIGHT / (2.0f * zoom);
+    Vec2 out;
+    out.x = (world_w <= half_w * 2.0f) ? world_w / 2.0f : std::clamp(target.x, half_w, world_w - half_w);
+    out.y = (world_h <= half_h * 2.0f) ? world_h / 2.0f : std::clamp(target.y, half_h, world_h - half_h);
+    return out;
+}
+
+} // namespace ls
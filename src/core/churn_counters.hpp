@@ -0,0 +1,186 @@
+#pragma once
+#include "core/enemy_index.hpp"
+#include "core/snapshot.hpp"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <entt/entt.hpp>
+#include <format>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace ls {
+
+// Entities plus every component type, saved or runtime-only, in the order the counters are stored
+using ChurnTypes = entt::type_list_cat_t<entt::type_list<entt::entity>, SnapshotComponents, RuntimeComponents>;
+
+// Counts creations and destructions per component type through the registry's on_construct and
+// on_destroy signals, and samples pool sizes once per frame. Replacing a component is neither.
+class ChurnCounters {
+  public:
+    static constexpr size_t TYPES = ChurnTypes::size;
+    static constexpr size_t HISTORY = 240; // frames averaged for the overlay
+
+    struct Row {
+        std::string_view name;
+        double created{};   // per frame, over the recent history
+        double destroyed{}; // per frame, over the recent history
+        uint32_t peak_created{};
+        uint64_t total_created{};
+        uint64_t total_destroyed{};
+        size_t size{};
+        size_t capacity{};
+        size_t peak_size{};
+    };
+
+    ChurnCounters() = default;
+    ChurnCounters(const ChurnCounters&) = delete; // the registry's signals hold a pointer to this
+    ChurnCounters& operator=(const ChurnCounters&) = delete;
+
+    bool attached() const { return attached_; }
+
+    void attach(entt::registry& reg) {
+        if (attached_) return;
+        connect(reg, ChurnTypes{});
+        attached_ = true;
+    }
+
+    void detach(entt::registry& reg) {
+        if (!attached_) return;
+        disconnect(reg, ChurnTypes{});
+        attached_ = false;
+    }
+
+    // Commits this frame's counts and samples every pool; call once per frame
+    void end_frame(entt::registry& reg) {
+        if (!attached_) return;
+        sample_pools(reg, ChurnTypes{});
+        size_t slot = frames_ % HISTORY;
+        for (auto& c : counters_) {
+            c.created_hist[slot] = c.created;
+            c.destroyed_hist[slot] = c.destroyed;
+            c.created = c.destroyed = 0;
+        }
+        ++frames_;
+    }
+
+    uint64_t frames() const { return frames_; }
+
+    // Types that have seen any traffic, busiest first. `recent` averages over the last HISTORY
+    // frames; otherwise over the whole run.
+    std::vector<Row> rows(bool recent = true) const {
+        std::vector<Row> out;
+        size_t window = std::min<uint64_t>(frames_, HISTORY);
+        for (size_t i = 0; i < TYPES; ++i) {
+            auto& c = counters_[i];
+            if (c.total_created == 0 && c.size == 0) continue;
+            Row r{.name = names_[i],
+                  .total_created = c.total_created,
+                  .total_destroyed = c.total_destroyed,
+                  .size = c.size,
+                  .capacity = c.capacity,
+                  .peak_size = c.peak_size};
+            for (size_t f = 0; f < window; ++f) r.peak_created = std::max(r.peak_created, c.created_hist[f]);
+            if (recent && window > 0) {
+                uint64_t created = 0, destroyed = 0;
+                for (size_t f = 0; f < window; ++f) {
+                    created += c.created_hist[f];
+                    destroyed += c.destroyed_hist[f];
+                }
+                r.created = static_cast<double>(created) / static_cast<double>(window);
+                r.destroyed = static_cast<double>(destroyed) / static_cast<double>(window);
+            } else if (frames_ > 0) {
+                r.created = static_cast<double>(c.total_created) / static_cast<double>(frames_);
+                r.destroyed = static_cast<double>(c.total_destroyed) / static_cast<double>(frames_);
+            }
+            out.push_back(r);
+        }
+        std::stable_sort(out.begin(), out.end(), [](auto& a, auto& b) {
+            return a.total_created + a.total_destroyed > b.total_created + b.total_destroyed;
+        });
+        return out;
+    }
+
+    // Plain-text table for headless runs
+    std::string report() const {
+        std::string out = std::format("Entity churn over {} frames\n", frames_);
+        out += std::format("{:<16}{:>12}{:>12}{:>10}{:>10}{:>10}{:>10}{:>10}\n", "type", "created", "destroyed",
+                           "new/frame", "peak/frm", "size", "peak", "capacity");
+        for (auto& r : rows(false)) {
+            out += std::format("{:<16}{:>12}{:>12}{:>10.2f}{:>10}{:>10}{:>10}{:>10}\n", r.name, r.total_created,
+                               r.total_destroyed, r.created, r.peak_created, r.size, r.peak_size, r.capacity);
+        }
+        return out;
+    }
+
+  private:
+    struct Counter {
+        uint32_t created{};
+        uint32_t destroyed{};
+        uint64_t total_created{};
+        uint64_t total_destroyed{};
+        size_t size{};
+        size_t capacity{};
+        size_t peak_size{};
+        std::array<uint32_t, HISTORY> created_hist{};
+        std::array<uint32_t, HISTORY> destroyed_hist{};
+    };
+
+    std::array<Counter, TYPES> counters_{};
+    std::array<std::string_view, TYPES> names_{};
+    uint64_t frames_{0};
+    bool attached_{false};
+
+    template <typename T>
+    static constexpr size_t index = entt::type_list_index_v<T, ChurnTypes>;
+
+    template <typename T>
+    void on_construct(entt::registry&, entt::entity) {
+        ++counters_[index<T>].created;
+        ++counters_[index<T>].total_created;
+    }
+
+    template <typename T>
+    void on_destroy(entt::registry&, entt::entity) {
+        ++counters_[index<T>].destroyed;
+        ++counters_[index<T>].total_destroyed;
+    }
+
+    static std::string_view short_name(std::string_view name) {
+        if (auto pos = name.rfind("::"); pos != std::string_view::npos) name.remove_prefix(pos + 2);
+        return name;
+    }
+
+    template <typename... T>
+    void connect(entt::registry& reg, entt::type_list<T...>) {
+        ((names_[index<T>] = short_name(entt::type_name<T>::value())), ...);
+        (reg.on_construct<T>().template connect<&ChurnCounters::on_construct<T>>(*this), ...);
+        (reg.on_destroy<T>().template connect<&ChurnCounters::on_destroy<T>>(*this), ...);
+    }
+
+    template <typename... T>
+    void disconnect(entt::registry& reg, entt::type_list<T...>) {
+        (reg.on_construct<T>().template disconnect<&ChurnCounters::on_construct<T>>(*this), ...);
+        (reg.on_destroy<T>().template disconnect<&ChurnCounters::on_destroy<T>>(*this), ...);
+    }
+
+    template <typename... T>
+    void sample_pools(entt::registry& reg, entt::type_list<T...>) {
+        auto sample = [&]<typename Type>(Counter& c) {
+            auto& storage = reg.storage<Type>();
+            // The entity pool keeps released ids for reuse; only the ones in use count
+            if constexpr (std::is_same_v<Type, entt::entity>) {
+                c.size = storage.free_list();
+            } else {
+                c.size = storage.size();
+            }
+            c.capacity = storage.capacity();
+            c.peak_size = std::max(c.peak_size, c.size);
+        };
+        (sample.template operator()<T>(counters_[index<T>]), ...);
+    }
+};
+
+} // namespace ls
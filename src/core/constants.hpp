@@ -25,13 +25,30 @@ inline constexpr int HERO_BASE_HP = 200;
 inline constexpr int HERO_XP_PER_LEVEL = 100;
 
 inline constexpr float PROJECTILE_SPEED = 500.0f;
+inline constexpr float BOLT_SPEED = 900.0f;
+inline constexpr float BOLT_RADIUS = 6.0f;
+inline constexpr float BOLT_REACH = 1.25f;     // bolts fly this many times their tower's range
+inline constexpr float CHAIN_RANGE = 100.0f;   // furthest a lightning chain hops between enemies
+inline constexpr float CHAIN_ARC_LIFE = 0.25f; // seconds a chain's polyline stays on screen
 inline constexpr float FLOATING_TEXT_DURATION = 1.0f;
 inline constexpr float FLOATING_TEXT_SPEED = 40.0f;
 
+inline constexpr float PATH_RECOVERY = 0.5f;                     // share of speed a pushed enemy drifts back at
+inline constexpr int LEAD_ITERATIONS = 4;                        // refinements of a shot's intercept point
+inline constexpr float TARGET_PATH_SLACK = TILE_SIZE * 0.5f;     // how far enemies get pushed off the path
+inline constexpr int RETARGET_BUDGET = 16;                       // target searches per tick, round-robin
+inline constexpr float RETARGET_LEAD = 0.1f;                     // s before its next shot a tower searches
+inline constexpr float TARGET_SWITCH_MARGIN = TILE_SIZE * 0.25f; // px a new target must win by
+
 inline constexpr int HUD_HEIGHT = 48;
 inline constexpr int PANEL_WIDTH = 220;
 
 inline constexpr float WAVE_DELAY = 2.0f;
 inline constexpr float SPAWN_INTERVAL = 0.35f;
 
+inline constexpr float ZOOM_MAX = 1.5f;
+inline constexpr float ZOOM_STEP = 0.1f;
+inline constexpr float LOD_REDUCED_ZOOM = 0.85f;
+inline constexpr float LOD_MINIMAL_ZOOM = 0.65f;
+
 } // namespace ls
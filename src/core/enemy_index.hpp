@@ -0,0 +1,314 @@
+#pragma once
+#include "components/components.hpp"
+#include "types.hpp"
+#include <algorithm>
+#include <cmath>
+#include <entt/entt.hpp>
+#include <optional>
+#include <vector>
+
+namespace ls {
+
+// Tags enemies the index already holds, so finding new spawns is a view exclude rather than a search
+struct InEnemyIndex {};
+
+struct TowerCoverage;
+
+// Live path-following enemies grouped by route and ordered by PathFollower::distance.
+// update() refreshes the distances in place and re-sorts with an insertion sort, which is close to
+// linear because enemies on one route rarely overtake each other between ticks. A tower turns its
+// range into the stretches of each route it covers (coverage()), after which "first enemy in range"
+// is a binary search plus a short walk instead of a scan over every enemy.
+//
+// The index also watches every tower's stretches (watch()). When update() sees an enemy walk onto a
+// watched stretch, or spawn on one, it wakes that tower's TowerCoverage. A dormant tower therefore costs
+// nothing to keep asleep, and the wake-up costs a binary search per enemy that moved.
+class EnemyIndex {
+  public:
+    struct Entry {
+        float progress; // distance from the route's first waypoint
+        entt::entity entity;
+    };
+
+    // A closed stretch of a route, in distance along it
+    struct Span {
+        float from;
+        float to;
+    };
+
+    // A tower's covered stretch, which wakes the tower when an enemy enters it
+    struct Watch {
+        Span span;
+        entt::entity tower;
+    };
+
+    struct Route {
+        SharedPath path;
+        std::vector<Entry> entries; // ascending progress
+        std::vector<Watch> watches; // ascending span.from
+
+        float length() const { return path->length(); }
+    };
+
+    // Changes whenever a route is added or the index is cleared; coverage computed against an older
+    // version is stale. A map has a ground and a flying route, registered by Game::recalculate_path
+    // before anything spawns, so towers can compute their coverage as they are placed.
+    uint32_t version() const { return version_; }
+    const std::vector<Route>& routes() const { return routes_; }
+
+    size_t size() const {
+        size_t n = 0;
+        for (auto& r : routes_) n += r.entries.size();
+        return n;
+    }
+
+    // Call when the registry is cleared or reloaded; entity handles from before may be reused
+    void clear() {
+        routes_.clear();
+        watched_ = 0;
+        ++version_;
+    }
+
+    // Sizes each route for `n` enemies up front, so a tick at peak population doesn't allocate
+    void reserve(size_t n) {
+        capacity_ = n;
+        added_.reserve(n);
+        for (auto& r : routes_) r.entries.reserve(n);
+    }
+
+    // Registers a route (a no-op if one with the same waypoints is already held) and returns its slot
+    size_t add_route(const SharedPath& path) {
+        if (!path || path->empty()) return routes_.size();
+        auto& r = route_for(path);
+        return static_cast<size_t>(&r - routes_.data());
+    }
+
+    void update(entt::registry& reg) {
+        if (watches_dirty_) {
+            for (auto& route : routes_) {
+                std::sort(route.watches.begin(), route.watches.end(),
+                          [](const Watch& a, const Watch& b) { return a.span.from < b.span.from; });
+            }
+            watches_dirty_ = false;
+        }
+
+        // Refresh the enemies already held, compacting out the dead and waking the towers whose stretch
+        // an enemy walked onto since the last update
+        for (auto& route : routes_) {
+            size_t kept = 0;
+            for (auto en : route.entries) {
+                if (!reg.valid(en.entity) || reg.all_of<Dead>(en.entity)) continue;
+                auto* pf = reg.try_get<PathFollower>(en.entity);
+                if (!pf) continue;
+                float was = en.progress;
+                en.progress = progress_along(route, *pf);
+                if (en.progress > was) wake_entered(reg, route, was, en.progress);
+                route.entries[kept++] = en;
+            }
+            route.entries.resize(kept);
+        }
+
+        added_.clear();
+        for (auto [e, en, pf] : reg.view<Enemy, PathFollower>(entt::exclude<Dead, InEnemyIndex>).each()) {
+            if (!pf.path || pf.path->empty()) continue;
+            auto& route = route_for(pf.path);
+            float progress = progress_along(route, pf);
+            route.entries.push_back({progress, e});
+            wake_covering(reg, route, progress);
+            added_.push_back(e);
+        }
+        reg.insert<InEnemyIndex>(added_.begin(), added_.end());
+
+        for (auto& route : routes_) sort_entries(route.entries);
+    }
+
+    // Forgets every watched stretch; watch() each tower again afterwards
+    void clear_watches() {
+        for (auto& r : routes_) r.watches.clear();
+        watched_ = 0;
+    }
+
+    // Watches a tower's stretches, per route in routes() order, until the next clear_watches()
+    void watch(entt::entity tower, const std::vector<std::vector<Span>>& spans) {
+        for (size_t i = 0; i < spans.size() && i < routes_.size(); ++i) {
+            for (auto& s : spans[i]) routes_[i].watches.push_back({s, tower});
+        }
+        ++watched_;
+        watches_dirty_ = true;
+    }
+
+    // Towers watched since the last clear_watches() or clear()
+    size_t watched() const { return watched_; }
+
+    // Distance an enemy has left to the end of its route. Empty when the route isn't indexed.
+    std::optional<float> remaining(const PathFollower& pf) const {
+        if (!pf.path) return std::nullopt;
+        for (auto& r : routes_) {
+            if (r.path == pf.path || *r.path == *pf.path) return r.length() - progress_along(r, pf);
+        }
+        return std::nullopt;
+    }
+
+    // Appends the stretches of `route` lying within `radius` of `center`, ascending and merged
+    static void coverage(const Route& route, Vec2 center, float radius, std::vector<Span>& out) {
+        auto& pts = *route.path;
+        if (pts.size() == 1 && pts[0].distance_to(center) <= radius) out.push_back({0.0f, 0.0f});
+        for (size_t i = 1; i < pts.size(); ++i) {
+            float len = pts.arc(i) - pts.arc(i - 1);
+            if (len <= 0.0f) continue;
+            // Solve |a + dir * t - center| = radius for t along the segment
+            Vec2 dir = (pts[i] - pts[i - 1]) * (1.0f / len);
+            Vec2 f = pts[i - 1] - center;
+            float b = dir.x * f.x + dir.y * f.y;
+            float disc = b * b - (f.x * f.x + f.y * f.y - radius * radius);
+            if (disc < 0.0f) continue;
+            float root = std::sqrt(disc);
+            float t0 = std::max(0.0f, -b - root);
+            float t1 = std::min(len, -b + root);
+            if (t0 > t1) continue;
+            Span s{pts.arc(i - 1) + t0, pts.arc(i - 1) + t1};
+            if (!out.empty() && s.from <= out.back().to) {
+                out.back().to = std::max(out.back().to, s.to);
+            } else {
+                out.push_back(s);
+            }
+        }
+    }
+
+    // Whether any enemy the index holds is inside the span
+    static bool any_in(const Route& route, Span span) {
+        auto& v = route.entries;
+        auto it = std::lower_bound(v.begin(), v.end(), span.from,
+                                   [](const Entry& en, float p) { return en.progress < p; });
+        return it != v.end() && it->progress <= span.to;
+    }
+
+    // Calls fn(entry) for the route's enemies inside the span, furthest along first or (when
+    // !furthest_first) nearest the start first. Stops and returns false as soon as fn returns false.
+    template <typename Fn>
+    static bool for_each_in(const Route& route, Span span, bool furthest_first, Fn&& fn) {
+        auto& v = route.entries;
+        auto first = std::lower_bound(v.begin(), v.end(), span.from,
+                                      [](const Entry& en, float p) { return en.progress < p; });
+        auto last = std::upper_bound(first, v.end(), span.to, [](float p, const Entry& en) { return p < en.progress; });
+        if (furthest_first) {
+            for (auto it = last; it != first;) {
+                if (!fn(*--it)) return false;
+            }
+        } else {
+            for (auto it = first; it != last; ++it) {
+                if (!fn(*it)) return false;
+            }
+        }
+        return true;
+    }
+
+  private:
+    std::vector<Route> routes_;
+    std::vector<entt::entity> added_;
+    size_t capacity_{0};
+    size_t watched_{0};
+    bool watches_dirty_{false};
+    uint32_t version_{0};
+
+    static void wake(entt::registry& reg, entt::entity tower);
+
+    // Wakes the towers with a stretch starting in (was, now]
+    static void wake_entered(entt::registry& reg, const Route& route, float was, float now) {
+        auto& w = route.watches;
+        auto it = std::upper_bound(w.begin(), w.end(), was, [](float p, const Watch& x) { return p < x.span.from; });
+        for (; it != w.end() && it->span.from <= now; ++it) wake(reg, it->tower);
+    }
+
+    // Wakes the towers with a stretch containing `progress`
+    static void wake_covering(entt::registry& reg, const Route& route, float progress) {
+        for (auto& x : route.watches) {
+            if (x.span.from > progress) break;
+            if (x.span.to >= progress) wake(reg, x.tower);
+        }
+    }
+
+    // Enemies walking a route recalculated since they spawned hold a different pointer to the same
+    // waypoints, so routes are matched by content when the pointer differs
+    Route& route_for(const SharedPath& path) {
+        for (auto& r : routes_) {
+            if (r.path == path || *r.path == *path) return r;
+        }
+        auto& r = routes_.emplace_back();
+        r.path = path;
+        r.entries.reserve(capacity_);
+        ++version_;
+        return r;
+    }
+
+    static float progress_along(const Route& route, const PathFollower& pf) {
+        return std::clamp(pf.distance, 0.0f, route.length());
+    }
+
+    static void sort_entries(std::vector<Entry>& v) {
+        for (size_t i = 1; i < v.size(); ++i) {
+            Entry x = v[i];
+            size_t j = i;
+            for (; j > 0 && v[j - 1].progress > x.progress; --j) v[j] = v[j - 1];
+            v[j] = x;
+        }
+    }
+};
+
+// A tower's stretches of each indexed route, per route in EnemyIndex::routes() order. Computed when
+// the tower is placed and again only when the index's routes or the covered radius change; towers
+// don't move. A tower that finds no enemy on any of its stretches goes dormant and skips targeting
+// until the index wakes it (see EnemyIndex::watch()).
+struct TowerCoverage {
+    uint32_t version{~0u};
+    float radius{-1.0f};
+    bool awake{true};
+    std::vector<std::vector<EnemyIndex::Span>> spans;
+
+    // Recomputes the stretches if they are stale and returns whether it did; a recomputed tower wakes
+    bool refresh(const EnemyIndex& index, Vec2 center, float r) {
+        if (version == index.version() && radius == r) return false;
+        version = index.version();
+        radius = r;
+        awake = true;
+        auto& routes = index.routes();
+        spans.resize(routes.size());
+        for (size_t i = 0; i < routes.size(); ++i) {
+            spans[i].clear();
+            EnemyIndex::coverage(routes[i], center, r, spans[i]);
+        }
+        return true;
+    }
+
+    bool covers_enemy(const EnemyIndex& index) const {
+        auto& routes = index.routes();
+        for (size_t i = 0; i < spans.size() && i < routes.size(); ++i) {
+            for (auto& s : spans[i]) {
+                if (EnemyIndex::any_in(routes[i], s)) return true;
+            }
+        }
+        return false;
+    }
+
+    // Path length covered on one route
+    float covered(size_t route) const {
+        float total = 0.0f;
+        if (route < spans.size()) {
+            for (auto& s : spans[route]) total += s.to - s.from;
+        }
+        return total;
+    }
+};
+
+inline void EnemyIndex::wake(entt::registry& reg, entt::entity tower) {
+    // A watched tower sold since the watches were last rebuilt may have had its id reused; waking
+    // whatever holds it now only costs that tower one coverage check
+    if (!reg.valid(tower)) return;
+    if (auto* cov = reg.try_get<TowerCoverage>(tower)) cov->awake = true;
+}
+
+// Components attached while a match runs and rebuilt after a load rather than saved. Tools that watch
+// every pool (churn counters, the soak test) count these alongside SnapshotComponents.
+using RuntimeComponents = entt::type_list<InEnemyIndex, TowerCoverage>;
+
+} // namespace ls
@@ -2,7 +2,19 @@
 #include "ai/pathfinding.hpp"
 #include "constants.hpp"
 #include "core/asset_paths.hpp"
+#include "core/churn_counters.hpp"
+#include "core/enemy_index.hpp"
 #include "core/hero_upgrades.hpp"
+#include "core/impact_queue.hpp"
+#include "core/input.hpp"
+#include "core/profiler.hpp"
+#include "core/random.hpp"
+#include "core/raylib_renderer.hpp"
+#include "core/replay.hpp"
+#include "core/soak_test.hpp"
+#include "core/spatial_grid.hpp"
+#include "core/stress_test.hpp"
+#include "core/tower_grid.hpp"
 #include "event_bus.hpp"
 #include "managers/asset_manager.hpp"
 #include "managers/map_manager.hpp"
@@ -15,7 +27,8 @@
 #include <entt/entt.hpp>
 #include <optional>
 #include <string>
-#include <unordered_set>
+#include <utility>
+#include <vector>
 
 namespace ls {
 
@@ -37,6 +50,13 @@ struct GameStats {
     int hero_deaths{};
 };
 
+// Static tiles and decorations baked once per match; `reduced` is a half-resolution copy for zoomed-out views
+struct TileLayer {
+    RenderTexture2D full{};
+    RenderTexture2D reduced{};
+    bool baked{false};
+};
+
 struct Tutorial {
     bool active{true};
     int step{0};
@@ -58,10 +78,15 @@ struct PlayState {
     entt::entity hero{entt::null};
     entt::entity selected_tower{entt::null};
     std::optional<TowerType> placing_tower;
-    std::unordered_set<GridPos, GridPosHash> tower_positions;
-    std::vector<Vec2> enemy_path;
-    std::vector<Vec2> flying_path;
+    TowerGrid towers;
+    size_t retarget_cursor{};   // first tower of the next targeting slice; not saved
+    ImpactQueue shots;          // projectiles in flight
+    std::vector<Bolt> bolts;    // Ballista bolts in flight
+    std::vector<ChainArc> arcs; // lightning chains fading out
+    SharedPath enemy_path;
+    SharedPath flying_path;
     bool game_speed_fast{false};
+    bool autosave_pending{false};
 
     // Screen shake
     float shake_intensity{0};
@@ -73,6 +98,7 @@ struct PlayState {
 
     // Stats
     GameStats stats;
+    MatchPerf perf; // frame times and entity peaks per wave; not saved
 
     // Tutorial
     Tutorial tutorial;
@@ -82,6 +108,9 @@ struct PlayState {
 };
 
 struct Game {
+    // Create/destroy counters (F3 overlay, headless report). Declared before the registry so it
+    // outlives the signals the registry holds into it.
+    ChurnCounters churn;
     entt::registry registry;
     EventDispatcher dispatcher;
     StateMachine state_machine;
@@ -97,10 +126,52 @@ struct Game {
     Difficulty difficulty{Difficulty::Normal};
     bool running{true};
     std::string save_path{"save.json"};
-    std::optional<SaveData> pending_load;
+    std::optional<SaveData> pending_load; // legacy JSON save
+    std::string snapshot_path{"save.bin"};
+    std::optional<std::vector<uint8_t>> pending_snapshot;
+
+    // Player input for the current tick, and commands queued by UI for the next one
+    InputFrame input;
+    std::vector<InputCommand> pending_commands;
+
+    // Reused by systems that collect entities while iterating and act on them afterwards, so a
+    // steady-state tick doesn't allocate. Only valid within a single system call.
+    std::vector<entt::entity> scratch_entities;
+
+    // Broadphase for enemy body collisions, rebuilt every tick
+    SpatialGrid body_grid;
+
+    // Broadphase over every live enemy for bolt sweeps, rebuilt on ticks with bolts in flight, and the
+    // enemies one bolt's step crosses, by distance along it
+    SpatialGrid enemy_grid;
+    std::vector<std::pair<float, entt::entity>> bolt_hits;
+
+    // Live enemies by distance along their route, refreshed by tower targeting every tick
+    EnemyIndex enemy_index;
+    int retarget_budget{RETARGET_BUDGET}; // towers that look for a better target each tick
+
+    // Random streams, seeded per match
+    RandomStreams rng;
+
+    // Replay (enabled from the command line)
+    uint32_t seed{};
+    std::optional<ReplayRecorder> recorder;
+    std::optional<ReplayPlayer> replay;
+
+    // Stress mode (menu or --stress): unbounded spawns until the frame rate collapses
+    std::optional<StressTest> stress;
+
+    // Soak mode (--soak): back-to-back bot matches checking that memory stays flat
+    std::optional<SoakTest> soak;
 
     // Camera
     Camera2D camera{};
+    TileLayer tile_layer;
+
+    // The render and UI systems draw through `renderer`; point it at a RecordingRenderer to capture
+    // or count a frame without drawing it
+    RaylibRenderer raylib_renderer;
+    Renderer* renderer{&raylib_renderer};
 
     // Music state
     Music* current_music{nullptr};
@@ -108,20 +179,23 @@ struct Game {
     bool music_muted{false};
 
     void recalculate_path() {
-        // Use map waypoints as the canonical enemy path
-        play.enemy_path.clear();
+        TRACE_SCOPE("recalculate_path", "path");
+        // Use map waypoints as the canonical enemy path. Enemies already walking keep the route they spawned with.
+        std::vector<Vec2> path;
         for (auto& wp : current_map.path_waypoints) {
-            play.enemy_path.push_back(current_map.grid_to_world(wp));
+            path.push_back(current_map.grid_to_world(wp));
         }
+        play.enemy_path = make_path(std::move(path));
         // Flying path: straight line from spawn to exit
-        play.flying_path.clear();
-        play.flying_path.push_back(current_map.grid_to_world(current_map.spawn));
-        play.flying_path.push_back(current_map.grid_to_world(current_map.exit_pos));
+        play.flying_path = make_path({current_map.grid_to_world(current_map.spawn),
+                                      current_map.grid_to_world(current_map.exit_pos)});
+        enemy_index.add_route(play.enemy_path);
+        enemy_index.add_route(play.flying_path);
     }
 
     bool can_place_tower(GridPos pos) const {
         if (!current_map.is_buildable(pos)) return false;
-        if (play.tower_positions.contains(pos)) return false;
+        if (play.towers.occupied(pos)) return false;
         return true;
     }
 
@@ -131,6 +205,67 @@ struct Game {
     }
 
     GridPos mouse_grid() const { return current_map.world_to_grid(mouse_world()); }
+
+    // Called by the main loop with each frame's CPU time (update and draw calls, not the frame-limiter
+    // wait). Charged to the current wave while a normal match is on screen.
+    void record_frame_time(float cpu_ms) {
+        if (stress || state_machine.current_id() != GameStateId::Playing) return;
+        play.perf.record(play.current_wave, cpu_ms, count_entities(registry, play.shots.size() + play.bolts.size()));
+    }
+
+    // Hands the recording's finished chunks to the background writer: a new recording's header
+    // starts the file over and each chunk after it is appended, so a crash loses at most one chunk
+    void write_recording() {
+        if (!recorder || !recorder->has_pending()) return;
+        bool starts_file = recorder->starts_file();
+        auto bytes = recorder->take();
+        if (starts_file) {
+            save_manager.save_async(recorder->path(), std::move(bytes));
+        } else {
+            save_manager.append_async(recorder->path(), std::move(bytes));
+        }
+    }
+
+    // Write the rest of the current recording in the background and stop recording
+    void finish_recording() {
+        if (!recorder || !recorder->active()) return;
+        recorder->end();
+        write_recording();
+    }
+
+    // Enters Playing on the next map in the soak rotation
+    std::expected<void, std::string> start_soak_match() {
+        auto& maps = map_manager.available_maps();
+        auto map = map_manager.load_by_name(maps[static_cast<size_t>(soak->played()) % maps.size()]);
+        if (!map) return std::unexpected(map.error());
+        current_map = std::move(*map);
+        difficulty = Difficulty::Normal;
+        state_machine.change_state(GameStateId::Playing, *this);
+        return {};
+    }
+
+    // Samples the process once a soak match has ended
+    void record_soak_match() {
+        soak->record({.map = current_map.name,
+                      .wave = play.current_wave,
+                      .won = state_machine.current_id() == GameStateId::Victory,
+                      .gold_collected = play.stats.gold_earned,
+                      .rss_kb = current_rss_kb(),
+                      .entities = live_entities(registry),
+                      .pool_capacity = pool_capacity(registry),
+                      .assets = assets.loaded_count()});
+    }
+
+    // Enters Playing in stress mode on the first map
+    std::expected<void, std::string> start_stress_test() {
+        auto map = map_manager.load_by_name(map_manager.available_maps().front());
+        if (!map) return std::unexpected(map.error());
+        current_map = std::move(*map);
+        difficulty = Difficulty::Normal;
+        stress.emplace();
+        state_machine.change_state(GameStateId::Playing, *this);
+        return {};
+    }
 };
 
 inline void load_assets(Game& game) {
@@ -200,6 +335,7 @@ inline void load_assets(Game& game) {
     load_tex(TOWER_LIGHTNING, td("towerDefense_tile206.png"));
     load_tex(TOWER_POISON, td("towerDefense_tile291.png"));
     load_tex(TOWER_LASER, td("towerDefense_tile250.png"));
+    load_tex(TOWER_BALLISTA, td("towerDefense_tile205.png"));
 
     // Enemies - using vehicle/unit sprites from TD pack
     load_tex(ENEMY_GRUNT, td("towerDefense_tile245.png"));  // green armored vehicle
@@ -221,6 +357,7 @@ inline void load_assets(Game& game) {
     load_tex(PROJ_ICE, pt("circle_02.png"));
     load_tex(PROJ_LIGHTNING, pt("spark_05.png"));
     load_tex(PROJ_POISON, pt("circle_01.png"));
+    load_tex(PROJ_BOLT, td("towerDefense_tile251.png"));
 
     // Particles
     load_tex(PART_FLAME, pt("flame_01.png"));
@@ -0,0 +1,134 @@
+#pragma once
+#include "core/game.hpp"
+#include "core/profiler.hpp"
+#include "core/snapshot.hpp"
+#include <expected>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace ls {
+
+template <typename Archive, typename T>
+    requires std::same_as<std::remove_const_t<T>, ImpactQueue>
+void serialize(Archive& ar, T& q) {
+    ar(q.clock);
+    ar(q.shots);
+}
+
+// Match progress, shots and bolts in flight and fading chain arcs; UI selection, paths and the tower grid
+// are rebuilt on load
+template <typename Archive, typename T>
+    requires std::same_as<std::remove_const_t<T>, PlayState>
+void serialize(Archive& ar, T& ps) {
+    ar(ps.gold);
+    ar(ps.lives);
+    ar(ps.current_wave);
+    ar(ps.wave_active);
+    ar(ps.wave_timer);
+    ar(ps.spawn_timer);
+    ar(ps.spawn_index);
+    ar(ps.spawn_sub_index);
+    ar(ps.enemies_alive);
+    ar(ps.total_kills);
+    ar(ps.hero);
+    ar(ps.game_speed_fast);
+    ar(ps.shake_intensity);
+    ar(ps.shake_timer);
+    ar(ps.banner.text);
+    ar(ps.banner.timer);
+    ar(ps.banner.color);
+    ar(ps.banner.active);
+    ar(ps.stats);
+    ar(ps.tutorial);
+    ar(ps.shots);
+    ar(ps.bolts);
+    ar(ps.arcs);
+}
+
+// Payload: map name | difficulty | PlayState | gameplay and VFX stream state | registry
+inline std::vector<uint8_t> make_game_payload(const Game& game) {
+    TRACE_SCOPE("make_game_payload", "save");
+    SnapshotWriter out;
+    out(game.current_map.name);
+    out(game.difficulty);
+    out(game.play);
+    out(game.rng.gameplay);
+    out(game.rng.vfx);
+    save_registry(game.registry, out);
+    return out.bytes();
+}
+
+inline std::vector<uint8_t> seal_game_payload(std::vector<uint8_t> payload) {
+    TRACE_SCOPE("seal_game_payload", "save");
+    return seal_snapshot(payload);
+}
+
+inline std::vector<uint8_t> make_game_snapshot(const Game& game) { return seal_game_payload(make_game_payload(game)); }
+
+// Read the map name so the caller can load the map before restoring
+inline std::expected<std::string, std::string> snapshot_map_name(std::span<const uint8_t> data) {
+    auto payload = open_snapshot(data);
+    if (!payload) return std::unexpected(payload.error());
+    SnapshotReader in(*payload);
+    std::string name;
+    in(name);
+    if (in.failed()) return std::unexpected("Snapshot payload is malformed");
+    return name;
+}
+
+// Expects game.current_map loaded and paths calculated. On failure the registry is left empty.
+inline std::expected<void, std::string> restore_game_snapshot(Game& game, std::span<const uint8_t> data) {
+    TRACE_SCOPE("restore_game_snapshot", "save");
+    auto payload = open_snapshot(data);
+    if (!payload) return std::unexpected(payload.error());
+
+    SnapshotReader in(*payload);
+    std::string map_name;
+    Difficulty difficulty{};
+    PlayState ps{};
+    Pcg32 gameplay_rng, vfx_rng;
+    in(map_name);
+    in(difficulty);
+    in(ps);
+    in(gameplay_rng);
+    in(vfx_rng);
+    if (map_name != game.current_map.name) return std::unexpected("Snapshot is for map '" + map_name + "'");
+
+    game.registry.clear();
+    game.enemy_index.clear();
+    game.enemy_index.add_route(game.play.enemy_path);
+    game.enemy_index.add_route(game.play.flying_path);
+    load_registry(game.registry, in);
+    if (in.failed() || in.remaining() != 0 || !game.registry.valid(ps.hero)) {
+        game.registry.clear();
+        return std::unexpected("Snapshot payload is malformed");
+    }
+
+    ps.enemy_path = std::move(game.play.enemy_path);
+    ps.flying_path = std::move(game.play.flying_path);
+    game.play = std::move(ps);
+    game.difficulty = difficulty;
+    game.rng.gameplay = gameplay_rng;
+    game.rng.vfx = vfx_rng;
+    // Enemies load with private copies of their routes; point the ones that match back at the shared paths
+    for (auto [e, pf] : game.registry.view<PathFollower>().each()) {
+        for (auto* route : {&game.play.enemy_path, &game.play.flying_path}) {
+            if (*route && pf.path && **route == *pf.path) pf.path = *route;
+        }
+    }
+    for (auto [e, tower, gc] : game.registry.view<Tower, GridCell>().each()) {
+        game.play.towers.place(gc.pos, e);
+    }
+    return {};
+}
+
+// The payload is captured on the calling thread, since the registry keeps changing once the tick moves
+// on. That capture is the cheap part: trivially copyable components go in as raw copies, about what
+// any copy of the state would cost. The checksum over the whole payload,
+// the header and the file write run on the save writer thread.
+inline void save_game(Game& game) {
+    game.save_manager.save_async(game.snapshot_path, make_game_payload(game), seal_game_payload);
+}
+
+} // namespace ls
@@ -0,0 +1,61 @@
+#pragma once
+#include "components/components.hpp"
+#include <algorithm>
+#include <vector>
+
+namespace ls {
+
+// Projectiles in flight as a min-heap on impact time. A shot's flight time is known when it is fired,
+// so nothing about it is simulated in between: advance() moves the clock and pop_due() hands back the
+// shots that have landed, earliest first. A tick costs its impacts, not the shots in the air.
+struct ImpactQueue {
+    float clock{};                 // seconds of simulation since the match started
+    std::vector<Projectile> shots; // heap order; see in_flight()
+
+    size_t size() const { return shots.size(); }
+    bool empty() const { return shots.empty(); }
+    void reserve(size_t n) { shots.reserve(n); }
+
+    void clear() {
+        shots.clear();
+        clock = 0.0f;
+    }
+
+    // Every shot in the air, in no particular order
+    const std::vector<Projectile>& in_flight() const { return shots; }
+
+    // Launches `p` from p.origin toward p.target_pos at `time` (now by default), filling in its timings
+    void fire(Projectile p) { fire(p, clock); }
+    void fire(Projectile p, float time) {
+        p.fire_time = time;
+        p.impact_time = time + (p.speed > 0.0f ? p.origin.distance_to(p.target_pos) / p.speed : 0.0f);
+        shots.push_back(p);
+        std::push_heap(shots.begin(), shots.end(), later);
+    }
+
+    void advance(float dt) { clock += dt; }
+
+    // Removes each shot that has landed by now and calls fn(shot), earliest impact first. Shots fn
+    // fires that land by now are popped in the same call.
+    template <typename Fn>
+    void pop_due(Fn&& fn) {
+        while (!shots.empty() && shots.front().impact_time <= clock) {
+            std::pop_heap(shots.begin(), shots.end(), later);
+            Projectile p = shots.back();
+            shots.pop_back();
+            fn(p);
+        }
+    }
+
+    // Where a shot is at the current clock
+    Vec2 position(const Projectile& p) const {
+        float span = p.impact_time - p.fire_time;
+        float t = span > 0.0f ? std::clamp((clock - p.fire_time) / span, 0.0f, 1.0f) : 1.0f;
+        return p.origin + (p.target_pos - p.origin) * t;
+    }
+
+  private:
+    static bool later(const Projectile& a, const Projectile& b) { return a.impact_time > b.impact_time; }
+};
+
+} // namespace ls
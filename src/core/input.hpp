@@ -0,0 +1,47 @@
+#pragma once
+#include "types.hpp"
+#include <cstdint>
+#include <vector>
+
+namespace ls {
+
+// Player actions that change the simulation. UI code queues these instead of mutating state,
+// so a recorded stream of them reproduces a match exactly.
+enum class CommandType : uint8_t {
+    PlaceTower,
+    UpgradeTower,
+    SellTower,
+    RepairTower,
+    StartWave,
+    ToggleSpeed,
+    SetTargetMode
+};
+
+struct InputCommand {
+    CommandType type{};
+    TowerType tower{};        // PlaceTower only
+    GridPos cell{};           // tower commands
+    TargetMode target_mode{}; // SetTargetMode only
+};
+
+namespace input_bits {
+inline constexpr uint8_t MOVE_UP = 1 << 0;
+inline constexpr uint8_t MOVE_DOWN = 1 << 1;
+inline constexpr uint8_t MOVE_LEFT = 1 << 2;
+inline constexpr uint8_t MOVE_RIGHT = 1 << 3;
+inline constexpr uint8_t FIREBALL = 1 << 4;
+inline constexpr uint8_t HEAL_AURA = 1 << 5;
+inline constexpr uint8_t LIGHTNING = 1 << 6;
+inline constexpr uint8_t HAS_COMMANDS = 1 << 7; // set only in replay files
+} // namespace input_bits
+
+// Everything the simulation reads from the player in one tick
+struct InputFrame {
+    uint8_t buttons{};
+    Vec2 ability_target{}; // world position for targeted abilities
+    std::vector<InputCommand> commands;
+
+    bool held(uint8_t bit) const { return (buttons & bit) != 0; }
+};
+
+} // namespace ls
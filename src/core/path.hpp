@@ -0,0 +1,67 @@
+#pragma once
+#include "types.hpp"
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+namespace ls {
+
+// An enemy route: waypoints plus the distance along the route to each one. Positions on the route
+// are a direct function of distance travelled, so movement is exact for any step size and where an
+// enemy will be at a later time is one lookup.
+class Path {
+  public:
+    Path() = default;
+    explicit Path(std::vector<Vec2> points) : points_(std::move(points)) {
+        arc_.resize(points_.size());
+        for (size_t i = 1; i < points_.size(); ++i) arc_[i] = arc_[i - 1] + points_[i - 1].distance_to(points_[i]);
+    }
+
+    const std::vector<Vec2>& points() const { return points_; }
+    size_t size() const { return points_.size(); }
+    bool empty() const { return points_.empty(); }
+    const Vec2& operator[](size_t i) const { return points_[i]; }
+    const Vec2& front() const { return points_.front(); }
+    const Vec2& back() const { return points_.back(); }
+    auto begin() const { return points_.begin(); }
+    auto end() const { return points_.end(); }
+
+    float arc(size_t i) const { return arc_[i]; }
+    float length() const { return arc_.empty() ? 0.0f : arc_.back(); }
+
+    // The waypoint an enemy `s` along the route is heading for; size() once it has arrived
+    size_t next_index(float s) const {
+        if (s >= length()) return points_.size();
+        return static_cast<size_t>(std::upper_bound(arc_.begin(), arc_.end(), s) - arc_.begin());
+    }
+
+    // Position `s` along the route, clamped to its ends
+    Vec2 at(float s) const {
+        if (points_.empty()) return {};
+        size_t i = next_index(s);
+        if (i == 0) return points_.front();
+        if (i >= points_.size()) return points_.back();
+        float len = arc_[i] - arc_[i - 1];
+        return points_[i - 1] + (points_[i] - points_[i - 1]) * ((s - arc_[i - 1]) / len);
+    }
+
+    // Unit direction of travel at `s`; zero past the end
+    Vec2 direction(float s) const {
+        size_t i = next_index(s);
+        if (i == 0 || i >= points_.size()) return {};
+        return (points_[i] - points_[i - 1]).normalized();
+    }
+
+    bool operator==(const Path& o) const { return points_ == o.points_; }
+
+  private:
+    std::vector<Vec2> points_;
+    std::vector<float> arc_;
+};
+
+// Waypoints are immutable once built, so every enemy on a route shares one copy and spawning doesn't allocate
+using SharedPath = std::shared_ptr<const Path>;
+
+inline SharedPath make_path(std::vector<Vec2> points) { return std::make_shared<const Path>(std::move(points)); }
+
+} // namespace ls
@@ -0,0 +1,155 @@
+#pragma once
+#include "components/components.hpp"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <entt/entt.hpp>
+#include <format>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace ls {
+
+struct EntityCounts {
+    int enemies{};
+    int towers{};
+    int projectiles{};
+    int particles{};
+    int total{}; // everything with a Transform
+};
+
+// Projectiles and bolts live outside the registry (PlayState::shots and bolts), so the caller passes
+// how many are in flight
+inline EntityCounts count_entities(const entt::registry& reg, size_t projectiles) {
+    return {static_cast<int>(reg.view<Enemy>().size()), static_cast<int>(reg.view<Tower>().size()),
+            static_cast<int>(projectiles), static_cast<int>(reg.view<Particle>().size()),
+            static_cast<int>(reg.view<Transform>().size())};
+}
+
+inline EntityCounts max_counts(const EntityCounts& a, const EntityCounts& b) {
+    return {std::max(a.enemies, b.enemies), std::max(a.towers, b.towers), std::max(a.projectiles, b.projectiles),
+            std::max(a.particles, b.particles), std::max(a.total, b.total)};
+}
+
+// Log-linear histogram of frame times in microseconds: exact below 8 us, then eight buckets per
+// power of two (within 12.5%) up to about 4 s. 640 bytes regardless of how many frames it holds.
+class FrameHistogram {
+  public:
+    static constexpr int SUB_BUCKETS = 8;
+    static constexpr int BUCKETS = 160;
+
+    void record(float ms) {
+        auto us = static_cast<uint32_t>(std::clamp(ms * 1000.0f, 0.0f, 4.0e9f));
+        ++counts_[static_cast<size_t>(bucket_of(us))];
+        ++frames_;
+        max_ms_ = std::max(max_ms_, ms);
+    }
+
+    uint32_t frames() const { return frames_; }
+    float max_ms() const { return max_ms_; }
+
+    // Nearest-rank percentile (p in 0..1), reported as the middle of its bucket
+    float percentile(float p) const {
+        if (frames_ == 0) return 0.0f;
+        auto rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(p * static_cast<float>(frames_))));
+        uint64_t seen = 0;
+        for (int b = 0; b < BUCKETS; ++b) {
+            seen += counts_[static_cast<size_t>(b)];
+            if (seen >= rank) {
+                float mid_us = static_cast<float>(bucket_floor(b)) + static_cast<float>(bucket_width(b)) / 2.0f;
+                return std::min(mid_us / 1000.0f, max_ms_);
+            }
+        }
+        return max_ms_;
+    }
+
+    void merge(const FrameHistogram& o) {
+        for (size_t b = 0; b < counts_.size(); ++b) counts_[b] += o.counts_[b];
+        frames_ += o.frames_;
+        max_ms_ = std::max(max_ms_, o.max_ms_);
+    }
+
+    static int bucket_of(uint32_t us) {
+        if (us < SUB_BUCKETS) return static_cast<int>(us);
+        int e = std::bit_width(us) - 1; // at least 3 here
+        int b = (e - 2) * SUB_BUCKETS + static_cast<int>((us >> (e - 3)) & (SUB_BUCKETS - 1));
+        return std::min(b, BUCKETS - 1);
+    }
+    static uint32_t bucket_floor(int b) {
+        if (b < SUB_BUCKETS) return static_cast<uint32_t>(b);
+        int e = b / SUB_BUCKETS + 2;
+        return static_cast<uint32_t>(SUB_BUCKETS + b % SUB_BUCKETS) << (e - 3);
+    }
+    static uint32_t bucket_width(int b) { return b < SUB_BUCKETS ? 1u : 1u << (b / SUB_BUCKETS - 1); }
+
+  private:
+    std::array<uint32_t, BUCKETS> counts_{};
+    uint32_t frames_{0};
+    float max_ms_{0.0f};
+};
+
+struct WavePerf {
+    WaveNum wave{};
+    FrameHistogram frames;
+    EntityCounts peak; // high-water marks while this wave was current
+};
+
+// Per-wave frame CPU times and entity peaks for one match. Not part of save snapshots: a resumed
+// match reports only the waves played since loading.
+class MatchPerf {
+  public:
+    void record(WaveNum wave, float cpu_ms, const EntityCounts& counts) {
+        if (waves_.empty() || waves_.back().wave != wave) {
+            waves_.emplace_back();
+            waves_.back().wave = wave;
+        }
+        auto& w = waves_.back();
+        w.frames.record(cpu_ms);
+        w.peak = max_counts(w.peak, counts);
+    }
+
+    const std::vector<WavePerf>& waves() const { return waves_; }
+    bool empty() const { return waves_.empty(); }
+
+    FrameHistogram overall() const {
+        FrameHistogram h;
+        for (auto& w : waves_) h.merge(w.frames);
+        return h;
+    }
+
+    EntityCounts peak() const {
+        EntityCounts c;
+        for (auto& w : waves_) c = max_counts(c, w.peak);
+        return c;
+    }
+
+    // Waves sorted by p99, worst first
+    std::vector<const WavePerf*> worst_waves(size_t n) const {
+        std::vector<const WavePerf*> out;
+        for (auto& w : waves_) out.push_back(&w);
+        std::stable_sort(out.begin(), out.end(),
+                         [](auto* a, auto* b) { return a->frames.percentile(0.99f) > b->frames.percentile(0.99f); });
+        if (out.size() > n) out.resize(n);
+        return out;
+    }
+
+    std::string to_csv(std::string_view map, std::string_view difficulty) const {
+        std::string out = "map,difficulty,wave,frames,p50_ms,p95_ms,p99_ms,max_ms,"
+                          "peak_enemies,peak_towers,peak_projectiles,peak_particles,peak_entities\n";
+        for (auto& w : waves_) {
+            auto& f = w.frames;
+            out += std::format("{},{},{},{},{:.3f},{:.3f},{:.3f},{:.3f},{},{},{},{},{}\n", map, difficulty, w.wave,
+                               f.frames(), f.percentile(0.50f), f.percentile(0.95f), f.percentile(0.99f), f.max_ms(),
+                               w.peak.enemies, w.peak.towers, w.peak.projectiles, w.peak.particles, w.peak.total);
+        }
+        return out;
+    }
+
+  private:
+    std::vector<WavePerf> waves_;
+};
+
+} // namespace ls
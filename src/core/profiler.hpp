@@ -0,0 +1,233 @@
+#pragma once
+#include "core/alloc_tracker.hpp"
+#include "core/tracer.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+// Scoped timers and trace spans are on in debug builds and compiled out of release builds
+// unless the build defines LASTSTAND_PROFILE=1 (cmake -DLASTSTAND_PROFILE=ON).
+#ifndef LASTSTAND_PROFILE
+#ifdef NDEBUG
+#define LASTSTAND_PROFILE 0
+#else
+#define LASTSTAND_PROFILE 1
+#endif
+#endif
+
+namespace ls {
+
+class Profiler {
+  public:
+    using Clock = std::chrono::steady_clock;
+    static constexpr int MAX_SLOTS = 48;
+    static constexpr size_t HISTORY = 240; // frames kept for the overlay and stats
+
+    static uint64_t to_ns(Clock::duration d) {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(d).count());
+    }
+
+    struct Frame {
+        uint64_t total_ns{}; // wall time since the previous frame ended
+        std::array<uint32_t, MAX_SLOTS> slot_ns{};
+        // Main-thread allocations; stay zero unless built with LASTSTAND_ALLOC_TRACKING
+        uint64_t allocs{};
+        uint64_t alloc_bytes{};
+        std::array<uint32_t, MAX_SLOTS> slot_allocs{};
+        std::array<uint32_t, MAX_SLOTS> slot_alloc_bytes{};
+    };
+
+    struct Stats {
+        double min_ms{};
+        double avg_ms{};
+        double max_ms{};
+        double p99_ms{};
+    };
+
+    struct AllocStats {
+        double avg_count{}; // per frame
+        double avg_bytes{};
+        uint64_t max_count{};
+    };
+
+    // Registers a scope name once per call site; returns -1 when every slot is taken. Call sites
+    // first reached on different threads may register at the same time.
+    int slot(const char* name) {
+        std::lock_guard lock(slot_mtx_);
+        int n = slot_count_.load(std::memory_order_relaxed);
+        for (int i = 0; i < n; ++i) {
+            if (std::strcmp(names_[i], name) == 0) return i;
+        }
+        if (n == MAX_SLOTS) return -1;
+        names_[n] = name;
+        slot_count_.store(n + 1, std::memory_order_release);
+        return n;
+    }
+
+    void add(int slot, uint64_t ns) {
+        if (slot >= 0) current_.slot_ns[slot] += static_cast<uint32_t>(ns);
+    }
+
+    void add_allocs(int slot, uint64_t count, uint64_t bytes) {
+        if (slot < 0) return;
+        current_.slot_allocs[slot] += static_cast<uint32_t>(count);
+        current_.slot_alloc_bytes[slot] += static_cast<uint32_t>(bytes);
+    }
+
+    // Commits the frame being accumulated into the ring. Single producer: the main loop calls
+    // this once per frame; readers only ever see fully written frames behind head_.
+    void end_frame() {
+        auto now = Clock::now();
+        if (started_) {
+            current_.total_ns = to_ns(now - frame_start_);
+            current_.allocs = alloc_counters.count - frame_allocs_.count;
+            current_.alloc_bytes = alloc_counters.bytes - frame_allocs_.bytes;
+        }
+        started_ = true;
+        frame_start_ = now;
+        frame_allocs_ = alloc_counters;
+
+        uint64_t head = head_.load(std::memory_order_relaxed);
+        ring_[head % HISTORY] = current_;
+        head_.store(head + 1, std::memory_order_release);
+        current_ = Frame{};
+    }
+
+    size_t frame_count() const { return std::min<size_t>(head_.load(std::memory_order_acquire), HISTORY); }
+
+    // age 0 is the most recently committed frame
+    const Frame& frame(size_t age) const {
+        uint64_t head = head_.load(std::memory_order_acquire);
+        return ring_[(head - 1 - age) % HISTORY];
+    }
+
+    int slot_count() const { return slot_count_.load(std::memory_order_acquire); }
+    const char* slot_name(int slot) const { return names_[slot]; }
+
+    Stats slot_stats(int slot) const {
+        return stats_of([&](const Frame& f) { return f.slot_ns[slot]; });
+    }
+    Stats frame_stats() const {
+        return stats_of([](const Frame& f) { return f.total_ns; });
+    }
+
+    AllocStats slot_alloc_stats(int slot) const {
+        return alloc_stats_of([&](const Frame& f) {
+            return std::pair<uint64_t, uint64_t>(f.slot_allocs[slot], f.slot_alloc_bytes[slot]);
+        });
+    }
+    AllocStats frame_alloc_stats() const {
+        return alloc_stats_of([](const Frame& f) { return std::pair(f.allocs, f.alloc_bytes); });
+    }
+
+    bool overlay_visible() const { return overlay_; }
+    void toggle_overlay() { overlay_ = !overlay_; }
+
+  private:
+    std::array<const char*, MAX_SLOTS> names_{};
+    std::atomic<int> slot_count_{0};
+    std::mutex slot_mtx_;
+    std::array<Frame, HISTORY> ring_{};
+    std::atomic<uint64_t> head_{0};
+    Frame current_{};
+    Clock::time_point frame_start_{};
+    AllocCounters frame_allocs_{};
+    bool started_{false};
+    bool overlay_{false};
+
+    template <typename Get>
+    Stats stats_of(Get get) const {
+        size_t n = frame_count();
+        if (n == 0) return {};
+        std::vector<double> ms(n);
+        double sum = 0.0;
+        for (size_t i = 0; i < n; ++i) {
+            ms[i] = static_cast<double>(get(frame(i))) / 1e6;
+            sum += ms[i];
+        }
+        Stats s;
+        s.avg_ms = sum / static_cast<double>(n);
+        auto [lo, hi] = std::minmax_element(ms.begin(), ms.end());
+        s.min_ms = *lo;
+        s.max_ms = *hi;
+        auto p99 = ms.begin() + static_cast<std::ptrdiff_t>((n - 1) * 99 / 100);
+        std::nth_element(ms.begin(), p99, ms.end());
+        s.p99_ms = *p99;
+        return s;
+    }
+
+    template <typename Get>
+    AllocStats alloc_stats_of(Get get) const {
+        size_t n = frame_count();
+        if (n == 0) return {};
+        AllocStats s;
+        for (size_t i = 0; i < n; ++i) {
+            auto [count, bytes] = get(frame(i));
+            s.avg_count += static_cast<double>(count);
+            s.avg_bytes += static_cast<double>(bytes);
+            s.max_count = std::max<uint64_t>(s.max_count, count);
+        }
+        s.avg_count /= static_cast<double>(n);
+        s.avg_bytes /= static_cast<double>(n);
+        return s;
+    }
+};
+
+inline Profiler& profiler() {
+    static Profiler instance;
+    return instance;
+}
+
+// The profiler accumulates a single frame for the main loop without synchronisation. Threads that
+// run a simulation of their own (the balance runner's workers) turn this off before they start.
+inline thread_local bool profile_this_thread = true;
+
+class ProfileScope {
+  public:
+    explicit ProfileScope(int slot) : slot_(profile_this_thread ? slot : -1), start_(Profiler::Clock::now()) {
+        if constexpr (ALLOC_TRACKING) allocs_ = alloc_counters;
+    }
+    ~ProfileScope() {
+        auto end = Profiler::Clock::now();
+        profiler().add(slot_, Profiler::to_ns(end - start_));
+        // Read before the trace span is recorded so its storage isn't charged to this scope
+        if constexpr (ALLOC_TRACKING) {
+            profiler().add_allocs(slot_, alloc_counters.count - allocs_.count, alloc_counters.bytes - allocs_.bytes);
+        }
+        if (slot_ >= 0 && tracer().active()) tracer().record(profiler().slot_name(slot_), "system", start_, end);
+    }
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+  private:
+    int slot_;
+    Profiler::Clock::time_point start_;
+    AllocCounters allocs_{};
+};
+
+} // namespace ls
+
+#if LASTSTAND_PROFILE
+#define LS_PROFILE_CONCAT_(a, b) a##b
+#define LS_PROFILE_CONCAT(a, b) LS_PROFILE_CONCAT_(a, b)
+#define PROFILE_SCOPE(name)                                                                                            \
+    static const int LS_PROFILE_CONCAT(ls_prof_slot_, __LINE__) = ::ls::profiler().slot(name);                        \
+    ::ls::ProfileScope LS_PROFILE_CONCAT(ls_prof_scope_, __LINE__)(LS_PROFILE_CONCAT(ls_prof_slot_, __LINE__))
+#define TRACE_SCOPE(name, category) ::ls::TraceScope LS_PROFILE_CONCAT(ls_trace_, __LINE__)(name, category)
+#define TRACE_SCOPE_DETAIL(name, category, detail)                                                                     \
+    ::ls::TraceScope LS_PROFILE_CONCAT(ls_trace_, __LINE__)(name, category, [&] { return std::string(detail); })
+#define TRACE_THREAD_NAME(name) ::ls::tracer().name_thread(name)
+#else
+#define PROFILE_SCOPE(name) static_cast<void>(0)
+#define TRACE_SCOPE(name, category) static_cast<void>(0)
+#define TRACE_SCOPE_DETAIL(name, category, detail) static_cast<void>(0)
+#define TRACE_THREAD_NAME(name) static_cast<void>(0)
+#endif
+
+#define PROFILE_FUNCTION() PROFILE_SCOPE(__func__)
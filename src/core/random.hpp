@@ -0,0 +1,84 @@
+#pragma once
+#include <cstdint>
+#include <utility>
+
+namespace ls {
+
+// PCG32 (XSH-RR): 64-bit state, 32-bit output. Each (seed, stream) pair is an independent
+// sequence, so subsystems never shift each other's draws.
+class Pcg32 {
+  public:
+    Pcg32() { seed(0x853c49e6748fea9bULL, 0xda3e39cb94b95bdbULL); }
+    Pcg32(uint64_t seed_value, uint64_t stream) { seed(seed_value, stream); }
+
+    void seed(uint64_t seed_value, uint64_t stream) {
+        state_ = 0;
+        inc_ = (stream << 1u) | 1u;
+        next();
+        state_ += seed_value;
+        next();
+    }
+
+    uint32_t next() {
+        uint64_t old = state_;
+        state_ = old * 6364136223846793005ULL + inc_;
+        auto xorshifted = static_cast<uint32_t>(((old >> 18u) ^ old) >> 27u);
+        auto rot = static_cast<uint32_t>(old >> 59u);
+        return (xorshifted >> rot) | (xorshifted << ((32u - rot) & 31u));
+    }
+
+    // Uniform integer in [lo, hi], inclusive like GetRandomValue
+    int range(int lo, int hi) {
+        if (hi < lo) std::swap(lo, hi);
+        auto span = static_cast<uint32_t>(static_cast<int64_t>(hi) - lo + 1);
+        if (span == 0) return static_cast<int>(next()); // full 32-bit range
+        // Lemire's multiply-shift with rejection for an unbiased result
+        uint64_t m = static_cast<uint64_t>(next()) * span;
+        auto low = static_cast<uint32_t>(m);
+        if (low < span) {
+            uint32_t threshold = (0u - span) % span;
+            while (low < threshold) {
+                m = static_cast<uint64_t>(next()) * span;
+                low = static_cast<uint32_t>(m);
+            }
+        }
+        return static_cast<int>(static_cast<int64_t>(lo) + static_cast<int64_t>(m >> 32));
+    }
+
+    // Uniform float in [0, 1)
+    float uniform() { return static_cast<float>(next() >> 8) * (1.0f / 16777216.0f); }
+
+    float range(float lo, float hi) { return lo + (hi - lo) * uniform(); }
+
+    // Derive an independent generator, e.g. one per worker thread or per parallel system
+    Pcg32 split(uint64_t stream) {
+        uint64_t hi = next();
+        uint64_t lo = next();
+        return {(hi << 32u) | lo, stream};
+    }
+
+  private:
+    uint64_t state_{};
+    uint64_t inc_{};
+};
+
+namespace rng_stream {
+inline constexpr uint64_t GAMEPLAY = 1;
+inline constexpr uint64_t VFX = 2;
+inline constexpr uint64_t DECORATION = 3;
+inline constexpr uint64_t AUDIO = 4;
+} // namespace rng_stream
+
+// Per-match random streams owned by Game
+struct RandomStreams {
+    Pcg32 gameplay;   // anything that can change a match's outcome
+    Pcg32 vfx;        // particles, shake, sparks; never read by gameplay code
+    Pcg32 decoration; // map decoration layout, seeded from the map so it looks the same every time
+
+    void seed(uint64_t match_seed) {
+        gameplay.seed(match_seed, rng_stream::GAMEPLAY);
+        vfx.seed(match_seed, rng_stream::VFX);
+    }
+};
+
+} // namespace ls
@@ -0,0 +1,58 @@
+#pragma once
+#include "core/renderer.hpp"
+#include <raylib.h>
+
+namespace ls {
+
+// Draws every command straight away with the matching raylib call
+class RaylibRenderer : public Renderer {
+  protected:
+    void submit(const DrawCommand& c) override {
+        switch (c.kind) {
+        case DrawKind::Texture:
+            DrawTexturePro(c.texture, c.src, c.dst, c.p[0], c.rotation, c.color);
+            break;
+        case DrawKind::Text:
+            if (c.font) {
+                DrawTextEx(*c.font, c.text, c.p[0], c.size, c.spacing, c.color);
+            } else {
+                DrawText(c.text, static_cast<int>(c.p[0].x), static_cast<int>(c.p[0].y), static_cast<int>(c.size),
+                         c.color);
+            }
+            break;
+        case DrawKind::Rectangle:
+            DrawRectangleRec(c.dst, c.color);
+            break;
+        case DrawKind::RectangleLines:
+            DrawRectangleLinesEx(c.dst, c.size, c.color);
+            break;
+        case DrawKind::Circle:
+            DrawCircleV(c.p[0], c.size, c.color);
+            break;
+        case DrawKind::CircleLines:
+            DrawCircleLinesV(c.p[0], c.size, c.color);
+            break;
+        case DrawKind::Line:
+            DrawLineV(c.p[0], c.p[1], c.color);
+            break;
+        case DrawKind::ThickLine:
+            DrawLineEx(c.p[0], c.p[1], c.size, c.color);
+            break;
+        case DrawKind::Triangle:
+            DrawTriangle(c.p[0], c.p[1], c.p[2], c.color);
+            break;
+        case DrawKind::Poly:
+            DrawPoly(c.p[0], c.sides, c.size, c.rotation, c.color);
+            break;
+        }
+    }
+
+    unsigned font_texture(const Font* font) const override {
+        return font ? font->texture.id : GetFontDefault().texture.id;
+    }
+
+    void on_begin_world(const Camera2D& cam) override { BeginMode2D(cam); }
+    void on_end_world() override { EndMode2D(); }
+};
+
+} // namespace ls
@@ -0,0 +1,268 @@
+#pragma once
+#include <cmath>
+#include <cstdint>
+#include <raylib.h>
+#include <string>
+#include <vector>
+
+namespace ls {
+
+enum class DrawKind : uint8_t {
+    Texture,
+    Text,
+    Rectangle,
+    RectangleLines,
+    Circle,
+    CircleLines,
+    Line,
+    ThickLine,
+    Triangle,
+    Poly,
+};
+
+// One draw as the render and UI systems issue it. Only the fields its kind uses are set.
+struct DrawCommand {
+    DrawKind kind{};
+    Texture2D texture{}; // Texture
+    const Font* font{};  // Text; null draws with raylib's default font
+    const char* text{};  // Text; only valid during submit()
+    Rectangle src{};     // Texture
+    Rectangle dst{};     // Texture, Rectangle, RectangleLines
+    Vector2 p[3]{};      // origin (Texture), position (Text), centre (Circle, Poly), end points (Line, Triangle)
+    float size{};        // radius, line or border thickness, font size
+    float rotation{};    // Texture, Poly
+    float spacing{};     // Text
+    int sides{};         // Poly
+    Color color{};
+};
+
+struct DrawStats {
+    uint32_t draws{};
+    uint32_t texture_draws{};
+    uint32_t text_draws{};
+    uint32_t shape_draws{};
+    uint32_t texture_switches{}; // consecutive draws that bind a different texture
+    uint32_t batches{};          // GPU draw calls: runs of draws sharing a texture and primitive type
+    uint32_t flushes{};          // vertex buffer uploads (camera changes, full buffer, end of frame)
+    double pixels{};             // screen area covered, summed over every draw
+
+    // Average number of times each pixel of a w x h screen was drawn
+    double overdraw(int w, int h) const { return w > 0 && h > 0 ? pixels / (static_cast<double>(w) * h) : 0.0; }
+};
+
+// Drawing front end for the render and UI systems. Every call is counted the way raylib's rlgl
+// batches it (5.5 defaults, quads draw mode): draws that share a texture and primitive type go out
+// as one GPU draw call, and the vertex buffer is flushed when full, when the camera changes and at
+// the end of the frame. Backends only decide what happens to each command.
+class Renderer {
+  public:
+    // raylib's 1x1 white texture, which every shape is drawn with
+    static constexpr unsigned SHAPES_TEXTURE = 1;
+    static constexpr int BATCH_VERTICES = 8192 * 4;
+    static constexpr int BATCH_DRAW_CALLS = 256;
+
+    virtual ~Renderer() = default;
+
+    void begin_frame() {
+        stats_ = {};
+        reset_batch();
+        has_texture_ = false;
+        on_begin_frame();
+    }
+
+    void end_frame() {
+        flush();
+        last_ = stats_;
+    }
+
+    // This frame so far, and the whole of the previous frame
+    const DrawStats& stats() const { return stats_; }
+    const DrawStats& last_frame() const { return last_; }
+
+    // World-space drawing through a camera; areas are scaled by its zoom
+    void begin_world(const Camera2D& cam) {
+        flush();
+        area_scale_ = cam.zoom * cam.zoom;
+        on_begin_world(cam);
+    }
+
+    void end_world() {
+        flush();
+        area_scale_ = 1.0f;
+        on_end_world();
+    }
+
+    void texture(const Texture2D& tex, Rectangle src, Rectangle dst, Vector2 origin, float rotation, Color tint) {
+        DrawCommand c{.kind = DrawKind::Texture, .texture = tex, .src = src, .dst = dst, .rotation = rotation,
+                      .color = tint};
+        c.p[0] = origin;
+        push(c, tex.id, Prim::Quads, 4, std::abs(dst.width * dst.height));
+    }
+
+    void text(const Font* font, const char* str, Vector2 pos, float size, float spacing, Color color) {
+        DrawCommand c{.kind = DrawKind::Text, .font = font, .text = str, .size = size, .spacing = spacing,
+                      .color = color};
+        c.p[0] = pos;
+        // One quad per visible glyph; the covered area is estimated at half an em per glyph
+        int glyphs = 0;
+        for (const char* s = str; *s; ++s) glyphs += *s != ' ' && *s != '\n';
+        push(c, font_texture(font), Prim::Quads, glyphs * 4, glyphs * size * size * 0.5f);
+    }
+
+    // Shapes, with raylib's argument order so call sites read like the raylib calls they replace
+    void rectangle(int x, int y, int w, int h, Color color) {
+        rectangle({static_cast<float>(x), static_cast<float>(y), static_cast<float>(w), static_cast<float>(h)}, color);
+    }
+
+    void rectangle(Rectangle rec, Color color) {
+        push({.kind = DrawKind::Rectangle, .dst = rec, .color = color}, SHAPES_TEXTURE, Prim::Quads, 4,
+             std::abs(rec.width * rec.height));
+    }
+
+    void rectangle_lines(Rectangle rec, float thick, Color color) {
+        push({.kind = DrawKind::RectangleLines, .dst = rec, .size = thick, .color = color}, SHAPES_TEXTURE, Prim::Quads,
+             16, 2.0f * (std::abs(rec.width) + std::abs(rec.height)) * thick);
+    }
+
+    void circle(int x, int y, float radius, Color color) {
+        circle({static_cast<float>(x), static_cast<float>(y)}, radius, color);
+    }
+
+    void circle(Vector2 center, float radius, Color color) {
+        DrawCommand c{.kind = DrawKind::Circle, .size = radius, .color = color};
+        c.p[0] = center;
+        push(c, SHAPES_TEXTURE, Prim::Quads, CIRCLE_SEGMENTS * 2, PI_F * radius * radius);
+    }
+
+    void circle_lines(int x, int y, float radius, Color color) {
+        circle_lines({static_cast<float>(x), static_cast<float>(y)}, radius, color);
+    }
+
+    void circle_lines(Vector2 center, float radius, Color color) {
+        DrawCommand c{.kind = DrawKind::CircleLines, .size = radius, .color = color};
+        c.p[0] = center;
+        push(c, SHAPES_TEXTURE, Prim::Lines, CIRCLE_SEGMENTS * 2, 2.0f * PI_F * radius);
+    }
+
+    void line(int x0, int y0, int x1, int y1, Color color) {
+        DrawCommand c{.kind = DrawKind::Line, .color = color};
+        c.p[0] = {static_cast<float>(x0), static_cast<float>(y0)};
+        c.p[1] = {static_cast<float>(x1), static_cast<float>(y1)};
+        push(c, SHAPES_TEXTURE, Prim::Lines, 2, length(c.p[0], c.p[1]));
+    }
+
+    void line(Vector2 a, Vector2 b, float thick, Color color) {
+        DrawCommand c{.kind = DrawKind::ThickLine, .size = thick, .color = color};
+        c.p[0] = a;
+        c.p[1] = b;
+        push(c, SHAPES_TEXTURE, Prim::Triangles, 6, length(a, b) * thick);
+    }
+
+    void triangle(Vector2 a, Vector2 b, Vector2 c, Color color) {
+        DrawCommand cmd{.kind = DrawKind::Triangle, .color = color};
+        cmd.p[0] = a;
+        cmd.p[1] = b;
+        cmd.p[2] = c;
+        float area = std::abs((b.x - a.x) * (c.y - a.y) - (c.x - a.x) * (b.y - a.y)) / 2.0f;
+        push(cmd, SHAPES_TEXTURE, Prim::Quads, 4, area);
+    }
+
+    void poly(Vector2 center, int sides, float radius, float rotation, Color color) {
+        DrawCommand c{.kind = DrawKind::Poly, .size = radius, .rotation = rotation, .sides = sides, .color = color};
+        c.p[0] = center;
+        float n = static_cast<float>(sides);
+        float area = 0.5f * n * radius * radius * std::sin(2.0f * PI_F / n);
+        push(c, SHAPES_TEXTURE, Prim::Quads, sides * 4, area);
+    }
+
+  protected:
+    virtual void submit(const DrawCommand& c) = 0;
+    // Texture a font's glyphs are drawn from; decides whether text batches with its neighbours
+    virtual unsigned font_texture(const Font* font) const = 0;
+    virtual void on_begin_frame() {}
+    virtual void on_begin_world(const Camera2D&) {}
+    virtual void on_end_world() {}
+
+  private:
+    enum class Prim : uint8_t { Lines, Triangles, Quads };
+    static constexpr int CIRCLE_SEGMENTS = 36;
+    static constexpr float PI_F = 3.14159265f;
+
+    DrawStats stats_;
+    DrawStats last_;
+    unsigned texture_{};   // bound by the last draw
+    Prim prim_{};          // primitive type of the open draw call
+    int calls_{};          // draw calls in the open batch
+    int vertices_{};       // vertices in the open batch
+    bool has_texture_{false};
+    float area_scale_{1.0f};
+
+    static float length(Vector2 a, Vector2 b) { return std::hypot(b.x - a.x, b.y - a.y); }
+
+    void reset_batch() {
+        calls_ = 0;
+        vertices_ = 0;
+    }
+
+    void flush() {
+        if (calls_ == 0) return;
+        ++stats_.flushes;
+        reset_batch();
+    }
+
+    void push(const DrawCommand& c, unsigned texture, Prim prim, int vertices, float area) {
+        ++stats_.draws;
+        if (c.kind == DrawKind::Texture) {
+            ++stats_.texture_draws;
+        } else if (c.kind == DrawKind::Text) {
+            ++stats_.text_draws;
+        } else {
+            ++stats_.shape_draws;
+        }
+        if (has_texture_ && texture != texture_) ++stats_.texture_switches;
+
+        if (vertices_ + vertices >= BATCH_VERTICES) flush();
+        if (calls_ == 0 || texture != texture_ || prim != prim_) {
+            if (calls_ >= BATCH_DRAW_CALLS) flush();
+            ++calls_;
+            ++stats_.batches;
+        }
+        texture_ = texture;
+        prim_ = prim;
+        has_texture_ = true;
+        vertices_ += vertices;
+        stats_.pixels += static_cast<double>(area * area_scale_);
+        submit(c);
+    }
+};
+
+// Keeps every command of the current frame instead of drawing it. Needs nothing from raylib but
+// its types, so it runs headless and against the test stub.
+class RecordingRenderer : public Renderer {
+  public:
+    // Stand-ins for font atlases, which the stub's Font doesn't carry
+    static constexpr unsigned FONT_TEXTURE = 0xFFFF'FF00u;
+    static constexpr unsigned DEFAULT_FONT_TEXTURE = 0xFFFF'FF01u;
+
+    struct Recorded {
+        DrawCommand command; // command.text is cleared; the string is kept in `text`
+        std::string text;
+    };
+
+    const std::vector<Recorded>& commands() const { return commands_; }
+
+  protected:
+    void submit(const DrawCommand& c) override {
+        auto& r = commands_.emplace_back(Recorded{c, c.text ? c.text : ""});
+        r.command.text = nullptr;
+    }
+
+    unsigned font_texture(const Font* font) const override { return font ? FONT_TEXTURE : DEFAULT_FONT_TEXTURE; }
+
+    void on_begin_frame() override { commands_.clear(); }
+
+  private:
+    std::vector<Recorded> commands_;
+};
+
+} // namespace ls
@@ -0,0 +1,210 @@
+#pragma once
+#include "core/hero_upgrades.hpp"
+#include "core/input.hpp"
+#include "core/snapshot.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <expected>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace ls {
+
+// Replay file: a sealed snapshot with its own magic holding the ReplayHeader, then the ticks in
+// chunks, each u32 size | u32 FNV-1a | one (dt, InputFrame) record per simulation tick. Chunks are
+// appended to the file as the match goes, so a recording cut short by a crash still plays back up to
+// its last complete chunk.
+inline constexpr uint32_t REPLAY_MAGIC = 0x5052534C; // "LSRP"
+inline constexpr uint16_t REPLAY_VERSION = 3;
+inline constexpr size_t REPLAY_CHUNK_TICKS = 600;    // ten seconds at 60 Hz per chunk
+inline constexpr size_t REPLAY_CHUNK_HEADER = 8;
+
+struct ReplayHeader {
+    uint32_t seed{};
+    std::string map_name;
+    Difficulty difficulty{Difficulty::Normal};
+    HeroUpgrades upgrades{};
+};
+
+template <typename Archive, typename T>
+    requires std::same_as<std::remove_const_t<T>, ReplayHeader>
+void serialize(Archive& ar, T& h) {
+    ar(h.seed);
+    ar(h.map_name);
+    ar(h.difficulty);
+    ar(h.upgrades);
+}
+
+// Idle ticks cost one byte; the target and command list are only written when used
+template <typename Archive, typename T>
+    requires std::same_as<std::remove_const_t<T>, InputFrame>
+void serialize(Archive& ar, T& f) {
+    auto buttons = static_cast<uint8_t>(f.buttons & ~input_bits::HAS_COMMANDS);
+    if (!f.commands.empty()) buttons |= input_bits::HAS_COMMANDS;
+    ar(buttons);
+    if constexpr (!std::is_const_v<T>) {
+        f.buttons = static_cast<uint8_t>(buttons & ~input_bits::HAS_COMMANDS);
+        f.commands.clear();
+    }
+    if (buttons & input_bits::LIGHTNING) ar(f.ability_target);
+    if (buttons & input_bits::HAS_COMMANDS) ar(f.commands);
+}
+
+// Records ticks into chunks and hands back file bytes as they are ready, so only the open chunk and
+// the bytes not yet taken are held in memory. The owner takes the pending bytes and writes them out:
+// the first take() after begin() starts the file over, later ones are appended to it.
+class ReplayRecorder {
+  public:
+    explicit ReplayRecorder(std::string path, size_t chunk_ticks = REPLAY_CHUNK_TICKS)
+        : path_(std::move(path)), chunk_ticks_(std::max<size_t>(1, chunk_ticks)) {}
+
+    // Starts a new recording, discarding any previous one
+    void begin(const ReplayHeader& header) {
+        chunk_.clear();
+        chunk_(header);
+        pending_ = seal_snapshot(chunk_.bytes(), REPLAY_MAGIC, REPLAY_VERSION);
+        chunk_.clear();
+        starts_file_ = true;
+        in_chunk_ = 0;
+        ticks_ = 0;
+        active_ = true;
+    }
+
+    void record(float dt, const InputFrame& frame) {
+        if (!active_) return;
+        chunk_(dt);
+        chunk_(frame);
+        ++ticks_;
+        if (++in_chunk_ >= chunk_ticks_) close_chunk();
+    }
+
+    // Closes the open chunk and stops recording; take() the remaining bytes afterwards
+    void end() {
+        close_chunk();
+        active_ = false;
+    }
+
+    bool active() const { return active_; }
+    size_t ticks() const { return ticks_; }
+    const std::string& path() const { return path_; }
+
+    // Bytes ready for the file since the last take(), and whether they replace it rather than extend it
+    bool has_pending() const { return !pending_.empty(); }
+    bool starts_file() const { return starts_file_; }
+
+    std::vector<uint8_t> take() {
+        starts_file_ = false;
+        return std::exchange(pending_, {});
+    }
+
+    // Frames the ticks recorded since the last chunk into the pending bytes
+    void close_chunk() {
+        if (in_chunk_ == 0) return;
+        auto& body = chunk_.bytes();
+        SnapshotWriter frame;
+        frame(static_cast<uint32_t>(body.size()));
+        frame(fnv1a(body));
+        pending_.insert(pending_.end(), frame.bytes().begin(), frame.bytes().end());
+        pending_.insert(pending_.end(), body.begin(), body.end());
+        chunk_.clear();
+        in_chunk_ = 0;
+    }
+
+  private:
+    std::string path_;
+    size_t chunk_ticks_;
+    SnapshotWriter chunk_;
+    std::vector<uint8_t> pending_;
+    bool starts_file_{false};
+    size_t in_chunk_{0};
+    size_t ticks_{0};
+    bool active_{false};
+};
+
+class ReplayPlayer {
+  public:
+    ReplayPlayer() = default;
+    ReplayPlayer(ReplayPlayer&&) = default;
+    ReplayPlayer& operator=(ReplayPlayer&&) = default;
+    ReplayPlayer(const ReplayPlayer&) = delete; // chunks_ views bytes_
+    ReplayPlayer& operator=(const ReplayPlayer&) = delete;
+
+    std::expected<void, std::string> load(std::vector<uint8_t> bytes) {
+        bytes_ = std::move(bytes);
+        std::span<const uint8_t> data = bytes_;
+        uint32_t header_size{};
+        if (data.size() >= SNAPSHOT_HEADER_SIZE) {
+            SnapshotReader sizes(data.subspan(6, 4)); // after the magic and version
+            sizes(header_size);
+        }
+        size_t sealed = std::min(data.size(), SNAPSHOT_HEADER_SIZE + header_size);
+        auto payload = open_snapshot(data.first(sealed), REPLAY_MAGIC, REPLAY_VERSION);
+        if (!payload) return std::unexpected(payload.error());
+        SnapshotReader in(*payload);
+        in(header_);
+        if (in.failed()) return std::unexpected("Replay header is malformed");
+        chunks_ = data.subspan(sealed);
+        chunk_ = {};
+        pos_ = 0;
+        ticks_ = 0;
+        truncated_ = false;
+        return {};
+    }
+
+    // Fetch the next tick; false once the recording is exhausted or reaches a damaged chunk
+    bool next(float& dt, InputFrame& frame) {
+        if (pos_ >= chunk_.size() && !next_chunk()) return false;
+        SnapshotReader in(chunk_.subspan(pos_));
+        in(dt);
+        in(frame);
+        if (in.failed()) return cut_short();
+        pos_ = chunk_.size() - in.remaining();
+        ++ticks_;
+        return true;
+    }
+
+    const ReplayHeader& header() const { return header_; }
+    size_t ticks() const { return ticks_; }
+
+    // Whether playback ended at a partial or damaged chunk, as a recording cut short by a crash does
+    bool truncated() const { return truncated_; }
+
+  private:
+    std::vector<uint8_t> bytes_;
+    std::span<const uint8_t> chunks_; // complete chunks not yet started, and any partial one after them
+    std::span<const uint8_t> chunk_;  // the chunk being played
+    size_t pos_{0};
+    size_t ticks_{0};
+    bool truncated_{false};
+    ReplayHeader header_;
+
+    bool next_chunk() {
+        while (!chunks_.empty()) {
+            if (chunks_.size() < REPLAY_CHUNK_HEADER) return cut_short();
+            SnapshotReader in(chunks_.first(REPLAY_CHUNK_HEADER));
+            uint32_t size{}, checksum{};
+            in(size);
+            in(checksum);
+            auto body = chunks_.subspan(REPLAY_CHUNK_HEADER);
+            if (body.size() < size || fnv1a(body.first(size)) != checksum) return cut_short();
+            chunk_ = body.first(size);
+            chunks_ = body.subspan(size);
+            pos_ = 0;
+            if (!chunk_.empty()) return true;
+        }
+        return false;
+    }
+
+    // Ends playback at a partial or damaged chunk
+    bool cut_short() {
+        truncated_ = true;
+        chunks_ = {};
+        chunk_ = {};
+        pos_ = 0;
+        return false;
+    }
+};
+
+} // namespace ls
@@ -0,0 +1,278 @@
+#pragma once
+#include "components/components.hpp"
+#include <concepts>
+#include <cstdint>
+#include <cstring>
+#include <entt/entt.hpp>
+#include <expected>
+#include <memory>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace ls {
+
+// Binary save format:
+//   u32 magic | u16 version | u32 payload size | u32 FNV-1a of payload | payload
+// Bump SNAPSHOT_VERSION whenever a serialized component or field list changes layout.
+inline constexpr uint32_t SNAPSHOT_MAGIC = 0x5653534C; // "LSSV"
+inline constexpr uint16_t SNAPSHOT_VERSION = 7;
+inline constexpr size_t SNAPSHOT_HEADER_SIZE = 14;
+
+// Every component type stored in a registry snapshot
+using SnapshotComponents =
+    entt::type_list<Transform, Velocity, GridCell, Sprite, HealthBarComp, FloatingText, Particle, AnimatedSprite,
+                    Health, Damage, Effect, Aura, Tower, Enemy, PathFollower, Boss, AttackFlash, Flying, Hero,
+                    Lifetime, Selected, Dead, Hovered, Coin>;
+
+inline uint32_t fnv1a(std::span<const uint8_t> data) {
+    uint32_t h = 2166136261u;
+    for (auto b : data) {
+        h ^= b;
+        h *= 16777619u;
+    }
+    return h;
+}
+
+// Field lists for components that hold strings or vectors (shared by writer and reader)
+template <typename Archive, typename T>
+    requires std::same_as<std::remove_const_t<T>, Sprite>
+void serialize(Archive& ar, T& s) {
+    ar(s.color);
+    ar(s.layer);
+    ar(s.width);
+    ar(s.height);
+    ar(s.visible);
+    ar(s.texture_name);
+}
+
+template <typename Archive, typename T>
+    requires std::same_as<std::remove_const_t<T>, FloatingText>
+void serialize(Archive& ar, T& ft) {
+    ar(ft.text);
+    ar(ft.color);
+    ar(ft.timer);
+    ar(ft.max_time);
+    ar(ft.speed);
+}
+
+template <typename Archive, typename T>
+    requires std::same_as<std::remove_const_t<T>, Particle>
+void serialize(Archive& ar, T& p) {
+    ar(p.color);
+    ar(p.size);
+    ar(p.decay);
+    ar(p.particle_texture);
+}
+
+template <typename Archive, typename T>
+    requires std::same_as<std::remove_const_t<T>, AnimatedSprite>
+void serialize(Archive& ar, T& a) {
+    ar(a.texture_name);
+    ar(a.frame_width);
+    ar(a.frame_height);
+    ar(a.columns);
+    ar(a.rows);
+    ar(a.current_frame);
+    ar(a.direction);
+    ar(a.frame_timer);
+    ar(a.frame_speed);
+    ar(a.anim_frames);
+    ar(a.display_size);
+    ar(a.playing);
+}
+
+template <typename Archive, typename T>
+    requires std::same_as<std::remove_const_t<T>, PathFollower>
+void serialize(Archive& ar, T& pf) {
+    ar(pf.path);
+    ar(pf.current_index);
+    ar(pf.speed);
+    ar(pf.base_speed);
+    ar(pf.distance);
+}
+
+template <typename Archive, typename T>
+    requires std::same_as<std::remove_const_t<T>, Boss>
+void serialize(Archive& ar, T& b) {
+    ar(b.ability_cooldown);
+    ar(b.ability_timer);
+    ar(b.name);
+    ar(b.boss_ability);
+    ar(b.ability_active);
+    ar(b.ability_duration);
+}
+
+// Output archive for entt::snapshot. Trivially copyable values are copied raw.
+class SnapshotWriter {
+  public:
+    SnapshotWriter() { buf_.reserve(64 * 1024); }
+
+    template <typename T>
+    void operator()(const T& v) {
+        if constexpr (std::is_trivially_copyable_v<T>) {
+            write_raw(&v, sizeof(T));
+        } else {
+            serialize(*this, v);
+        }
+    }
+
+    void operator()(const std::string& s) {
+        (*this)(static_cast<uint32_t>(s.size()));
+        write_raw(s.data(), s.size());
+    }
+
+    template <typename T>
+    void operator()(const std::vector<T>& v) {
+        (*this)(static_cast<uint32_t>(v.size()));
+        for (auto& item : v) (*this)(item);
+    }
+
+    // Shared paths are written by value as their waypoints; a null pointer is an empty path
+    void operator()(const SharedPath& p) {
+        if (p) {
+            (*this)(p->points());
+        } else {
+            (*this)(uint32_t{0});
+        }
+    }
+
+    const std::vector<uint8_t>& bytes() const { return buf_; }
+
+    // Empties the buffer, keeping its capacity
+    void clear() { buf_.clear(); }
+
+  private:
+    void write_raw(const void* p, size_t n) {
+        auto* b = static_cast<const uint8_t*>(p);
+        buf_.insert(buf_.end(), b, b + n);
+    }
+
+    std::vector<uint8_t> buf_;
+};
+
+// Input archive for entt::snapshot_loader. Reading past the end zero-fills and sets failed().
+class SnapshotReader {
+  public:
+    explicit SnapshotReader(std::span<const uint8_t> data) : data_(data) {}
+
+    template <typename T>
+    void operator()(T& v) {
+        if constexpr (std::is_trivially_copyable_v<T>) {
+            read_raw(&v, sizeof(T));
+        } else {
+            serialize(*this, v);
+        }
+    }
+
+    void operator()(std::string& s) {
+        uint32_t n{};
+        (*this)(n);
+        if (n > remaining()) {
+            failed_ = true;
+            n = 0;
+        }
+        s.assign(reinterpret_cast<const char*>(data_.data() + pos_), n);
+        pos_ += n;
+    }
+
+    template <typename T>
+    void operator()(std::vector<T>& v) {
+        uint32_t n{};
+        (*this)(n);
+        if (n > remaining()) {
+            failed_ = true;
+            n = 0;
+        }
+        v.resize(n);
+        for (auto& item : v) (*this)(item);
+    }
+
+    // Each shared path loads as its own copy
+    void operator()(SharedPath& p) {
+        std::vector<Vec2> points;
+        (*this)(points);
+        p = make_path(std::move(points));
+    }
+
+    bool failed() const { return failed_; }
+    size_t remaining() const { return data_.size() - pos_; }
+
+  private:
+    void read_raw(void* p, size_t n) {
+        if (n > remaining()) {
+            failed_ = true;
+            std::memset(p, 0, n);
+            pos_ = data_.size();
+            return;
+        }
+        std::memcpy(p, data_.data() + pos_, n);
+        pos_ += n;
+    }
+
+    std::span<const uint8_t> data_;
+    size_t pos_{0};
+    bool failed_{false};
+};
+
+template <typename... Component>
+void save_registry(const entt::registry& reg, SnapshotWriter& out, entt::type_list<Component...>) {
+    entt::snapshot snap{reg};
+    snap.get<entt::entity>(out);
+    (snap.get<Component>(out), ...);
+}
+
+// Entity identifiers are preserved, so entity references stored inside components stay valid
+template <typename... Component>
+void load_registry(entt::registry& reg, SnapshotReader& in, entt::type_list<Component...>) {
+    entt::snapshot_loader loader{reg};
+    loader.get<entt::entity>(in);
+    (loader.get<Component>(in), ...);
+}
+
+inline void save_registry(const entt::registry& reg, SnapshotWriter& out) {
+    save_registry(reg, out, SnapshotComponents{});
+}
+
+// `reg` must be empty (freshly constructed or cleared)
+inline void load_registry(entt::registry& reg, SnapshotReader& in) { load_registry(reg, in, SnapshotComponents{}); }
+
+// Wrap a payload with the versioned header (other binary formats pass their own magic and version)
+inline std::vector<uint8_t> seal_snapshot(const std::vector<uint8_t>& payload, uint32_t magic = SNAPSHOT_MAGIC,
+                                          uint16_t version = SNAPSHOT_VERSION) {
+    SnapshotWriter header;
+    header(magic);
+    header(version);
+    header(static_cast<uint32_t>(payload.size()));
+    header(fnv1a(payload));
+    std::vector<uint8_t> out;
+    out.reserve(SNAPSHOT_HEADER_SIZE + payload.size());
+    out.insert(out.end(), header.bytes().begin(), header.bytes().end());
+    out.insert(out.end(), payload.begin(), payload.end());
+    return out;
+}
+
+// Validate the header and checksum, returning the payload
+inline std::expected<std::span<const uint8_t>, std::string>
+open_snapshot(std::span<const uint8_t> data, uint32_t expected_magic = SNAPSHOT_MAGIC,
+              uint16_t expected_version = SNAPSHOT_VERSION) {
+    if (data.size() < SNAPSHOT_HEADER_SIZE) return std::unexpected("Snapshot too short");
+    SnapshotReader header(data.first(SNAPSHOT_HEADER_SIZE));
+    uint32_t magic{}, size{}, checksum{};
+    uint16_t version{};
+    header(magic);
+    header(version);
+    header(size);
+    header(checksum);
+    if (magic != expected_magic) return std::unexpected("Unrecognized file format");
+    if (version != expected_version) {
+        return std::unexpected("Unsupported file version " + std::to_string(version));
+    }
+    auto payload = data.subspan(SNAPSHOT_HEADER_SIZE);
+    if (payload.size() != size) return std::unexpected("Snapshot size mismatch");
+    if (fnv1a(payload) != checksum) return std::unexpected("Snapshot checksum mismatch");
+    return payload;
+}
+
+} // namespace ls
@@ -0,0 +1,169 @@
+#pragma once
+#include "core/enemy_index.hpp"
+#include "core/snapshot.hpp"
+#include "types.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <entt/entt.hpp>
+#include <expected>
+#include <format>
+#include <string>
+#include <vector>
+#if defined(__linux__)
+#include <unistd.h>
+#endif
+
+namespace ls {
+
+// Resident set size of this process in KB; 0 where the platform doesn't report it
+inline size_t current_rss_kb() {
+#if defined(__linux__)
+    std::FILE* f = std::fopen("/proc/self/statm", "r");
+    if (!f) return 0;
+    unsigned long size = 0, resident = 0;
+    int read = std::fscanf(f, "%lu %lu", &size, &resident);
+    std::fclose(f);
+    if (read != 2) return 0;
+    return static_cast<size_t>(resident) * static_cast<size_t>(sysconf(_SC_PAGESIZE)) / 1024;
+#else
+    return 0;
+#endif
+}
+
+// Entity ids in use (the entity pool also keeps released ids for reuse)
+inline size_t live_entities(entt::registry& reg) { return reg.storage<entt::entity>().free_list(); }
+
+template <typename... Component>
+size_t pool_capacity(entt::registry& reg, entt::type_list<Component...>) {
+    return reg.storage<entt::entity>().capacity() + (reg.storage<Component>().capacity() + ...);
+}
+
+// Slots allocated across the entity pool and every component pool
+inline size_t pool_capacity(entt::registry& reg) {
+    return pool_capacity(reg, entt::type_list_cat_t<SnapshotComponents, RuntimeComponents>{});
+}
+
+// State of the process after one soak match ended
+struct SoakSample {
+    std::string map;
+    WaveNum wave{};
+    bool won{};
+    int gold_collected{}; // from coins the bot picked up
+    size_t rss_kb{};
+    size_t entities{};
+    size_t pool_capacity{};
+    size_t assets{};
+};
+
+struct SoakLimits {
+    int warmup{3};                  // matches that set the baseline; one per map
+    size_t rss_slack_kb{16 * 1024}; // allowed RSS above the baseline peak
+    double rss_slope_kb{256.0};     // allowed average RSS growth per match after warm-up
+    double growth{2.0};             // pool capacity and live entities, as a multiple of the baseline
+    size_t entity_slack{256};       // on top of `growth`, for matches that end with a full field
+};
+
+// Soak mode (--soak N): plays N full matches back to back with a bot, rotating through the maps,
+// and fails if memory, registry pools or live entities keep growing once every map has been played,
+// or if a match ends without the bot collecting a coin (the drop, pickup and expiry path went unused).
+// The matches themselves run in PlayingState; this holds the samples and the verdict.
+class SoakTest {
+  public:
+    static constexpr float TICK = 1.0f / 60.0f; // fixed simulation step, independent of the frame rate
+
+    explicit SoakTest(int matches, uint32_t seed = 1, SoakLimits limits = {})
+        : matches_(matches), seed_(seed), limits_(limits) {}
+
+    int matches() const { return matches_; }
+    int played() const { return static_cast<int>(samples_.size()); }
+    bool finished() const { return played() >= matches_; }
+    const SoakLimits& limits() const { return limits_; }
+    const std::vector<SoakSample>& samples() const { return samples_; }
+
+    // Each match gets its own seed, so a failing run can be repeated exactly
+    uint32_t match_seed() const { return seed_ + static_cast<uint32_t>(played()); }
+
+    void record(SoakSample s) { samples_.push_back(std::move(s)); }
+
+    // Average RSS change per match after warm-up (least-squares slope), in KB
+    double rss_slope_kb() const {
+        auto n = samples_.size() - std::min(samples_.size(), static_cast<size_t>(limits_.warmup));
+        if (n < 2) return 0.0;
+        double sx = 0, sy = 0, sxx = 0, sxy = 0;
+        for (size_t i = 0; i < n; ++i) {
+            double x = static_cast<double>(i);
+            double y = static_cast<double>(samples_[samples_.size() - n + i].rss_kb);
+            sx += x;
+            sy += y;
+            sxx += x * x;
+            sxy += x * y;
+        }
+        double d = static_cast<double>(n) * sxx - sx * sx;
+        return (static_cast<double>(n) * sxy - sx * sy) / d;
+    }
+
+    // Every limit broken after warm-up, one line each
+    std::expected<void, std::string> check() const {
+        if (played() <= limits_.warmup) return {};
+        SoakSample base;
+        for (int i = 0; i < limits_.warmup; ++i) {
+            auto& s = samples_[static_cast<size_t>(i)];
+            base.rss_kb = std::max(base.rss_kb, s.rss_kb);
+            base.entities = std::max(base.entities, s.entities);
+            base.pool_capacity = std::max(base.pool_capacity, s.pool_capacity);
+            base.assets = std::max(base.assets, s.assets);
+        }
+        auto grown = [&](size_t value, size_t baseline, size_t slack) {
+            double limit = static_cast<double>(baseline) * limits_.growth + static_cast<double>(slack);
+            return static_cast<double>(value) > limit;
+        };
+
+        std::string errors;
+        for (int i = limits_.warmup; i < played(); ++i) {
+            auto& s = samples_[static_cast<size_t>(i)];
+            auto fail = [&](std::string_view what, size_t value, size_t baseline) {
+                errors += std::format("match {} ({}): {} {} exceeds the limit (baseline {})\n", i + 1, s.map, what,
+                                      value, baseline);
+            };
+            if (base.rss_kb > 0 && s.rss_kb > base.rss_kb + limits_.rss_slack_kb) fail("RSS KB", s.rss_kb, base.rss_kb);
+            if (grown(s.pool_capacity, base.pool_capacity, 0)) {
+                fail("pool capacity", s.pool_capacity, base.pool_capacity);
+            }
+            if (grown(s.entities, base.entities, limits_.entity_slack)) {
+                fail("live entities", s.entities, base.entities);
+            }
+            if (s.assets != base.assets) fail("loaded assets", s.assets, base.assets);
+            if (s.gold_collected <= 0) {
+                errors += std::format("match {} ({}): the bot collected no coins\n", i + 1, s.map);
+            }
+        }
+        if (double slope = rss_slope_kb(); slope > limits_.rss_slope_kb) {
+            errors += std::format("RSS grows {:.0f} KB per match after warm-up\n", slope);
+        }
+        if (!errors.empty()) return std::unexpected(errors);
+        return {};
+    }
+
+    // Plain-text table for the end of a run
+    std::string report() const {
+        std::string out = std::format("Soak: {} matches\n", played());
+        out += std::format("{:>5}  {:<8}{:>6}{:>6}{:>8}{:>12}{:>10}{:>10}{:>8}\n", "match", "map", "wave", "won",
+                           "gold", "rss_kb", "entities", "pool_cap", "assets");
+        for (size_t i = 0; i < samples_.size(); ++i) {
+            auto& s = samples_[i];
+            out += std::format("{:>5}  {:<8}{:>6}{:>6}{:>8}{:>12}{:>10}{:>10}{:>8}\n", i + 1, s.map, s.wave,
+                               s.won ? "yes" : "no", s.gold_collected, s.rss_kb, s.entities, s.pool_capacity, s.assets);
+        }
+        out += std::format("RSS slope after warm-up: {:.1f} KB/match\n", rss_slope_kb());
+        return out;
+    }
+
+  private:
+    int matches_;
+    uint32_t seed_;
+    SoakLimits limits_;
+    std::vector<SoakSample> samples_;
+};
+
+} // namespace ls
@@ -0,0 +1,158 @@
+#pragma once
+#include "types.hpp"
+#include <algorithm>
+#include <cmath>
+#include <entt/entt.hpp>
+#include <vector>
+
+namespace ls {
+
+// Uniform-grid broadphase for one frame. Points are inserted, then build() buckets them into square
+// cells with a counting sort over a flat array, so rebuilding every frame reuses the same storage.
+// With the cell size at least the largest interaction distance, every pair closer than that lies in
+// the same or a neighbouring cell. Results are in a fixed order for a given insertion order.
+class SpatialGrid {
+  public:
+    static constexpr int MAX_CELLS_PER_AXIS = 1024;
+
+    struct Item {
+        entt::entity entity;
+        Vec2 pos;
+    };
+
+    void clear() {
+        items_.clear();
+        cols_ = rows_ = 0;
+    }
+
+    void insert(entt::entity e, Vec2 pos) { items_.push_back({e, pos}); }
+
+    size_t size() const { return items_.size(); }
+
+    // Sizes storage for `items` points spread over up to `cells` cells, so rebuilds up to that don't allocate
+    void reserve(size_t items, size_t cells) {
+        items_.reserve(items);
+        sorted_.reserve(items);
+        cells_.reserve(items);
+        starts_.reserve(cells + 1);
+        fill_.reserve(cells + 1);
+    }
+
+    // Buckets everything inserted since clear() into cells of at least `cell_size`
+    void build(float cell_size) {
+        sorted_.clear();
+        if (items_.empty()) return;
+        Vec2 lo = items_.front().pos, hi = lo;
+        for (auto& it : items_) {
+            lo = {std::min(lo.x, it.pos.x), std::min(lo.y, it.pos.y)};
+            hi = {std::max(hi.x, it.pos.x), std::max(hi.y, it.pos.y)};
+        }
+        // Coarser cells when the points are spread too far apart for the cell count
+        float extent = std::max(hi.x - lo.x, hi.y - lo.y);
+        cell_ = std::max({cell_size, 1.0f, extent / (MAX_CELLS_PER_AXIS - 1)});
+        origin_ = lo;
+        cols_ = static_cast<int>((hi.x - lo.x) / cell_) + 1;
+        rows_ = static_cast<int>((hi.y - lo.y) / cell_) + 1;
+
+        starts_.assign(static_cast<size_t>(cols_ * rows_) + 1, 0);
+        cells_.resize(items_.size());
+        for (size_t i = 0; i < items_.size(); ++i) {
+            cells_[i] = cell_index(items_[i].pos);
+            ++starts_[cells_[i] + 1];
+        }
+        for (size_t c = 1; c < starts_.size(); ++c) starts_[c] += starts_[c - 1];
+        fill_ = starts_;
+        sorted_.resize(items_.size());
+        for (size_t i = 0; i < items_.size(); ++i) sorted_[fill_[cells_[i]]++] = items_[i];
+    }
+
+    // Calls fn(a, b) once for every pair of items in the same or adjacent cells; callers check the
+    // actual distance
+    template <typename Fn>
+    void for_each_pair(Fn&& fn) const {
+        constexpr int NEIGHBOURS[4][2] = {{1, 0}, {-1, 1}, {0, 1}, {1, 1}}; // each adjacent pair of cells once
+        for (int cy = 0; cy < rows_; ++cy) {
+            for (int cx = 0; cx < cols_; ++cx) {
+                auto [first, last] = cell_range(cx, cy);
+                for (size_t i = first; i < last; ++i) {
+                    for (size_t j = i + 1; j < last; ++j) fn(sorted_[i], sorted_[j]);
+                }
+                for (auto& [dx, dy] : NEIGHBOURS) {
+                    int nx = cx + dx, ny = cy + dy;
+                    if (nx < 0 || nx >= cols_ || ny >= rows_) continue;
+                    auto [nfirst, nlast] = cell_range(nx, ny);
+                    for (size_t i = first; i < last; ++i) {
+                        for (size_t j = nfirst; j < nlast; ++j) fn(sorted_[i], sorted_[j]);
+                    }
+                }
+            }
+        }
+    }
+
+    // Calls fn(item) for every item in a cell the circle overlaps
+    template <typename Fn>
+    void query(Vec2 center, float radius, Fn&& fn) const {
+        if (sorted_.empty()) return;
+        int x0 = std::max(0, axis_cell(center.x - radius, origin_.x));
+        int x1 = std::min(cols_ - 1, axis_cell(center.x + radius, origin_.x));
+        int y0 = std::max(0, axis_cell(center.y - radius, origin_.y));
+        int y1 = std::min(rows_ - 1, axis_cell(center.y + radius, origin_.y));
+        for (int cy = y0; cy <= y1; ++cy) {
+            for (int cx = x0; cx <= x1; ++cx) {
+                auto [first, last] = cell_range(cx, cy);
+                for (size_t i = first; i < last; ++i) fn(sorted_[i]);
+            }
+        }
+    }
+
+    // Calls fn(item) for every item in a cell that a circle of `radius` swept from `a` to `b` overlaps;
+    // callers check the actual distance. Only cells near the segment are visited, not its whole bounding
+    // box, so a long diagonal sweep stays cheap.
+    template <typename Fn>
+    void query_segment(Vec2 a, Vec2 b, float radius, Fn&& fn) const {
+        if (sorted_.empty()) return;
+        int x0 = std::max(0, axis_cell(std::min(a.x, b.x) - radius, origin_.x));
+        int x1 = std::min(cols_ - 1, axis_cell(std::max(a.x, b.x) + radius, origin_.x));
+        int y0 = std::max(0, axis_cell(std::min(a.y, b.y) - radius, origin_.y));
+        int y1 = std::min(rows_ - 1, axis_cell(std::max(a.y, b.y) + radius, origin_.y));
+        Vec2 d = b - a;
+        float len2 = d.x * d.x + d.y * d.y;
+        float reach = radius + cell_ * 0.70711f; // a cell's items lie within half its diagonal of its centre
+        for (int cy = y0; cy <= y1; ++cy) {
+            for (int cx = x0; cx <= x1; ++cx) {
+                Vec2 c{origin_.x + (static_cast<float>(cx) + 0.5f) * cell_,
+                       origin_.y + (static_cast<float>(cy) + 0.5f) * cell_};
+                float t = len2 > 0.0f ? std::clamp(((c.x - a.x) * d.x + (c.y - a.y) * d.y) / len2, 0.0f, 1.0f) : 0.0f;
+                if (c.distance_to(a + d * t) > reach) continue;
+                auto [first, last] = cell_range(cx, cy);
+                for (size_t i = first; i < last; ++i) fn(sorted_[i]);
+            }
+        }
+    }
+
+  private:
+    std::vector<Item> items_;  // insertion order
+    std::vector<Item> sorted_; // grouped by cell
+    std::vector<size_t> cells_;
+    std::vector<size_t> starts_; // first sorted_ index of each cell, plus an end marker
+    std::vector<size_t> fill_;
+    Vec2 origin_{};
+    float cell_{1.0f};
+    int cols_{0};
+    int rows_{0};
+
+    int axis_cell(float v, float origin) const { return static_cast<int>(std::floor((v - origin) / cell_)); }
+
+    size_t cell_index(Vec2 p) const {
+        int cx = std::clamp(axis_cell(p.x, origin_.x), 0, cols_ - 1);
+        int cy = std::clamp(axis_cell(p.y, origin_.y), 0, rows_ - 1);
+        return static_cast<size_t>(cy * cols_ + cx);
+    }
+
+    std::pair<size_t, size_t> cell_range(int cx, int cy) const {
+        auto c = static_cast<size_t>(cy * cols_ + cx);
+        return {starts_[c], starts_[c + 1]};
+    }
+};
+
+} // namespace ls
@@ -1,4 +1,5 @@
 #pragma once
+#include "core/profiler.hpp"
 #include "types.hpp"
 #include <concepts>
 #include <memory>
@@ -8,6 +9,12 @@ namespace ls {
 
 struct Game;
 
+inline const char* state_name(GameStateId id) {
+    static constexpr const char* names[] = {"Menu",     "MapSelect", "Playing", "Paused",
+                                            "GameOver", "Victory",   "Upgrades"};
+    return names[static_cast<size_t>(id)];
+}
+
 class IGameState {
   public:
     virtual ~IGameState() = default;
@@ -33,6 +40,7 @@ class StateMachine {
     }
 
     void change_state(GameStateId new_state, Game& game) {
+        TRACE_SCOPE_DETAIL("change_state", "state", state_name(new_state));
         if (current_) {
             previous_ = current_->id();
             current_->exit(game);
@@ -43,6 +51,7 @@ class StateMachine {
 
     // Resume a state without calling enter() — used to unpause
     void resume_state(GameStateId state, Game& game) {
+        TRACE_SCOPE_DETAIL("resume_state", "state", state_name(state));
         if (current_) current_->exit(game);
         current_ = states_.at(state).get();
     }
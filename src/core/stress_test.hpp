@@ -0,0 +1,78 @@
+#pragma once
+#include "core/perf_stats.hpp"
+#include <algorithm>
+#include <optional>
+
+namespace ls {
+
+// Where the frame time first stayed above a budget for a whole measurement window
+struct StressMark {
+    float time{};     // seconds into the test
+    float frame_ms{}; // window average
+    EntityCounts counts;
+};
+
+// Stress mode: spawns ramp up without limit until the frame time collapses. The ramp itself
+// lives in systems::stress_system; this tracks it and the frame-time measurements.
+class StressTest {
+  public:
+    static constexpr float BUDGET_60FPS_MS = 16.6f;
+    static constexpr float BUDGET_30FPS_MS = 33.0f;
+    static constexpr float WARMUP = 2.0f;       // ignore load hitches right after entering
+    static constexpr float WINDOW = 0.5f;       // frame times are averaged over this much real time
+    static constexpr float TIME_LIMIT = 300.0f; // give up on machines that never reach 33 ms
+
+    // Ramp, as a function of elapsed simulation time
+    float spawn_rate() const { return 20.0f + 20.0f * elapsed_; } // enemies per second
+    float enemy_scaling() const { return 1.0f + 0.05f * elapsed_; }
+    int tower_target() const { return 10 + static_cast<int>(2.0f * elapsed_); }
+
+    // Number of enemies to spawn this tick
+    int advance(float dt) {
+        elapsed_ += dt;
+        spawn_accum_ += spawn_rate() * dt;
+        int n = static_cast<int>(spawn_accum_);
+        spawn_accum_ -= static_cast<float>(n);
+        return n;
+    }
+
+    // Feed one real (unscaled) frame time; call once per rendered frame
+    void record_frame(float frame_seconds, const EntityCounts& counts) {
+        if (finished_) return;
+        wall_time_ += frame_seconds;
+        peak_ = std::max(peak_, counts.total);
+        if (wall_time_ < WARMUP) return;
+
+        window_time_ += frame_seconds;
+        ++window_frames_;
+        if (window_time_ < WINDOW) return;
+
+        float avg_ms = window_time_ * 1000.0f / static_cast<float>(window_frames_);
+        window_time_ = 0.0f;
+        window_frames_ = 0;
+        if (!mark_60fps_ && avg_ms > BUDGET_60FPS_MS) mark_60fps_ = StressMark{elapsed_, avg_ms, counts};
+        if (!mark_30fps_ && avg_ms > BUDGET_30FPS_MS) mark_30fps_ = StressMark{elapsed_, avg_ms, counts};
+        if (mark_30fps_ || wall_time_ >= TIME_LIMIT) finished_ = true;
+    }
+
+    // Live entities the machine sustained at 60 FPS; the peak if it never dropped below
+    int capacity_score() const { return mark_60fps_ ? mark_60fps_->counts.total : peak_; }
+
+    bool finished() const { return finished_; }
+    float elapsed() const { return elapsed_; }
+    const std::optional<StressMark>& mark_60fps() const { return mark_60fps_; }
+    const std::optional<StressMark>& mark_30fps() const { return mark_30fps_; }
+
+  private:
+    float elapsed_{0.0f};
+    float spawn_accum_{0.0f};
+    float wall_time_{0.0f};
+    float window_time_{0.0f};
+    int window_frames_{0};
+    int peak_{0};
+    bool finished_{false};
+    std::optional<StressMark> mark_60fps_;
+    std::optional<StressMark> mark_30fps_;
+};
+
+} // namespace ls
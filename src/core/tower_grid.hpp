@@ -0,0 +1,80 @@
+#pragma once
+#include "constants.hpp"
+#include "types.hpp"
+#include <algorithm>
+#include <cmath>
+#include <entt/entt.hpp>
+#include <vector>
+
+namespace ls {
+
+// Tower entity standing on each grid cell, in a dense row-major array. Towers never move, so
+// placement checks, selection and "towers near this point" are index lookups instead of set probes
+// or registry scans. Grows to fit the cells it is given, so a default-constructed grid works for any
+// map; the command, stress and health systems keep it in step with the registry.
+class TowerGrid {
+  public:
+    entt::entity at(GridPos p) const { return contains(p) ? cells_[index(p)] : entt::entity{entt::null}; }
+    bool occupied(GridPos p) const { return at(p) != entt::null; }
+    size_t size() const { return count_; }
+
+    void place(GridPos p, entt::entity e) {
+        if (p.x < 0 || p.y < 0) return;
+        if (!contains(p)) grow(std::max(cols_, p.x + 1), std::max(rows_, p.y + 1));
+        auto& cell = cells_[index(p)];
+        if (cell == entt::null) ++count_;
+        cell = e;
+    }
+
+    void remove(GridPos p) {
+        if (!contains(p)) return;
+        auto& cell = cells_[index(p)];
+        if (cell != entt::null) --count_;
+        cell = entt::null;
+    }
+
+    void clear() {
+        std::fill(cells_.begin(), cells_.end(), entt::entity{entt::null});
+        count_ = 0;
+    }
+
+    // Calls fn(entity) for every tower on a cell that overlaps the circle. Callers still check the
+    // exact distance; this only bounds the search to the cells the radius can reach.
+    template <typename Fn>
+    void for_each_near(Vec2 center, float radius, Fn&& fn) const {
+        if (count_ == 0) return;
+        auto cell_of = [](float world, int offset) {
+            return static_cast<int>(std::floor((world - static_cast<float>(offset)) / TILE_SIZE));
+        };
+        int x0 = std::max(0, cell_of(center.x - radius, GRID_OFFSET_X));
+        int x1 = std::min(cols_ - 1, cell_of(center.x + radius, GRID_OFFSET_X));
+        int y0 = std::max(0, cell_of(center.y - radius, GRID_OFFSET_Y));
+        int y1 = std::min(rows_ - 1, cell_of(center.y + radius, GRID_OFFSET_Y));
+        for (int y = y0; y <= y1; ++y) {
+            for (int x = x0; x <= x1; ++x) {
+                if (auto e = cells_[index({x, y})]; e != entt::null) fn(e);
+            }
+        }
+    }
+
+  private:
+    std::vector<entt::entity> cells_;
+    int cols_{0};
+    int rows_{0};
+    size_t count_{0};
+
+    bool contains(GridPos p) const { return p.x >= 0 && p.x < cols_ && p.y >= 0 && p.y < rows_; }
+    size_t index(GridPos p) const { return static_cast<size_t>(p.y * cols_ + p.x); }
+
+    void grow(int cols, int rows) {
+        std::vector<entt::entity> cells(static_cast<size_t>(cols * rows), entt::null);
+        for (int y = 0; y < rows_; ++y) {
+            std::copy_n(cells_.begin() + y * cols_, cols_, cells.begin() + y * cols);
+        }
+        cells_ = std::move(cells);
+        cols_ = cols;
+        rows_ = rows;
+    }
+};
+
+} // namespace ls
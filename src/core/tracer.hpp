@@ -0,0 +1,194 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace ls {
+
+// Records timed spans from any thread and writes them as Chrome trace-event JSON, which
+// chrome://tracing and ui.perfetto.dev open directly. Off until start(); recording is a
+// clock read and a short lock per span.
+class Tracer {
+  public:
+    using Clock = std::chrono::steady_clock;
+    static constexpr size_t MAX_EVENTS = 1'000'000; // about ten minutes of fully traced frames
+
+    struct Event {
+        const char* name;
+        const char* category;
+        std::string detail;
+        Clock::time_point begin;
+        Clock::time_point end;
+        uint32_t tid;
+    };
+
+    bool active() const { return active_.load(std::memory_order_relaxed); }
+
+    // Discards anything recorded before and starts a new capture
+    void start() {
+        std::lock_guard lock(mtx_);
+        events_.clear();
+        dropped_ = 0;
+        epoch_ = Clock::now();
+        active_.store(true, std::memory_order_relaxed);
+    }
+
+    void stop() { active_.store(false, std::memory_order_relaxed); }
+
+    void record(const char* name, const char* category, Clock::time_point begin, Clock::time_point end,
+                std::string detail = {}) {
+        if (!active()) return;
+        uint32_t tid = thread_id();
+        std::lock_guard lock(mtx_);
+        if (events_.size() >= MAX_EVENTS) {
+            ++dropped_;
+            return;
+        }
+        events_.push_back({name, category, std::move(detail), begin, end, tid});
+    }
+
+    // Labels the calling thread in the trace viewer; names persist across captures
+    void name_thread(std::string name) {
+        uint32_t tid = thread_id();
+        std::lock_guard lock(mtx_);
+        for (auto& [id, n] : thread_names_) {
+            if (id == tid) {
+                n = std::move(name);
+                return;
+            }
+        }
+        thread_names_.push_back({tid, std::move(name)});
+    }
+
+    // Small stable ids in first-use order, so the main thread is normally 1
+    static uint32_t thread_id() {
+        static std::atomic<uint32_t> next{1};
+        thread_local uint32_t id = next.fetch_add(1, std::memory_order_relaxed);
+        return id;
+    }
+
+    size_t event_count() const {
+        std::lock_guard lock(mtx_);
+        return events_.size();
+    }
+
+    size_t dropped() const {
+        std::lock_guard lock(mtx_);
+        return dropped_;
+    }
+
+    std::string to_json() const {
+        std::lock_guard lock(mtx_);
+        std::string out;
+        out.reserve(64 + events_.size() * 96);
+        out += "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+        bool first = true;
+        auto sep = [&] {
+            if (!first) out += ",\n";
+            first = false;
+        };
+        for (auto& [tid, name] : thread_names_) {
+            sep();
+            out += "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" + std::to_string(tid) +
+                   ",\"args\":{\"name\":\"";
+            append_escaped(out, name);
+            out += "\"}}";
+        }
+        char num[64];
+        for (auto& e : events_) {
+            sep();
+            out += "{\"name\":\"";
+            append_escaped(out, e.name);
+            out += "\",\"cat\":\"";
+            append_escaped(out, e.category);
+            std::snprintf(num, sizeof(num), "\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f", micros(e.begin - epoch_),
+                          micros(e.end - e.begin));
+            out += num;
+            out += ",\"pid\":1,\"tid\":" + std::to_string(e.tid);
+            if (!e.detail.empty()) {
+                out += ",\"args\":{\"detail\":\"";
+                append_escaped(out, e.detail);
+                out += "\"}";
+            }
+            out += '}';
+        }
+        out += "]}\n";
+        return out;
+    }
+
+  private:
+    mutable std::mutex mtx_;
+    std::vector<Event> events_;
+    std::vector<std::pair<uint32_t, std::string>> thread_names_;
+    size_t dropped_{0};
+    Clock::time_point epoch_{Clock::now()};
+    std::atomic<bool> active_{false};
+
+    static double micros(Clock::duration d) { return std::chrono::duration<double, std::micro>(d).count(); }
+
+    static void append_escaped(std::string& out, std::string_view s) {
+        for (char c : s) {
+            switch (c) {
+            case '"':
+                out += "\\\"";
+                break;
+            case '\\':
+                out += "\\\\";
+                break;
+            case '\n':
+                out += "\\n";
+                break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    char buf[8];
+                    std::snprintf(buf, sizeof(buf), "\\u%04x", static_cast<unsigned>(c));
+                    out += buf;
+                } else {
+                    out += c;
+                }
+            }
+        }
+    }
+};
+
+inline Tracer& tracer() {
+    static Tracer instance;
+    return instance;
+}
+
+// Records one span for the enclosing scope while a capture is running
+class TraceScope {
+  public:
+    TraceScope(const char* name, const char* category) : name_(name), category_(category) {
+        if (tracer().active()) start_ = Tracer::Clock::now();
+    }
+
+    // `make_detail` only runs while tracing, so building the string costs nothing otherwise
+    template <typename MakeDetail>
+    TraceScope(const char* name, const char* category, MakeDetail&& make_detail) : TraceScope(name, category) {
+        if (start_ != Tracer::Clock::time_point{}) detail_ = make_detail();
+    }
+
+    ~TraceScope() {
+        if (start_ != Tracer::Clock::time_point{}) {
+            tracer().record(name_, category_, start_, Tracer::Clock::now(), std::move(detail_));
+        }
+    }
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+  private:
+    const char* name_;
+    const char* category_;
+    Tracer::Clock::time_point start_{};
+    std::string detail_;
+};
+
+} // namespace ls
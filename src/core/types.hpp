@@ -37,7 +37,11 @@ struct GridPos {
 
 enum class TileType : uint8_t { Grass, Path, Blocked, Spawn, Exit, Buildable };
 
-enum class TowerType : uint8_t { Arrow, Cannon, Ice, Lightning, Poison, Laser };
+enum class TowerType : uint8_t { Arrow, Cannon, Ice, Lightning, Poison, Laser, Ballista };
+inline constexpr int TOWER_TYPE_COUNT = static_cast<int>(TowerType::Ballista) + 1; // keep in step with the last type
+
+// Which enemy in range a tower shoots: furthest along the path, least far, most or least current HP, or closest
+enum class TargetMode : uint8_t { First, Last, Strongest, Weakest, Nearest };
 
 enum class EnemyType : uint8_t { Grunt, Runner, Tank, Healer, Flying, Boss };
 
@@ -47,14 +47,14 @@ inline AbilityType get_boss_ability(WaveNum wave) {
     return AbilityType::DamageAura;
 }
 
-inline entt::entity create_enemy(entt::registry& reg, EnemyType type, const std::vector<Vec2>& path, float scaling,
+inline entt::entity create_enemy(entt::registry& reg, EnemyType type, const SharedPath& path, float scaling,
                                  WaveNum wave = 0) {
-    if (path.empty()) return entt::null;
+    if (!path || path->empty()) return entt::null;
 
     auto stats = get_enemy_stats(type, scaling);
     auto e = reg.create();
 
-    reg.emplace<Transform>(e, path[0]);
+    reg.emplace<Transform>(e, path->front());
     reg.emplace<Velocity>(e);
     reg.emplace<Sprite>(e, stats.color, 3, stats.size, stats.size, true);
     reg.emplace<Health>(e, stats.hp, stats.hp, stats.armor);
@@ -27,6 +27,9 @@ inline int tower_max_hp(TowerType type, int level) {
     case TowerType::Laser:
         base = 120;
         break;
+    case TowerType::Ballista:
+        base = 110;
+        break;
     }
     return base + (level - 1) * 30;
 }
@@ -52,7 +55,8 @@ inline entt::entity create_tower(entt::registry& reg, const TowerStats& stats, G
                                 .effect = stats.effect,
                                 .effect_duration = stats.effect_duration,
                                 .aoe_radius = stats.aoe_radius,
-                                .chain_count = stats.chain_count});
+                                .chain_count = stats.chain_count,
+                                .pierce = stats.pierce});
 
     return e;
 }
@@ -1,11 +1,47 @@
 #include "core/game.hpp"
+#include "core/profiler.hpp"
 #include "states/gameover_state.hpp"
 #include "states/map_select_state.hpp"
 #include "states/menu_state.hpp"
 #include "states/paused_state.hpp"
 #include "states/playing_state.hpp"
 #include "states/upgrade_state.hpp"
+#include "systems/systems.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
 #include <raylib.h>
+#include <string>
+#include <string_view>
+#include <vector>
+
+static std::string g_trace_path{"trace.json"}; // --trace <file>; also where F4 captures go
+
+// Ends the running capture and hands the JSON to the save writer thread
+static void write_trace(ls::Game& game) {
+    auto& t = ls::tracer();
+    t.stop();
+    auto json = t.to_json();
+    TraceLog(LOG_INFO, "TRACE: %zu events (%zu dropped) -> %s", t.event_count(), t.dropped(), g_trace_path.c_str());
+    game.save_manager.save_async(g_trace_path, std::vector<uint8_t>(json.begin(), json.end()));
+}
+
+// Profiling builds only: F3 toggles the per-system timing overlay, F4 starts a trace capture
+// or ends the running one and writes it out
+static void debug_tools([[maybe_unused]] ls::Game& game) {
+#if LASTSTAND_PROFILE
+    if (IsKeyPressed(KEY_F3)) ls::profiler().toggle_overlay();
+    if (IsKeyPressed(KEY_F4)) {
+        if (ls::tracer().active()) {
+            write_trace(game);
+        } else {
+            ls::tracer().start();
+            TraceLog(LOG_INFO, "TRACE: capture started (F4 to write %s)", g_trace_path.c_str());
+        }
+    }
+    if (ls::profiler().overlay_visible()) ls::systems::profiler_overlay(game);
+#endif
+}
 
 #ifdef __EMSCRIPTEN__
 #include <emscripten/emscripten.h>
@@ -13,23 +49,106 @@
 static ls::Game* g_game = nullptr;
 
 static void main_loop() {
+    double frame_start = GetTime();
     float dt = GetFrameTime();
-    g_game->state_machine.update(*g_game, dt);
+    {
+        TRACE_SCOPE("update", "frame");
+        g_game->state_machine.update(*g_game, dt);
+    }
 
+    TRACE_SCOPE("render", "frame");
     BeginDrawing();
+    g_game->renderer->begin_frame();
     g_game->state_machine.render(*g_game);
+    debug_tools(*g_game);
     DrawFPS(ls::SCREEN_WIDTH - 80, ls::SCREEN_HEIGHT - 20);
+    g_game->record_frame_time(static_cast<float>((GetTime() - frame_start) * 1000.0));
     EndDrawing();
+    g_game->renderer->end_frame();
+    ls::profiler().end_frame();
+    g_game->churn.end_frame(g_game->registry);
+}
+#endif
+
+struct LaunchOptions {
+    std::string record_path; // --record <file>: write an input replay of the next new match
+    std::string replay_path; // --replay <file>: play a replay at uncapped speed, then exit
+    bool render{true};       // --no-render: simulate only (replay playback)
+    bool stress{false};      // --stress: run the stress test, log the capacity score, then exit
+    int soak{0};             // --soak <matches>: play bot matches back to back and check memory stays flat
+    bool trace{false};       // --trace [file]: capture a Chrome trace from launch, written on exit
+};
+
+static LaunchOptions parse_args(int argc, char** argv) {
+    LaunchOptions opts;
+    for (int i = 1; i < argc; ++i) {
+        std::string_view arg = argv[i];
+        if (arg == "--record" && i + 1 < argc) {
+            opts.record_path = argv[++i];
+        } else if (arg == "--replay" && i + 1 < argc) {
+            opts.replay_path = argv[++i];
+        } else if (arg == "--trace") {
+            opts.trace = true;
+            if (i + 1 < argc && argv[i + 1][0] != '-') g_trace_path = argv[++i];
+        } else if (arg == "--stress") {
+            opts.stress = true;
+        } else if (arg == "--soak" && i + 1 < argc) {
+            opts.soak = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--no-render") {
+            opts.render = false;
+        } else {
+            TraceLog(LOG_WARNING, "Unknown argument: %s", argv[i]);
+        }
+    }
+    if (opts.replay_path.empty() && opts.soak == 0) opts.render = true;
+    return opts;
+}
+
+static bool start_replay(ls::Game& game, const std::string& path) {
+    auto bytes = game.save_manager.read_bytes(path);
+    if (!bytes) {
+        TraceLog(LOG_ERROR, "REPLAY: %s", bytes.error().c_str());
+        return false;
+    }
+    ls::ReplayPlayer player;
+    if (auto loaded = player.load(std::move(*bytes)); !loaded) {
+        TraceLog(LOG_ERROR, "REPLAY: %s", loaded.error().c_str());
+        return false;
+    }
+    auto map = game.map_manager.load_by_name(player.header().map_name);
+    if (!map) {
+        TraceLog(LOG_ERROR, "REPLAY: %s", map.error().c_str());
+        return false;
+    }
+    game.current_map = std::move(*map);
+    game.difficulty = player.header().difficulty;
+    game.upgrades = player.header().upgrades;
+    game.replay = std::move(player);
+    game.state_machine.change_state(ls::GameStateId::Playing, game);
+    return true;
 }
+
+int main(int argc, char** argv) {
+    auto opts = parse_args(argc, argv);
+    TRACE_THREAD_NAME("main");
+    if (opts.trace) {
+#if LASTSTAND_PROFILE
+        ls::tracer().start();
+#else
+        TraceLog(LOG_WARNING, "TRACE: this build has no instrumentation (configure with -DLASTSTAND_PROFILE=ON)");
 #endif
+    }
+    bool replaying = !opts.replay_path.empty();
 
-int main() {
+    if (!opts.render) SetConfigFlags(FLAG_WINDOW_HIDDEN);
     InitWindow(ls::SCREEN_WIDTH, ls::SCREEN_HEIGHT, "Last Stand - Tower Defense");
-    SetTargetFPS(ls::TARGET_FPS);
+    SetTargetFPS(replaying || opts.soak > 0 ? 0 : ls::TARGET_FPS);
     InitAudioDevice();
 
     ls::Game game;
     ls::load_assets(game);
+    // Churn counters feed the F3 overlay in profiling builds and the report after headless runs
+    if (LASTSTAND_PROFILE || !opts.render) game.churn.attach(game.registry);
 
     // Register all states
     game.state_machine.register_state<ls::MenuState>();
@@ -41,26 +160,106 @@ int main() {
     game.state_machine.register_state<ls::UpgradeState>();
 
     game.upgrades = game.save_manager.load_upgrades("upgrades.json");
-    game.state_machine.change_state(ls::GameStateId::Menu, game);
+    if (!opts.record_path.empty()) game.recorder.emplace(opts.record_path);
+    if (replaying) {
+        if (!start_replay(game, opts.replay_path)) game.running = false;
+    } else if (opts.soak > 0) {
+        // Autosaves still run, but into their own file
+        game.snapshot_path = "soak.bin";
+        game.soak.emplace(opts.soak);
+        if (auto started = game.start_soak_match(); !started) {
+            TraceLog(LOG_ERROR, "SOAK: %s", started.error().c_str());
+            game.running = false;
+        }
+    } else if (opts.stress) {
+        if (auto started = game.start_stress_test(); !started) {
+            TraceLog(LOG_ERROR, "STRESS: %s", started.error().c_str());
+            game.running = false;
+        }
+    } else {
+        game.state_machine.change_state(ls::GameStateId::Menu, game);
+    }
 
 #ifdef __EMSCRIPTEN__
     g_game = &game;
     emscripten_set_main_loop(main_loop, 0, 1);
+    return 0;
 #else
+    double run_start = GetTime();
+    double worst_frame = 0.0;
     while (!WindowShouldClose() && game.running) {
-        float dt = GetFrameTime();
-        game.state_machine.update(game, dt);
+        double frame_start = GetTime();
+        float dt = game.soak ? ls::SoakTest::TICK : GetFrameTime();
+        {
+            TRACE_SCOPE("update", "frame");
+            game.state_machine.update(game, dt);
+        }
 
-        BeginDrawing();
-        game.state_machine.render(game);
-        DrawFPS(ls::SCREEN_WIDTH - 80, ls::SCREEN_HEIGHT - 20);
-        EndDrawing();
+        if (opts.render) {
+            TRACE_SCOPE("render", "frame");
+            BeginDrawing();
+            game.renderer->begin_frame();
+            game.state_machine.render(game);
+            debug_tools(game);
+            DrawFPS(ls::SCREEN_WIDTH - 80, ls::SCREEN_HEIGHT - 20);
+            game.record_frame_time(static_cast<float>((GetTime() - frame_start) * 1000.0));
+            EndDrawing();
+            game.renderer->end_frame();
+        } else {
+            game.record_frame_time(static_cast<float>((GetTime() - frame_start) * 1000.0));
+            PollInputEvents();
+        }
+        ls::profiler().end_frame();
+        game.churn.end_frame(game.registry);
+
+        if (game.replay) {
+            worst_frame = std::max(worst_frame, GetTime() - frame_start);
+            // Game over / victory ends playback
+            if (game.state_machine.current_id() != ls::GameStateId::Playing) game.running = false;
+        }
+        if (opts.stress && game.stress && game.stress->finished()) game.running = false;
+        // A soak match ends on the game over or victory screen; sample there and start the next one
+        if (game.soak && game.state_machine.current_id() != ls::GameStateId::Playing) {
+            game.record_soak_match();
+            auto& last = game.soak->samples().back();
+            TraceLog(LOG_INFO, "SOAK: match %d/%d on %s ended at wave %u - RSS %zu KB, %zu entities, pool capacity %zu",
+                     game.soak->played(), game.soak->matches(), last.map.c_str(), last.wave, last.rss_kb,
+                     last.entities, last.pool_capacity);
+            if (game.soak->finished()) {
+                game.running = false;
+            } else if (auto started = game.start_soak_match(); !started) {
+                TraceLog(LOG_ERROR, "SOAK: %s", started.error().c_str());
+                game.running = false;
+            }
+        }
     }
 
+    if (game.replay && game.replay->ticks() > 0) {
+        double elapsed = GetTime() - run_start;
+        auto ticks = game.replay->ticks();
+        TraceLog(LOG_INFO, "REPLAY: %zu ticks in %.3f s (avg %.3f ms, worst %.3f ms) - wave %u, lives %d, gold %d",
+                 ticks, elapsed, elapsed * 1000.0 / static_cast<double>(ticks), worst_frame * 1000.0,
+                 game.play.current_wave, game.play.lives, game.play.gold);
+    }
+    if (!opts.render) std::printf("%s", game.churn.report().c_str());
+    int exit_code = 0;
+    if (game.soak) {
+        std::printf("%s", game.soak->report().c_str());
+        if (auto ok = game.soak->check(); !ok) {
+            std::printf("SOAK FAILED\n%s", ok.error().c_str());
+            exit_code = 1;
+        } else if (game.soak->finished()) {
+            std::printf("SOAK PASSED\n");
+        }
+    }
+
+    game.finish_recording();
+    if (ls::tracer().active()) write_trace(game);
     if (game.current_music) StopMusicStream(*game.current_music);
+    ls::systems::unload_tile_layer(game);
     game.sounds.cleanup();
     CloseAudioDevice();
     CloseWindow();
+    return exit_code;
 #endif
-    return 0;
 }
@@ -1,5 +1,7 @@
 #pragma once
+#include "core/profiler.hpp"
 #include <expected>
+#include <optional>
 #include <raylib.h>
 #include <string>
 #include <unordered_map>
@@ -16,6 +18,7 @@ class AssetManager {
     }
 
     std::expected<Texture2D, std::string> load_texture(const std::string& name, const std::string& path) {
+        TRACE_SCOPE_DETAIL("load_texture", "asset", path);
         if (auto it = textures_.find(name); it != textures_.end()) return it->second;
         if (!FileExists(path.c_str())) return std::unexpected("Texture not found: " + path);
         auto tex = LoadTexture(path.c_str());
@@ -24,6 +27,7 @@ class AssetManager {
     }
 
     std::expected<Sound, std::string> load_sound(const std::string& name, const std::string& path) {
+        TRACE_SCOPE_DETAIL("load_sound", "asset", path);
         if (auto it = sounds_.find(name); it != sounds_.end()) return it->second;
         if (!FileExists(path.c_str())) return std::unexpected("Sound not found: " + path);
         auto snd = LoadSound(path.c_str());
@@ -32,6 +36,7 @@ class AssetManager {
     }
 
     std::expected<Font, std::string> load_font(const std::string& name, const std::string& path) {
+        TRACE_SCOPE_DETAIL("load_font", "asset", path);
         if (auto it = fonts_.find(name); it != fonts_.end()) return it->second;
         if (!FileExists(path.c_str())) return std::unexpected("Font not found: " + path);
         auto fnt = LoadFont(path.c_str());
@@ -40,6 +45,7 @@ class AssetManager {
     }
 
     std::expected<Music, std::string> load_music(const std::string& name, const std::string& path) {
+        TRACE_SCOPE_DETAIL("load_music", "asset", path);
         if (auto it = music_.find(name); it != music_.end()) return it->second;
         if (!FileExists(path.c_str())) return std::unexpected("Music not found: " + path);
         auto mus = LoadMusicStream(path.c_str());
@@ -47,6 +53,16 @@ class AssetManager {
         return mus;
     }
 
+    // Files a texture created elsewhere under `name`; the manager unloads it with the rest
+    void add_texture(const std::string& name, Texture2D tex) { textures_[name] = tex; }
+
+    // Takes a texture back out without unloading it, for textures that were never uploaded
+    std::optional<Texture2D> release_texture(const std::string& name) {
+        auto node = textures_.extract(name);
+        if (node.empty()) return std::nullopt;
+        return node.mapped();
+    }
+
     Texture2D* get_texture(const std::string& name) {
         auto it = textures_.find(name);
         return it != textures_.end() ? &it->second : nullptr;
@@ -67,6 +83,8 @@ class AssetManager {
         return it != music_.end() ? &it->second : nullptr;
     }
 
+    size_t loaded_count() const { return textures_.size() + sounds_.size() + fonts_.size() + music_.size(); }
+
   private:
     std::unordered_map<std::string, Texture2D> textures_;
     std::unordered_map<std::string, Sound> sounds_;
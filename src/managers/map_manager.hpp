@@ -1,7 +1,10 @@
 #pragma once
 #include "core/biome_theme.hpp"
 #include "core/constants.hpp"
+#include "core/profiler.hpp"
+#include "core/random.hpp"
 #include "core/types.hpp"
+#include <cctype>
 #include <expected>
 #include <fstream>
 #include <nlohmann/json.hpp>
@@ -47,12 +50,15 @@ struct MapData {
         return t == TileType::Buildable;
     }
 
-    void generate_decorations() {
+    // Seed based on map name for consistent results
+    uint64_t decoration_seed() const {
+        uint64_t seed = 0;
+        for (auto c : name) seed = seed * 31 + static_cast<unsigned char>(c);
+        return seed;
+    }
+
+    void generate_decorations(Pcg32& rng) {
         decorations.clear();
-        // Seed based on map name for consistent results
-        unsigned seed = 0;
-        for (auto c : name) seed = seed * 31 + static_cast<unsigned>(c);
-        std::srand(seed);
 
         auto is_path_adjacent = [&](int x, int y) -> bool {
             for (int dy = -1; dy <= 1; ++dy) {
@@ -82,10 +88,10 @@ struct MapData {
             for (int x = 0; x < cols; ++x) {
                 if (tile_at({x, y}) != TileType::Grass) continue;
                 if (is_path_adjacent(x, y)) continue;
-                if ((std::rand() % 100) >= theme.deco_density) continue;
+                if (rng.range(0, 99) >= theme.deco_density) continue;
                 if (total_weight <= 0) continue;
                 // Weighted random decoration selection
-                int r = std::rand() % total_weight;
+                int r = rng.range(0, total_weight - 1);
                 int tex_idx = 0;
                 for (int i = 0; i < 8; ++i) {
                     if (r < cumulative[i]) {
@@ -102,6 +108,7 @@ struct MapData {
 class MapManager {
   public:
     std::expected<MapData, std::string> load(const std::string& path) {
+        TRACE_SCOPE_DETAIL("load_map", "asset", path);
         std::ifstream file(path);
         if (!file.is_open()) return std::unexpected("Cannot open map: " + path);
 
@@ -114,6 +121,15 @@ class MapManager {
         }
     }
 
+    // Resolve a map's display name (as stored in saves and replays) to its file
+    std::expected<MapData, std::string> load_by_name(const std::string& name) {
+        std::string lower_name = name;
+        for (auto& ch : lower_name) ch = static_cast<char>(std::tolower(ch));
+        auto result = load("assets/maps/" + lower_name + ".json");
+        if (!result) result = load("assets/maps/" + name + ".json");
+        return result;
+    }
+
     const std::vector<std::string>& available_maps() const { return map_names_; }
 
     void set_available_maps(std::vector<std::string> names) { map_names_ = std::move(names); }
@@ -2,11 +2,17 @@
 #include "components/components.hpp"
 #include "core/hero_upgrades.hpp"
 #include "core/types.hpp"
+#include "managers/save_writer.hpp"
+#include <cstring>
 #include <entt/entt.hpp>
 #include <expected>
 #include <fstream>
+#include <iterator>
 #include <nlohmann/json.hpp>
+#include <span>
 #include <string>
+#include <type_traits>
+#include <vector>
 
 namespace ls {
 
@@ -74,21 +80,36 @@ class SaveManager {
             return std::unexpected(std::string("Save parse error: ") + e.what());
         }
     }
-    std::expected<void, std::string> save_upgrades(const HeroUpgrades& u, const std::string& path) {
-        nlohmann::json j;
-        j["xp"] = u.upgrade_xp;
-        j["range"] = u.attack_range_level;
-        j["magnet"] = u.magnet_level;
-        j["damage"] = u.attack_damage_level;
-        j["speed"] = u.attack_speed_level;
-        j["hp"] = u.max_hp_level;
-        std::ofstream file(path);
-        if (!file.is_open()) return std::unexpected("Cannot write upgrades file: " + path);
-        file << j.dump(2);
-        return {};
+
+    // Serialized bytes go to the background writer, which applies `finish` if given; the file is replaced
+    // atomically
+    void save_async(const std::string& path, std::vector<uint8_t> data, SaveWriter::Finish finish = nullptr) {
+        writer_.submit(path, std::move(data), finish);
+    }
+
+    // Serialized bytes added to the end of the file by the background writer
+    void append_async(const std::string& path, std::vector<uint8_t> data) { writer_.append(path, std::move(data)); }
+
+    std::expected<std::vector<uint8_t>, std::string> read_bytes(const std::string& path) {
+        writer_.flush();
+        std::ifstream file(path, std::ios::binary);
+        if (!file.is_open()) return std::unexpected("Cannot open save file: " + path);
+        return std::vector<uint8_t>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+
+    // Errors reported by background writes since the last call
+    std::optional<std::string> take_write_error() { return writer_.take_error(); }
+
+    // Hands the writer a raw copy of the upgrades; the JSON is built and written on its thread, and a
+    // failure surfaces through take_write_error()
+    void save_upgrades(const HeroUpgrades& u, const std::string& path) {
+        std::vector<uint8_t> raw(sizeof(HeroUpgrades));
+        std::memcpy(raw.data(), &u, sizeof(HeroUpgrades));
+        save_async(path, std::move(raw), upgrades_json);
     }
 
     HeroUpgrades load_upgrades(const std::string& path) {
+        writer_.flush();
         std::ifstream file(path);
         if (!file.is_open()) return {};
         try {
@@ -106,6 +127,25 @@ class SaveManager {
             return {};
         }
     }
+
+  private:
+    SaveWriter writer_;
+
+    static_assert(std::is_trivially_copyable_v<HeroUpgrades>);
+
+    static std::vector<uint8_t> upgrades_json(std::vector<uint8_t> raw) {
+        HeroUpgrades u;
+        std::memcpy(&u, raw.data(), sizeof(HeroUpgrades));
+        nlohmann::json j;
+        j["xp"] = u.upgrade_xp;
+        j["range"] = u.attack_range_level;
+        j["magnet"] = u.magnet_level;
+        j["damage"] = u.attack_damage_level;
+        j["speed"] = u.attack_speed_level;
+        j["hp"] = u.max_hp_level;
+        std::string text = j.dump(2);
+        return {text.begin(), text.end()};
+    }
 };
 
 } // namespace ls
@@ -0,0 +1,164 @@
+#pragma once
+#include "core/profiler.hpp"
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <expected>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace ls {
+
+// Write `data` to `path + ".tmp"`, then rename over `path` so readers never see a partial file
+inline std::expected<void, std::string> write_file_atomic(const std::string& path, std::span<const uint8_t> data) {
+    TRACE_SCOPE_DETAIL("write_file", "save", path);
+    std::string tmp = path + ".tmp";
+    {
+        std::ofstream file(tmp, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) return std::unexpected("Cannot write save file: " + tmp);
+        file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+        file.flush();
+        if (!file) return std::unexpected("Failed writing save file: " + tmp);
+    }
+    std::error_code ec;
+    std::filesystem::rename(tmp, path, ec);
+    if (ec) {
+        std::filesystem::remove(tmp, ec);
+        return std::unexpected("Cannot replace save file: " + path);
+    }
+    return {};
+}
+
+// Add `data` to the end of `path`, creating it if needed. A crash mid-write leaves a partial tail,
+// which formats written this way (replays) frame and checksum so readers can stop before it.
+inline std::expected<void, std::string> append_file(const std::string& path, std::span<const uint8_t> data) {
+    TRACE_SCOPE_DETAIL("append_file", "save", path);
+    std::ofstream file(path, std::ios::binary | std::ios::app);
+    if (!file.is_open()) return std::unexpected("Cannot write file: " + path);
+    file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+    file.flush();
+    if (!file) return std::unexpected("Failed appending to file: " + path);
+    return {};
+}
+
+// Writes files on a worker thread. The caller hands over bytes, so submit() and append() cost a move
+// and a lock; a submit can also name a finish step (checksumming, framing) that runs on the worker.
+// Jobs for one path run in order; a newer submit for a path still in the queue replaces the bytes of
+// its last job there, and an append is added to that job's bytes unless it has a finish step.
+// Web builds have no worker threads and write synchronously.
+class SaveWriter {
+  public:
+    SaveWriter() = default;
+    SaveWriter(const SaveWriter&) = delete;
+    SaveWriter& operator=(const SaveWriter&) = delete;
+    ~SaveWriter() { stop(); }
+
+    // Turns submitted bytes into the file contents on the worker thread
+    using Finish = std::vector<uint8_t> (*)(std::vector<uint8_t>);
+
+    // Replaces the file at `path` with `data`, or with finish(data) when given
+    void submit(std::string path, std::vector<uint8_t> data, Finish finish = nullptr) {
+        enqueue(std::move(path), std::move(data), false, finish);
+    }
+
+    // Adds `data` to the end of the file at `path`, after any write to it still queued
+    void append(std::string path, std::vector<uint8_t> data) {
+        enqueue(std::move(path), std::move(data), true, nullptr);
+    }
+
+    // Block until every submitted write has reached disk
+    void flush() {
+        std::unique_lock lock(mtx_);
+        idle_cv_.wait(lock, [this] { return queue_.empty() && !busy_; });
+    }
+
+    // Drain pending writes and join the worker
+    void stop() {
+        {
+            std::lock_guard lock(mtx_);
+            stopping_ = true;
+        }
+        cv_.notify_one();
+        if (thread_.joinable()) thread_.join();
+        stopping_ = false;
+    }
+
+    std::optional<std::string> take_error() {
+        std::lock_guard lock(mtx_);
+        auto err = std::move(last_error_);
+        last_error_ = std::nullopt;
+        return err;
+    }
+
+  private:
+    struct Job {
+        std::string path;
+        std::vector<uint8_t> data;
+        bool append{false};
+        Finish finish{nullptr};
+    };
+
+    static std::expected<void, std::string> run_job(Job& job) {
+        if (job.finish) job.data = job.finish(std::move(job.data));
+        return job.append ? append_file(job.path, job.data) : write_file_atomic(job.path, job.data);
+    }
+
+    void enqueue(std::string path, std::vector<uint8_t> data, bool append, Finish finish) {
+#ifdef __EMSCRIPTEN__
+        Job job{std::move(path), std::move(data), append, finish};
+        auto result = run_job(job);
+        if (!result) last_error_ = result.error();
+#else
+        std::lock_guard lock(mtx_);
+        for (auto it = queue_.rbegin(); it != queue_.rend(); ++it) {
+            if (it->path != path) continue;
+            if (!append) {
+                *it = {std::move(path), std::move(data), false, finish};
+                return;
+            }
+            if (it->finish) break; // its bytes aren't the file's yet; append after it
+            it->data.insert(it->data.end(), data.begin(), data.end());
+            return;
+        }
+        queue_.push_back({std::move(path), std::move(data), append, finish});
+        if (!thread_.joinable()) thread_ = std::thread([this] { run(); });
+        cv_.notify_one();
+#endif
+    }
+
+    void run() {
+        TRACE_THREAD_NAME("save_writer");
+        std::unique_lock lock(mtx_);
+        while (true) {
+            cv_.wait(lock, [this] { return stopping_ || !queue_.empty(); });
+            if (queue_.empty()) break; // stopping with nothing left to write
+            Job job = std::move(queue_.front());
+            queue_.pop_front();
+            busy_ = true;
+            lock.unlock();
+            auto result = run_job(job);
+            lock.lock();
+            busy_ = false;
+            if (!result) last_error_ = result.error();
+            if (queue_.empty()) idle_cv_.notify_all();
+        }
+        idle_cv_.notify_all();
+    }
+
+    std::mutex mtx_;
+    std::condition_variable cv_;
+    std::condition_variable idle_cv_;
+    std::deque<Job> queue_;
+    std::thread thread_;
+    bool busy_{false};
+    bool stopping_{false};
+    std::optional<std::string> last_error_;
+};
+
+} // namespace ls
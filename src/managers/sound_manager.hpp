@@ -1,4 +1,5 @@
 #pragma once
+#include "core/random.hpp"
 #include <cmath>
 #include <cstring>
 #include <raylib.h>
@@ -73,6 +74,8 @@ class SoundManager {
   private:
     static constexpr int SAMPLE_RATE = 44100;
 
+    Pcg32 noise_{0x5EED, rng_stream::AUDIO}; // synthesis only, independent of match streams
+
     enum WaveType { WaveSine, WaveTriangle };
 
     static float wave_sample(WaveType type, float phase) {
@@ -134,7 +137,7 @@ class SoundManager {
         std::vector<float> samples(count);
         for (int i = 0; i < count; ++i) {
             float t = static_cast<float>(i) / count;
-            float noise = (static_cast<float>(GetRandomValue(-1000, 1000)) / 1000.0f);
+            float noise = noise_.range(-1.0f, 1.0f);
             samples[i] = noise * (1.0f - t) * 0.3f;
         }
         return make_sound(samples);
@@ -145,7 +148,7 @@ class SoundManager {
         std::vector<float> samples(count);
         for (int i = 0; i < count; ++i) {
             float t = static_cast<float>(i) / count;
-            float noise = (static_cast<float>(GetRandomValue(-1000, 1000)) / 1000.0f);
+            float noise = noise_.range(-1.0f, 1.0f);
             float envelope = std::exp(-t * 8.0f);
             samples[i] = noise * envelope * 0.4f;
         }
@@ -157,7 +160,7 @@ class SoundManager {
         std::vector<float> samples(count);
         for (int i = 0; i < count; ++i) {
             float t = static_cast<float>(i) / count;
-            float noise = (static_cast<float>(GetRandomValue(-1000, 1000)) / 1000.0f);
+            float noise = noise_.range(-1.0f, 1.0f);
             float sine = std::sin(2.0f * PI * 120.0f * i / SAMPLE_RATE);
             float envelope = std::exp(-t * 6.0f);
             samples[i] = (noise * 0.4f + sine * 0.6f) * envelope * 0.5f;
@@ -184,7 +187,7 @@ class SoundManager {
         for (int i = 0; i < count; ++i) {
             float t = static_cast<float>(i) / count;
             float sine = std::sin(2.0f * PI * 80.0f * i / SAMPLE_RATE);
-            float noise = (static_cast<float>(GetRandomValue(-1000, 1000)) / 1000.0f);
+            float noise = noise_.range(-1.0f, 1.0f);
             float envelope = (1.0f - t) * (1.0f - t);
             samples[i] = (sine * 0.5f + noise * 0.5f) * envelope * 0.6f;
         }
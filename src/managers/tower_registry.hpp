@@ -20,6 +20,7 @@ struct TowerStats {
     float slow_factor;
     Color color;
     std::string name;
+    int pierce{}; // enemies a bolt passes through after the first (Ballista)
 };
 
 class TowerRegistry {
@@ -80,6 +81,12 @@ class TowerRegistry {
         add({TowerType::Laser, 1, 150, 8,  160, 0.05f, 0, 0, EffectType::Burn, 1.0f, 1.0f, {255, 50, 50, 255}, "Laser"});
         add({TowerType::Laser, 2, 225, 12, 180, 0.05f, 0, 0, EffectType::Burn, 1.5f, 1.0f, {255, 80, 80, 255}, "Laser II"});
         add({TowerType::Laser, 3, 375, 18, 200, 0.05f, 0, 0, EffectType::Burn, 2.0f, 1.0f, {255, 110, 110, 255}, "Laser III"});
+
+        // Ballista - slow straight bolts that pierce every enemy in a line
+        // L1: 15 DPS x3 enemies, L2: 25 DPS x4, L3: 39 DPS x5
+        add({TowerType::Ballista, 1, 100, 30, 180, 0.5f,  0, 0, EffectType::None, 0, 1.0f, {150, 110, 70, 255}, "Ballista", 2});
+        add({TowerType::Ballista, 2, 150, 45, 200, 0.55f, 0, 0, EffectType::None, 0, 1.0f, {170, 125, 80, 255}, "Ballista II", 3});
+        add({TowerType::Ballista, 3, 250, 65, 220, 0.6f,  0, 0, EffectType::None, 0, 1.0f, {190, 140, 90, 255}, "Ballista III", 4});
         // clang-format on
     }
 
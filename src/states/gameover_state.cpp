@@ -1,21 +1,26 @@
 #include "gameover_state.hpp"
 #include "core/asset_paths.hpp"
 #include "core/game.hpp"
+#include <cctype>
+#include <ctime>
+#include <filesystem>
 #include <format>
 
 namespace ls {
 
 void GameOverState::enter(Game& game) {
+    perf_csv_.clear();
     xp_earned_ = game.play.current_wave * 10;
     game.upgrades.upgrade_xp += xp_earned_;
-    game.save_manager.save_upgrades(game.upgrades, "upgrades.json");
+    if (!game.replay && !game.soak) game.save_manager.save_upgrades(game.upgrades, "upgrades.json");
     game.state_machine.set_active_game(false);
 }
 
 void VictoryState::enter(Game& game) {
+    perf_csv_.clear();
     xp_earned_ = 500 + game.play.current_wave * 10;
     game.upgrades.upgrade_xp += xp_earned_;
-    game.save_manager.save_upgrades(game.upgrades, "upgrades.json");
+    if (!game.replay && !game.soak) game.save_manager.save_upgrades(game.upgrades, "upgrades.json");
     game.state_machine.set_active_game(false);
 }
 
@@ -67,8 +72,72 @@ static void render_stats(Game& game, int base_y) {
     go_text(a, std::format("Hero Deaths: {}", st.hero_deaths).c_str(), x, y, 16, LIGHTGRAY);
 }
 
+// Per-wave frame times and entity peaks; the five waves with the worst p99 are listed
+static void render_perf(Game& game, int base_y, const std::string& csv_path) {
+    auto& perf = game.play.perf;
+    auto& a = game.assets;
+    float x = SCREEN_WIDTH / 2.0f + 190;
+    float y = static_cast<float>(base_y);
+    int spacing = 22;
+
+    DrawRectangle(static_cast<int>(x - 10), base_y - 10, 400, 24 * 9 + 20, {20, 20, 30, 200});
+    DrawRectangleLinesEx({x - 10, static_cast<float>(base_y - 10), 400, static_cast<float>(24 * 9 + 20)}, 1, GRAY);
+
+    go_text(a, "--- PERFORMANCE ---", x + 100, y, 18, GOLD);
+    y += spacing + 6;
+    if (perf.empty()) {
+        go_text(a, "No frames recorded", x, y, 16, GRAY);
+        return;
+    }
+
+    auto all = perf.overall();
+    go_text(a,
+            std::format("Frame CPU  p50 {:.1f}  p95 {:.1f}  p99 {:.1f}  max {:.1f} ms", all.percentile(0.50f),
+                        all.percentile(0.95f), all.percentile(0.99f), all.max_ms())
+                .c_str(),
+            x, y, 14, WHITE);
+    y += spacing;
+    auto peak = perf.peak();
+    go_text(a, std::format("Peak entities {}  ({} enemies, {} projectiles)", peak.total, peak.enemies, peak.projectiles)
+                   .c_str(),
+            x, y, 14, LIGHTGRAY);
+    y += spacing + 4;
+
+    go_text(a, "Worst waves", x, y, 14, GRAY);
+    y += spacing;
+    for (auto* w : perf.worst_waves(5)) {
+        auto color = w->frames.percentile(0.99f) > 16.6f ? Color{255, 120, 100, 255} : LIGHTGRAY;
+        go_text(a,
+                std::format("Wave {:<3} p99 {:>5.1f}  max {:>5.1f} ms  peak {}", w->wave, w->frames.percentile(0.99f),
+                            w->frames.max_ms(), w->peak.total)
+                    .c_str(),
+                x, y, 14, color);
+        y += spacing;
+    }
+
+    y = static_cast<float>(base_y + 24 * 9 - 8);
+    if (csv_path.empty()) {
+        go_text(a, "Press C to export per-wave CSV", x, y, 14, GRAY);
+    } else {
+        go_text(a, std::format("Saved {}", csv_path).c_str(), x, y, 14, GREEN);
+    }
+}
+
+// Writes the per-wave table next to the save file, one file per match
+static std::string export_perf_csv(Game& game) {
+    static constexpr const char* diff_names[] = {"Easy", "Normal", "Hard"};
+    std::string map = game.current_map.name;
+    for (auto& ch : map) ch = std::isalnum(static_cast<unsigned char>(ch)) ? static_cast<char>(std::tolower(ch)) : '_';
+    auto file = std::format("perf_{}_{}.csv", map, static_cast<long long>(std::time(nullptr)));
+    auto path = (std::filesystem::path(game.snapshot_path).parent_path() / file).string();
+    auto csv = game.play.perf.to_csv(game.current_map.name, diff_names[static_cast<int>(game.difficulty)]);
+    game.save_manager.save_async(path, std::vector<uint8_t>(csv.begin(), csv.end()));
+    return path;
+}
+
 void GameOverState::update(Game& game, [[maybe_unused]] float dt) {
     if (game.current_music) UpdateMusicStream(*game.current_music);
+    if (IsKeyPressed(KEY_C) && perf_csv_.empty() && !game.play.perf.empty()) perf_csv_ = export_perf_csv(game);
     if (IsKeyPressed(KEY_ENTER) || IsKeyPressed(KEY_SPACE)) {
         if (game.current_music) {
             StopMusicStream(*game.current_music);
@@ -93,6 +162,7 @@ void GameOverState::render(Game& game) {
             {100, 200, 255, 255});
 
     render_stats(game, 260);
+    render_perf(game, 260, perf_csv_);
 
     auto hint = "Press ENTER to return to menu";
     float hw = go_measure(a, hint, 18);
@@ -101,6 +171,7 @@ void GameOverState::render(Game& game) {
 
 void VictoryState::update(Game& game, [[maybe_unused]] float dt) {
     if (game.current_music) UpdateMusicStream(*game.current_music);
+    if (IsKeyPressed(KEY_C) && perf_csv_.empty() && !game.play.perf.empty()) perf_csv_ = export_perf_csv(game);
     if (IsKeyPressed(KEY_ENTER) || IsKeyPressed(KEY_SPACE)) {
         if (game.current_music) {
             StopMusicStream(*game.current_music);
@@ -124,6 +195,7 @@ void VictoryState::render(Game& game) {
             {100, 200, 255, 255});
 
     render_stats(game, 260);
+    render_perf(game, 260, perf_csv_);
 
     auto hint = "Press ENTER to return to menu";
     float hw = go_measure(a, hint, 18);
@@ -1,5 +1,6 @@
 #pragma once
 #include "core/state_machine.hpp"
+#include <string>
 
 namespace ls {
 
@@ -13,6 +14,7 @@ class GameOverState : public IGameState {
 
   private:
     int xp_earned_{0};
+    std::string perf_csv_; // where C exported the performance table, if it did
 };
 
 class VictoryState : public IGameState {
@@ -25,6 +27,7 @@ class VictoryState : public IGameState {
 
   private:
     int xp_earned_{0};
+    std::string perf_csv_; // where C exported the performance table, if it did
 };
 
 } // namespace ls
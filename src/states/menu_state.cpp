@@ -1,6 +1,7 @@
 #include "menu_state.hpp"
 #include "core/asset_paths.hpp"
 #include "core/game.hpp"
+#include "core/game_snapshot.hpp"
 #include <cmath>
 #include <format>
 
@@ -24,6 +25,13 @@ static float menu_measure(AssetManager& a, const char* text, float size) {
 }
 
 void MenuState::enter(Game& game) {
+    // Leaving a stress run abandons it; it cannot be resumed
+    if (game.stress) {
+        game.stress.reset();
+        game.state_machine.set_active_game(false);
+        SetTargetFPS(TARGET_FPS);
+    }
+
     // Build menu items based on whether there's an active game
     items_.clear();
     if (game.state_machine.has_active_game()) {
@@ -31,6 +39,7 @@ void MenuState::enter(Game& game) {
     }
     items_.push_back({"New Game", MenuItem::NewGame});
     items_.push_back({"Load Game", MenuItem::LoadGame});
+    items_.push_back({"Stress Test", MenuItem::StressTest});
     items_.push_back({"Upgrades", MenuItem::Upgrades});
     items_.push_back({"Quit", MenuItem::Quit});
     selected_ = 0;
@@ -95,16 +104,20 @@ void MenuState::update(Game& game, float dt) {
             game.state_machine.change_state(GameStateId::MapSelect, game);
             break;
         case MenuItem::LoadGame: {
-            auto result = game.save_manager.load(game.save_path);
-            if (result) {
-                game.pending_load = std::move(*result);
-                std::string name = game.pending_load->map_name;
-                std::string lower_name = name;
-                for (auto& ch : lower_name) ch = static_cast<char>(std::tolower(ch));
-                auto map_result = game.map_manager.load("assets/maps/" + lower_name + ".json");
-                if (!map_result) {
-                    map_result = game.map_manager.load("assets/maps/" + name + ".json");
+            // Prefer the binary snapshot; fall back to a legacy JSON save
+            std::expected<std::string, std::string> map_name = std::unexpected(std::string{});
+            if (auto bytes = game.save_manager.read_bytes(game.snapshot_path)) {
+                map_name = snapshot_map_name(*bytes);
+                if (map_name) game.pending_snapshot = std::move(*bytes);
+            }
+            if (!map_name) {
+                if (auto legacy = game.save_manager.load(game.save_path)) {
+                    map_name = legacy->map_name;
+                    game.pending_load = std::move(*legacy);
                 }
+            }
+            if (map_name) {
+                auto map_result = game.map_manager.load_by_name(*map_name);
                 if (map_result) {
                     game.current_map = std::move(*map_result);
                     if (game.current_music) StopMusicStream(*game.current_music);
@@ -112,6 +125,8 @@ void MenuState::update(Game& game, float dt) {
                     game.state_machine.set_active_game(true);
                     game.state_machine.change_state(GameStateId::Playing, game);
                 } else {
+                    game.pending_snapshot = std::nullopt;
+                    game.pending_load = std::nullopt;
                     load_error_flash_ = 2.0f;
                 }
             } else {
@@ -119,6 +134,13 @@ void MenuState::update(Game& game, float dt) {
             }
             break;
         }
+        case MenuItem::StressTest:
+            if (game.current_music) StopMusicStream(*game.current_music);
+            game.current_music = nullptr;
+            if (auto started = game.start_stress_test(); !started) {
+                TraceLog(LOG_ERROR, "STRESS: %s", started.error().c_str());
+            }
+            break;
         case MenuItem::Upgrades:
             game.state_machine.change_state(GameStateId::Upgrades, game);
             break;
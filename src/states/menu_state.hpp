@@ -18,7 +18,7 @@ class MenuState : public IGameState {
   private:
     struct MenuItem {
         const char* label;
-        enum Action { ResumeGame, NewGame, LoadGame, Upgrades, Quit } action;
+        enum Action { ResumeGame, NewGame, LoadGame, StressTest, Upgrades, Quit } action;
     };
 
     int selected_{0};
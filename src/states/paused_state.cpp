@@ -1,6 +1,7 @@
 #include "paused_state.hpp"
 #include "core/asset_paths.hpp"
 #include "core/game.hpp"
+#include "core/game_snapshot.hpp"
 #include "systems/systems.hpp"
 #include <format>
 
@@ -21,26 +22,7 @@ static float pause_measure(AssetManager& a, const char* text, float size) {
     return static_cast<float>(MeasureText(text, static_cast<int>(size)));
 }
 
-static void do_save(Game& game) {
-    SaveData data;
-    data.map_name = game.current_map.name;
-    data.gold = game.play.gold;
-    data.lives = game.play.lives;
-    data.current_wave = game.play.current_wave;
-
-    auto heroes = game.registry.view<Hero>();
-    for (auto [e, hero] : heroes.each()) {
-        data.hero_level = hero.level;
-        data.hero_xp = hero.xp;
-    }
-
-    auto towers = game.registry.view<Tower, GridCell>();
-    for (auto [e, tower, gc] : towers.each()) {
-        data.towers.push_back({tower.type, tower.level, gc.pos});
-    }
-
-    game.save_manager.save(data, game.save_path);
-}
+static void do_save(Game& game) { save_game(game); }
 
 void PausedState::update(Game& game, [[maybe_unused]] float dt) {
     if (game.current_music) UpdateMusicStream(*game.current_music);
@@ -120,9 +102,9 @@ void PausedState::render(Game& game) {
     Camera2D cam = game.camera;
     cam.target.x += game.play.shake_offset.x;
     cam.target.y += game.play.shake_offset.y;
-    BeginMode2D(cam);
+    game.renderer->begin_world(cam);
     systems::render_system(game);
-    EndMode2D();
+    game.renderer->end_world();
 
     // Dark overlay
     DrawRectangle(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT, {0, 0, 0, 160});
@@ -1,48 +1,19 @@
 #include "playing_state.hpp"
 #include "core/asset_paths.hpp"
 #include "core/biome_theme.hpp"
+#include "core/camera.hpp"
 #include "core/game.hpp"
-#include "factory/hero_factory.hpp"
+#include "core/game_snapshot.hpp"
 #include "factory/tower_factory.hpp"
+#include "systems/match.hpp"
 #include "systems/systems.hpp"
 #include <cmath>
 #include <format>
+#include <limits>
+#include <random>
 
 namespace ls {
 
-// EnTT dispatcher with bound instance: instance is passed first, then event
-static void on_enemy_death(Game& g, const EnemyDeathEvent& evt) {
-    Gold reward = evt.reward;
-    // Apply difficulty gold modifier
-    if (g.difficulty == Difficulty::Easy)
-        reward = static_cast<Gold>(reward * 1.2f);
-    else if (g.difficulty == Difficulty::Hard)
-        reward = static_cast<Gold>(reward * 0.8f);
-
-    g.play.total_kills++;
-    g.play.stats.total_kills++;
-
-    // Spawn coin pickup at death position
-    auto coin = g.registry.create();
-    g.registry.emplace<Transform>(coin, evt.position);
-    g.registry.emplace<Sprite>(coin, GOLD, 5, 20.0f, 20.0f, true, std::string(assets::COIN_SPRITE));
-    g.registry.emplace<Coin>(coin, reward, 0.0f, 24.0f);
-    g.registry.emplace<Lifetime>(coin, 15.0f); // coins disappear after 15 seconds
-
-    auto heroes = g.registry.view<Hero>();
-    for (auto [e, hero] : heroes.each()) {
-        hero.xp += evt.reward / 2;
-    }
-}
-
-static void on_enemy_reached_exit(Game& g, const EnemyReachedExitEvent& evt) {
-    g.play.lives -= evt.damage;
-    if (g.play.lives <= 0) {
-        g.play.lives = 0;
-        g.dispatcher.trigger(GameOverEvent{});
-    }
-}
-
 static void on_game_over(Game& g, const GameOverEvent&) {
     g.state_machine.change_state(GameStateId::GameOver, g);
 }
@@ -72,6 +43,8 @@ static void on_wave_complete(Game& g, const WaveCompleteEvent&) {
     if (g.play.tutorial.active && g.play.tutorial.step == 3) {
         g.play.tutorial.step = 4;
     }
+    // Snapshot once the tick finishes so the save never holds a half-updated frame
+    g.play.autosave_pending = true;
 }
 
 static void on_enemy_death_tutorial(Game& g, const EnemyDeathEvent&) {
@@ -89,10 +62,10 @@ static void on_tower_placed(Game& g, const TowerPlacedEvent&) {
 }
 
 void PlayingState::enter(Game& game) {
-    // Reset play state
-    game.play = PlayState{};
-    game.registry.clear();
-    game.recalculate_path();
+    // Only matches started from scratch can be recorded
+    bool fresh_match = !game.pending_snapshot && !game.pending_load && !game.stress && !game.soak;
+
+    reset_match(game);
     game.state_machine.set_active_game(true);
 
     // Initialize sounds if not already done
@@ -100,72 +73,89 @@ void PlayingState::enter(Game& game) {
         game.sounds.init();
     }
 
-    // Apply difficulty modifiers (all start 0 gold - earn by fighting)
-    switch (game.difficulty) {
-    case Difficulty::Easy:
-        game.play.gold = 0;
-        game.play.lives = 30;
-        break;
-    case Difficulty::Normal:
-        game.play.gold = 0;
-        game.play.lives = STARTING_LIVES;
-        break;
-    case Difficulty::Hard:
-        game.play.gold = 0;
-        game.play.lives = 10;
-        break;
+    // Restore a full snapshot if one is pending; otherwise start fresh (optionally from a legacy save)
+    bool restored = false;
+    if (game.pending_snapshot) {
+        auto result = restore_game_snapshot(game, *game.pending_snapshot);
+        game.pending_snapshot = std::nullopt;
+        if (result) {
+            restored = true;
+        } else {
+            TraceLog(LOG_ERROR, "SAVE: %s", result.error().c_str());
+        }
     }
 
-    // Create hero at spawn
     auto spawn_world = game.current_map.grid_to_world(game.current_map.spawn);
-    game.play.hero = create_hero(game.registry, spawn_world);
-
-    // Apply upgrade bonuses
-    if (game.upgrades.bonus_hp() > 0) {
-        auto& hp = game.registry.get<Health>(game.play.hero);
-        hp.max += game.upgrades.bonus_hp();
-        hp.current = hp.max;
-    }
-
-    // Restore from save if available
-    if (game.pending_load) {
-        auto& save = *game.pending_load;
-        game.play.gold = save.gold;
-        game.play.lives = save.lives;
-        game.play.current_wave = save.current_wave;
-
-        // Restore hero stats
-        auto& hero = game.registry.get<Hero>(game.play.hero);
-        hero.level = save.hero_level;
-        hero.xp = save.hero_xp;
-        hero.xp_to_next = HERO_XP_PER_LEVEL * hero.level;
-        auto& hp = game.registry.get<Health>(game.play.hero);
-        hp.max = HERO_BASE_HP + (hero.level - 1) * 20;
-        hp.current = hp.max;
-
-        // Restore towers
-        for (auto& ts : save.towers) {
-            auto& stats = game.tower_registry.get(ts.type, ts.level);
-            create_tower(game.registry, stats, ts.pos, game.current_map);
-            game.play.tower_positions.insert(ts.pos);
+    if (!restored) {
+        setup_new_match(game);
+
+        // Restore from save if available
+        if (game.pending_load) {
+            auto& save = *game.pending_load;
+            game.play.gold = save.gold;
+            game.play.lives = save.lives;
+            game.play.current_wave = save.current_wave;
+
+            // Restore hero stats
+            auto& hero = game.registry.get<Hero>(game.play.hero);
+            hero.level = save.hero_level;
+            hero.xp = save.hero_xp;
+            hero.xp_to_next = HERO_XP_PER_LEVEL * hero.level;
+            auto& hp = game.registry.get<Health>(game.play.hero);
+            hp.max = HERO_BASE_HP + (hero.level - 1) * 20;
+            hp.current = hp.max;
+
+            // Restore towers
+            for (auto& ts : save.towers) {
+                auto& stats = game.tower_registry.get(ts.type, ts.level);
+                auto e = create_tower(game.registry, stats, ts.pos, game.current_map);
+                game.play.towers.place(ts.pos, e);
+            }
+
+            game.pending_load = std::nullopt;
+            // Skip tutorial on load
+            game.play.tutorial.completed = true;
         }
+    }
 
-        game.pending_load = std::nullopt;
-        // Skip tutorial on load
+    // Stress mode: nothing can end the run but the frame rate, and the wave system stays parked
+    if (game.stress) {
+        game.play.gold = 0;
+        game.play.lives = std::numeric_limits<int>::max();
+        game.play.wave_timer = std::numeric_limits<float>::max();
         game.play.tutorial.completed = true;
+        SetTargetFPS(0);
     }
 
     // Initialize camera
     game.camera.offset = {SCREEN_WIDTH / 2.0f, SCREEN_HEIGHT / 2.0f};
-    game.camera.target = {spawn_world.x, spawn_world.y};
+    auto focus = restored ? game.registry.get<Transform>(game.play.hero).position : spawn_world;
+    game.camera.target = {focus.x, focus.y};
     game.camera.rotation = 0.0f;
     game.camera.zoom = 1.0f;
 
-    // Generate decorations
-    game.current_map.generate_decorations();
+    // Generate decorations and bake them with the tiles into a single layer
+    game.rng.decoration.seed(game.current_map.decoration_seed(), rng_stream::DECORATION);
+    game.current_map.generate_decorations(game.rng.decoration);
+    systems::bake_tile_layer(game);
 
     setup_event_handlers(game);
 
+    // Seed the match streams (a restored snapshot carries its own stream state)
+    game.input = InputFrame{};
+    game.pending_commands.clear();
+    if (game.replay) {
+        game.seed = game.replay->header().seed;
+    } else {
+        game.seed = game.soak ? game.soak->match_seed() : static_cast<uint32_t>(std::random_device{}());
+        game.finish_recording();
+        if (game.recorder && fresh_match) {
+            game.recorder->begin({game.seed, game.current_map.name, game.difficulty, game.upgrades});
+            game.write_recording();
+        }
+    }
+    if (!restored) game.rng.seed(game.seed);
+
     // Start gameplay music (biome-specific)
     auto& theme = get_biome_theme(game.current_map.name);
     Music* gameplay_music = game.assets.get_music(theme.music_track);
@@ -182,8 +172,7 @@ void PlayingState::exit(Game& game) {
 }
 
 void PlayingState::setup_event_handlers(Game& game) {
-    game.dispatcher.sink<EnemyDeathEvent>().connect<&on_enemy_death>(game);
-    game.dispatcher.sink<EnemyReachedExitEvent>().connect<&on_enemy_reached_exit>(game);
+    connect_match_events(game);
     game.dispatcher.sink<GameOverEvent>().connect<&on_game_over>(game);
     game.dispatcher.sink<VictoryEvent>().connect<&on_victory>(game);
     game.dispatcher.sink<WaveStartEvent>().connect<&on_wave_start>(game);
@@ -192,6 +181,31 @@ void PlayingState::setup_event_handlers(Game& game) {
     game.dispatcher.sink<TowerPlacedEvent>().connect<&on_tower_placed>(game);
 }
 
+// Music and zoom: the controls that only change how the match is heard and seen, so replays keep them
+static void view_controls(Game& game) {
+    if (IsKeyPressed(KEY_M)) {
+        game.music_muted = !game.music_muted;
+        if (game.current_music) {
+            SetMusicVolume(*game.current_music, game.music_muted ? 0.0f : game.music_volume);
+        }
+    }
+    if (IsKeyPressed(KEY_EQUAL) || IsKeyPressed(KEY_KP_ADD)) {
+        game.music_volume = std::min(1.0f, game.music_volume + 0.1f);
+        if (game.current_music && !game.music_muted) SetMusicVolume(*game.current_music, game.music_volume);
+    }
+    if (IsKeyPressed(KEY_MINUS) || IsKeyPressed(KEY_KP_SUBTRACT)) {
+        game.music_volume = std::max(0.0f, game.music_volume - 0.1f);
+        if (game.current_music && !game.music_muted) SetMusicVolume(*game.current_music, game.music_volume);
+    }
+
+    // Mouse-wheel zoom, down to the whole map on screen
+    float wheel = GetMouseWheelMove();
+    if (wheel != 0.0f) {
+        float lo = min_zoom(game.current_map.cols, game.current_map.rows);
+        game.camera.zoom = std::clamp(game.camera.zoom + wheel * ZOOM_STEP, lo, ZOOM_MAX);
+    }
+}
+
 void PlayingState::handle_input(Game& game) {
     auto& ps = game.play;
 
@@ -203,7 +217,7 @@ void PlayingState::handle_input(Game& game) {
 
     // Speed toggle
     if (IsKeyPressed(KEY_F)) {
-        ps.game_speed_fast = !ps.game_speed_fast;
+        game.pending_commands.push_back({CommandType::ToggleSpeed});
     }
 
     // Tutorial dismiss
@@ -215,25 +229,11 @@ void PlayingState::handle_input(Game& game) {
         }
     }
 
-    // Music controls
-    if (IsKeyPressed(KEY_M)) {
-        game.music_muted = !game.music_muted;
-        if (game.current_music) {
-            SetMusicVolume(*game.current_music, game.music_muted ? 0.0f : game.music_volume);
-        }
-    }
-    if (IsKeyPressed(KEY_EQUAL) || IsKeyPressed(KEY_KP_ADD)) {
-        game.music_volume = std::min(1.0f, game.music_volume + 0.1f);
-        if (game.current_music && !game.music_muted) SetMusicVolume(*game.current_music, game.music_volume);
-    }
-    if (IsKeyPressed(KEY_MINUS) || IsKeyPressed(KEY_KP_SUBTRACT)) {
-        game.music_volume = std::max(0.0f, game.music_volume - 0.1f);
-        if (game.current_music && !game.music_muted) SetMusicVolume(*game.current_music, game.music_volume);
-    }
+    view_controls(game);
 
     // Start wave early
     if (IsKeyPressed(KEY_SPACE) && !ps.wave_active && ps.current_wave < MAX_WAVES) {
-        ps.wave_timer = 0.0f;
+        game.pending_commands.push_back({CommandType::StartWave});
     }
 
     // Tower placement / selection via mouse click
@@ -251,28 +251,14 @@ void PlayingState::handle_input(Game& game) {
             if (game.can_place_tower(gp)) {
                 auto& stats = game.tower_registry.get(*ps.placing_tower, 1);
                 if (ps.gold >= stats.cost) {
-                    ps.gold -= stats.cost;
-                    ps.stats.gold_spent += stats.cost;
-                    ps.stats.towers_built++;
-                    auto e = create_tower(game.registry, stats, gp, game.current_map);
-                    ps.tower_positions.insert(gp);
-                    game.recalculate_path();
-                    game.dispatcher.trigger(TowerPlacedEvent{e, *ps.placing_tower, gp});
+                    game.pending_commands.push_back({CommandType::PlaceTower, *ps.placing_tower, gp});
                     ps.placing_tower = std::nullopt;
-                    game.sounds.play(game.sounds.tower_place);
                 }
             }
         } else {
             // Try to select a tower
-            ps.selected_tower = entt::null;
-            auto towers = game.registry.view<Tower, GridCell>();
-            for (auto [e, tower, gc] : towers.each()) {
-                if (gc.pos == gp) {
-                    ps.selected_tower = e;
-                    game.sounds.play(game.sounds.ui_click);
-                    break;
-                }
-            }
+            ps.selected_tower = ps.towers.at(gp);
+            if (ps.selected_tower != entt::null) game.sounds.play(game.sounds.ui_click);
         }
     }
 
@@ -282,10 +268,10 @@ void PlayingState::handle_input(Game& game) {
         ps.selected_tower = entt::null;
     }
 
-    // Tower hotkeys (1-6)
-    TowerType hotkey_towers[] = {TowerType::Arrow,     TowerType::Cannon, TowerType::Ice,
-                                 TowerType::Lightning, TowerType::Poison, TowerType::Laser};
-    for (int i = 0; i < 6; ++i) {
+    // Tower hotkeys (1-7)
+    TowerType hotkey_towers[] = {TowerType::Arrow,  TowerType::Cannon, TowerType::Ice,     TowerType::Lightning,
+                                 TowerType::Poison, TowerType::Laser,  TowerType::Ballista};
+    for (int i = 0; i < static_cast<int>(std::size(hotkey_towers)); ++i) {
         if (IsKeyPressed(KEY_ONE + i)) {
             auto& stats = game.tower_registry.get(hotkey_towers[i], 1);
             if (ps.gold >= stats.cost) {
@@ -297,30 +283,107 @@ void PlayingState::handle_input(Game& game) {
     }
 
     // Save game
-    if (IsKeyDown(KEY_LEFT_CONTROL) && IsKeyPressed(KEY_S)) {
-        SaveData data;
-        data.map_name = game.current_map.name;
-        data.gold = ps.gold;
-        data.lives = ps.lives;
-        data.current_wave = ps.current_wave;
-
-        auto heroes = game.registry.view<Hero>();
-        for (auto [e, hero] : heroes.each()) {
-            data.hero_level = hero.level;
-            data.hero_xp = hero.xp;
-        }
+    if (IsKeyDown(KEY_LEFT_CONTROL) && IsKeyPressed(KEY_S) && !game.stress) {
+        save_game(game);
+    }
+}
 
-        auto towers = game.registry.view<Tower, GridCell>();
-        for (auto [e, tower, gc] : towers.each()) {
-            data.towers.push_back({tower.type, tower.level, gc.pos});
-        }
+// Sample the keys the simulation reads and hand over the commands queued since the last tick
+static void capture_input(Game& game) {
+    auto& in = game.input;
+    in.buttons = 0;
+    if (IsKeyDown(KEY_W)) in.buttons |= input_bits::MOVE_UP;
+    if (IsKeyDown(KEY_S)) in.buttons |= input_bits::MOVE_DOWN;
+    if (IsKeyDown(KEY_A)) in.buttons |= input_bits::MOVE_LEFT;
+    if (IsKeyDown(KEY_D)) in.buttons |= input_bits::MOVE_RIGHT;
+    if (IsKeyPressed(KEY_Q)) in.buttons |= input_bits::FIREBALL;
+    if (IsKeyPressed(KEY_E)) in.buttons |= input_bits::HEAL_AURA;
+    if (IsKeyPressed(KEY_R)) in.buttons |= input_bits::LIGHTNING;
+    in.ability_target = game.mouse_world();
+    in.commands.clear();
+    std::swap(in.commands, game.pending_commands);
+}
+
+// Soak matches are played by a bot: double speed, every wave called as soon as the last one ends,
+// towers of each type in turn along the path, upgrades once there's no room left, and the scripted
+// hero walking to each coin before it fights
+static void bot_input(Game& game) {
+    auto& in = game.input;
+    auto& ps = game.play;
+    in.commands.clear();
+    game.pending_commands.clear();
+
+    scripted_hero_input(game, in);
+    if (!ps.game_speed_fast) in.commands.push_back({CommandType::ToggleSpeed});
+    if (!ps.wave_active && ps.current_wave < MAX_WAVES) in.commands.push_back({CommandType::StartWave});
+
+    scripted_build_commands(game, in.commands);
+}
+
+static void log_stress_mark(const char* label, const StressMark& m) {
+    TraceLog(LOG_INFO,
+             "STRESS: frame time passed %s at %.1f s (%.1f ms) - %d entities: %d enemies, %d towers, %d projectiles, "
+             "%d particles",
+             label, m.time, m.frame_ms, m.counts.total, m.counts.enemies, m.counts.towers, m.counts.projectiles,
+             m.counts.particles);
+}
 
-        game.save_manager.save(data, game.save_path);
+// Feeds the last frame's time to the stress test and reports each budget as it is crossed
+static void update_stress(Game& game, float dt) {
+    auto& st = *game.stress;
+    bool had_60 = st.mark_60fps().has_value();
+    bool had_30 = st.mark_30fps().has_value();
+    bool was_finished = st.finished();
+    st.record_frame(dt, count_entities(game.registry, game.play.shots.size() + game.play.bolts.size()));
+
+    if (!had_60 && st.mark_60fps()) log_stress_mark("16.6 ms", *st.mark_60fps());
+    if (!had_30 && st.mark_30fps()) log_stress_mark("33 ms", *st.mark_30fps());
+    if (!was_finished && st.finished()) {
+        TraceLog(LOG_INFO, "STRESS: capacity score %d (map %s, %.1f s)", st.capacity_score(),
+                 game.current_map.name.c_str(), st.elapsed());
+        SetTargetFPS(TARGET_FPS);
     }
 }
 
 void PlayingState::update(Game& game, float dt) {
-    handle_input(game);
+    if (game.stress) {
+        update_stress(game, dt);
+        // The run is over: freeze the field under the results panel until the player leaves
+        if (game.stress->finished()) {
+            if (IsKeyPressed(KEY_ENTER)) {
+                game.state_machine.change_state(GameStateId::Menu, game);
+            }
+            return;
+        }
+    }
+
+    // A replay is only watched: pausing, selecting, the tutorial and saving would act on the match
+    if (game.replay) {
+        view_controls(game);
+    } else if (!game.soak) {
+        handle_input(game);
+    }
+
+    // Replays substitute the recorded frame time and input for the live ones; the bot plays soak matches
+    if (game.replay) {
+        game.pending_commands.clear();
+        if (!game.replay->next(dt, game.input)) {
+            if (game.replay->truncated()) {
+                TraceLog(LOG_WARNING, "REPLAY: recording cut short after %zu ticks", game.replay->ticks());
+            }
+            game.running = false;
+            return;
+        }
+    } else if (game.soak) {
+        bot_input(game);
+    } else {
+        capture_input(game);
+        if (game.recorder) {
+            game.recorder->record(dt, game.input);
+            game.write_recording();
+        }
+    }
+    systems::command_system(game);
 
     float speed = game.play.game_speed_fast ? 2.0f : 1.0f;
     float scaled_dt = dt * speed;
@@ -332,8 +395,8 @@ void PlayingState::update(Game& game, float dt) {
     if (game.play.shake_timer > 0) {
         game.play.shake_timer -= dt; // real-time, not scaled
         float intensity = game.play.shake_intensity * (game.play.shake_timer / 0.4f);
-        game.play.shake_offset.x = static_cast<float>(GetRandomValue(-100, 100)) / 100.0f * intensity;
-        game.play.shake_offset.y = static_cast<float>(GetRandomValue(-100, 100)) / 100.0f * intensity;
+        game.play.shake_offset.x = game.rng.vfx.range(-1.0f, 1.0f) * intensity;
+        game.play.shake_offset.y = game.rng.vfx.range(-1.0f, 1.0f) * intensity;
     } else {
         game.play.shake_offset = {};
     }
@@ -346,23 +409,6 @@ void PlayingState::update(Game& game, float dt) {
         }
     }
 
-    // Clean up dead entities
-    {
-        auto view = game.registry.view<Dead>();
-        std::vector<entt::entity> dead;
-        for (auto e : view) {
-            dead.push_back(e);
-        }
-        for (auto e : dead) {
-            if (game.registry.valid(e)) {
-                // Don't destroy hero
-                if (!game.registry.all_of<Hero>(e)) {
-                    game.registry.destroy(e);
-                }
-            }
-        }
-    }
-
     // Update music stream
     if (game.current_music) UpdateMusicStream(*game.current_music);
 
@@ -395,31 +441,50 @@ void PlayingState::update(Game& game, float dt) {
         auto& htf = game.registry.get<Transform>(game.play.hero);
         float world_w = static_cast<float>(GRID_COLS * TILE_SIZE);
         float world_h = static_cast<float>(GRID_ROWS * TILE_SIZE);
-        float half_w = SCREEN_WIDTH / 2.0f;
-        float half_h = SCREEN_HEIGHT / 2.0f;
-        game.camera.target.x = std::clamp(htf.position.x, half_w, world_w - half_w);
-        game.camera.target.y = std::clamp(htf.position.y, half_h, world_h - half_h);
-    }
-
-    systems::hero_system(game, scaled_dt);
-    systems::enemy_spawn_system(game, scaled_dt);
-    systems::path_follow_system(game, scaled_dt);
-    systems::boss_system(game, scaled_dt);
-    systems::movement_system(game, scaled_dt);
-    systems::body_collision_system(game, scaled_dt);
-    systems::enemy_combat_system(game, scaled_dt);
-    systems::tower_targeting_system(game, scaled_dt);
-    systems::tower_attack_system(game, scaled_dt);
-    systems::projectile_system(game, scaled_dt);
-    systems::aura_system(game, scaled_dt);
-    systems::effect_system(game, scaled_dt);
-    systems::health_system(game, scaled_dt);
-    systems::tower_health_system(game, scaled_dt);
-    systems::collision_system(game, scaled_dt);
-    systems::lifetime_system(game, scaled_dt);
-    systems::particle_system(game, scaled_dt);
-    systems::coin_system(game, scaled_dt);
-    systems::animated_sprite_system(game, scaled_dt);
+        game.camera.target = clamp_camera_target(htf.position, game.camera.zoom, world_w, world_h).to_raylib();
+    }
+
+    systems::simulate(game, scaled_dt);
+
+    if (game.play.autosave_pending) {
+        game.play.autosave_pending = false;
+        if (!game.replay) save_game(game);
+    }
+    if (auto err = game.save_manager.take_write_error()) {
+        TraceLog(LOG_ERROR, "SAVE: %s", err->c_str());
+    }
+}
+
+static void render_stress(Game& game) {
+    auto& st = *game.stress;
+    auto counts = count_entities(game.registry, game.play.shots.size() + game.play.bolts.size());
+
+    if (!st.finished()) {
+        auto live = std::format("STRESS {:.0f}s  {} FPS  {} entities ({} enemies, {} towers, {} projectiles)",
+                                st.elapsed(), GetFPS(), counts.total, counts.enemies, counts.towers,
+                                counts.projectiles);
+        DrawRectangle(10, HUD_HEIGHT + 10, MeasureText(live.c_str(), 16) + 16, 28, {0, 0, 0, 180});
+        DrawText(live.c_str(), 18, HUD_HEIGHT + 16, 16, ORANGE);
+        return;
+    }
+
+    DrawRectangle(0, 0, SCREEN_WIDTH, SCREEN_HEIGHT, {0, 0, 0, 170});
+    float cx = SCREEN_WIDTH / 2.0f;
+    auto centered = [&](const std::string& text, float y, int size, Color color) {
+        DrawText(text.c_str(), static_cast<int>(cx) - MeasureText(text.c_str(), size) / 2, static_cast<int>(y), size,
+                 color);
+    };
+    centered("STRESS TEST COMPLETE", 180, 36, GOLD);
+    centered(std::format("Capacity score: {}", st.capacity_score()), 240, 28, WHITE);
+
+    auto mark_line = [](const char* label, const std::optional<StressMark>& m) {
+        if (!m) return std::format("{}: not reached", label);
+        return std::format("{}: {} entities at {:.0f}s ({} enemies, {} towers, {} projectiles)", label, m->counts.total,
+                           m->time, m->counts.enemies, m->counts.towers, m->counts.projectiles);
+    };
+    centered(mark_line("16.6 ms", st.mark_60fps()), 300, 18, LIGHTGRAY);
+    centered(mark_line("33 ms", st.mark_30fps()), 330, 18, LIGHTGRAY);
+    centered("Press ENTER to return to the menu", 400, 16, GRAY);
 }
 
 void PlayingState::render(Game& game) {
@@ -430,12 +495,14 @@ void PlayingState::render(Game& game) {
     cam.target.x += game.play.shake_offset.x;
     cam.target.y += game.play.shake_offset.y;
 
-    BeginMode2D(cam);
+    game.renderer->begin_world(cam);
     systems::render_system(game);
-    EndMode2D();
+    game.renderer->end_world();
 
     // UI renders outside camera (screen space)
     systems::ui_system(game);
+
+    if (game.stress) render_stress(game);
 }
 
 } // namespace ls
@@ -0,0 +1,172 @@
+#include "match.hpp"
+#include "components/components.hpp"
+#include "core/asset_paths.hpp"
+#include "core/game.hpp"
+#include "factory/hero_factory.hpp"
+#include <limits>
+#include <string>
+
+namespace ls {
+
+// EnTT dispatcher with bound instance: instance is passed first, then event
+static void on_enemy_death(Game& g, const EnemyDeathEvent& evt) {
+    Gold reward = evt.reward;
+    // Apply difficulty gold modifier
+    if (g.difficulty == Difficulty::Easy)
+        reward = static_cast<Gold>(reward * 1.2f);
+    else if (g.difficulty == Difficulty::Hard)
+        reward = static_cast<Gold>(reward * 0.8f);
+
+    g.play.total_kills++;
+    g.play.stats.total_kills++;
+
+    // Spawn coin pickup at death position
+    auto coin = g.registry.create();
+    g.registry.emplace<Transform>(coin, evt.position);
+    g.registry.emplace<Sprite>(coin, GOLD, 5, 20.0f, 20.0f, true, std::string(assets::COIN_SPRITE));
+    g.registry.emplace<Coin>(coin, reward, 0.0f, 24.0f);
+    g.registry.emplace<Lifetime>(coin, 15.0f); // coins disappear after 15 seconds
+
+    auto heroes = g.registry.view<Hero>();
+    for (auto [e, hero] : heroes.each()) {
+        hero.xp += evt.reward / 2;
+    }
+}
+
+static void on_enemy_reached_exit(Game& g, const EnemyReachedExitEvent& evt) {
+    g.play.lives -= evt.damage;
+    if (g.play.lives <= 0) {
+        g.play.lives = 0;
+        g.dispatcher.trigger(GameOverEvent{});
+    }
+}
+
+void reset_match(Game& game) {
+    game.play = PlayState{};
+    game.registry.clear();
+    game.enemy_index.clear();
+    game.recalculate_path();
+}
+
+void setup_new_match(Game& game) {
+    // Apply difficulty modifiers (all start 0 gold - earn by fighting)
+    switch (game.difficulty) {
+    case Difficulty::Easy:
+        game.play.gold = 0;
+        game.play.lives = 30;
+        break;
+    case Difficulty::Normal:
+        game.play.gold = 0;
+        game.play.lives = STARTING_LIVES;
+        break;
+    case Difficulty::Hard:
+        game.play.gold = 0;
+        game.play.lives = 10;
+        break;
+    }
+
+    // Create hero at spawn
+    game.play.hero = create_hero(game.registry, game.current_map.grid_to_world(game.current_map.spawn));
+
+    // Apply upgrade bonuses
+    if (game.upgrades.bonus_hp() > 0) {
+        auto& hp = game.registry.get<Health>(game.play.hero);
+        hp.max += game.upgrades.bonus_hp();
+        hp.current = hp.max;
+    }
+}
+
+void connect_match_events(Game& game) {
+    game.dispatcher.sink<EnemyDeathEvent>().connect<&on_enemy_death>(game);
+    game.dispatcher.sink<EnemyReachedExitEvent>().connect<&on_enemy_reached_exit>(game);
+}
+
+std::optional<GridPos> nearest_free_cell_to_path(const Game& game) {
+    auto& map = game.current_map;
+    std::optional<GridPos> best;
+    float best_dist = std::numeric_limits<float>::max();
+    for (int y = 0; y < map.rows; ++y) {
+        for (int x = 0; x < map.cols; ++x) {
+            if (!game.can_place_tower({x, y})) continue;
+            auto center = map.grid_to_world({x, y});
+            for (auto& p : *game.play.enemy_path) {
+                if (float d = center.distance_to(p); d < best_dist) {
+                    best_dist = d;
+                    best = GridPos{x, y};
+                }
+            }
+        }
+    }
+    return best;
+}
+
+void scripted_build_commands(const Game& game, std::vector<InputCommand>& out) {
+    auto& ps = game.play;
+    auto type = static_cast<TowerType>(ps.stats.towers_built % TOWER_TYPE_COUNT);
+    if (ps.gold >= game.tower_registry.get(type, 1).cost) {
+        if (auto cell = nearest_free_cell_to_path(game)) {
+            out.push_back({CommandType::PlaceTower, type, *cell});
+            return;
+        }
+    }
+    for (auto [e, tower, gc] : game.registry.view<Tower, GridCell>().each()) {
+        if (tower.level < TowerRegistry::MAX_LEVEL &&
+            ps.gold >= game.tower_registry.upgrade_cost(tower.type, tower.level)) {
+            out.push_back({CommandType::UpgradeTower, {}, gc.pos});
+            return;
+        }
+    }
+}
+
+void scripted_hero_input(const Game& game, InputFrame& in) {
+    auto& reg = game.registry;
+    auto& ps = game.play;
+    in.buttons = 0;
+    if (!reg.valid(ps.hero) || reg.all_of<Dead>(ps.hero)) return;
+    Vec2 pos = reg.get<Transform>(ps.hero).position;
+
+    // Enemy furthest along its path
+    entt::entity lead = entt::null;
+    float lead_dist = -1.0f;
+    for (auto [e, en, pf] : reg.view<Enemy, PathFollower>(entt::exclude<Dead>).each()) {
+        if (!pf.path || pf.current_index >= pf.path->size()) continue;
+        if (pf.distance > lead_dist) {
+            lead = e;
+            lead_dist = pf.distance;
+        }
+    }
+    if (lead != entt::null) {
+        in.ability_target = reg.get<Transform>(lead).position;
+        in.buttons |= input_bits::FIREBALL | input_bits::HEAL_AURA | input_bits::LIGHTNING;
+    }
+
+    // Coins first (they expire), then the lead enemy at a comfortable attack distance, then the
+    // middle of the path
+    Vec2 goal = pos;
+    float stand_off = 0.0f;
+    float coin_dist = std::numeric_limits<float>::max();
+    for (auto [e, coin, tf] : reg.view<Coin, Transform>().each()) {
+        if (float d = pos.distance_to(tf.position); d < coin_dist) {
+            coin_dist = d;
+            goal = tf.position;
+        }
+    }
+    if (coin_dist == std::numeric_limits<float>::max()) {
+        if (lead != entt::null) {
+            goal = in.ability_target;
+            stand_off = HERO_ATTACK_RANGE * 0.6f;
+        } else if (ps.enemy_path && !ps.enemy_path->empty()) {
+            goal = (*ps.enemy_path)[ps.enemy_path->size() / 2];
+        }
+    }
+
+    constexpr float DEADZONE = 8.0f;
+    Vec2 to_goal = goal - pos;
+    if (to_goal.length() <= stand_off + DEADZONE) return;
+    if (to_goal.x > DEADZONE) in.buttons |= input_bits::MOVE_RIGHT;
+    if (to_goal.x < -DEADZONE) in.buttons |= input_bits::MOVE_LEFT;
+    if (to_goal.y > DEADZONE) in.buttons |= input_bits::MOVE_DOWN;
+    if (to_goal.y < -DEADZONE) in.buttons |= input_bits::MOVE_UP;
+}
+
+} // namespace ls
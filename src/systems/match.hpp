@@ -0,0 +1,36 @@
+#pragma once
+#include "core/input.hpp"
+#include "core/types.hpp"
+#include <optional>
+#include <vector>
+
+namespace ls {
+
+struct Game;
+
+// A match without the Playing state around it: what PlayingState::enter sets up, the event
+// handlers the outcome depends on, and the scripted players used by soak runs and the balance
+// runner. Nothing here touches the window, audio or the state machine.
+
+// Clears the registry and play state and recomputes the paths for game.current_map
+void reset_match(Game& game);
+
+// Starting lives and gold for game.difficulty, and the hero at the spawn with its upgrade bonuses
+void setup_new_match(Game& game);
+
+// Kill rewards (coin drop and hero XP) and lives lost at the exit, which raises GameOverEvent.
+// Connect once per dispatcher; screens and sounds hook their own handlers on top.
+void connect_match_events(Game& game);
+
+// Free buildable cell closest to the enemy path, if any
+std::optional<GridPos> nearest_free_cell_to_path(const Game& game);
+
+// Scripted builder: the next tower type in turn on the free cell nearest the path once it's affordable,
+// otherwise the first affordable upgrade. Appends at most one command.
+void scripted_build_commands(const Game& game, std::vector<InputCommand>& out);
+
+// Scripted hero: picks up coins, otherwise closes on the enemy nearest the exit or holds the middle
+// of the path, and fires every ability at that enemy. Sets the buttons and ability target only.
+void scripted_hero_input(const Game& game, InputFrame& in);
+
+} // namespace ls
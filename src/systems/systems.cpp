@@ -2,7 +2,9 @@
 #include "components/components.hpp"
 #include "core/asset_paths.hpp"
 #include "core/biome_theme.hpp"
+#include "core/camera.hpp"
 #include "core/game.hpp"
+#include "core/profiler.hpp"
 #include "factory/enemy_factory.hpp"
 #include "factory/hero_factory.hpp"
 #include "factory/projectile_factory.hpp"
@@ -10,25 +12,27 @@
 #include <algorithm>
 #include <cmath>
 #include <format>
+#include <optional>
 #include <raylib.h>
 
 namespace ls::systems {
 
 // Helper: draw a texture scaled to a destination rect with optional rotation and tint
-static void draw_tex(Texture2D* tex, float x, float y, float w, float h, float rot, Color tint) {
+static void draw_tex(Renderer& gfx, Texture2D* tex, float x, float y, float w, float h, float rot, Color tint) {
     if (!tex) return;
     Rectangle src = {0, 0, static_cast<float>(tex->width), static_cast<float>(tex->height)};
     Rectangle dst = {x, y, w, h};
     Vector2 origin = {w / 2.0f, h / 2.0f};
-    DrawTexturePro(*tex, src, dst, origin, rot, tint);
+    gfx.texture(*tex, src, dst, origin, rot, tint);
 }
 
 // Helper: draw a texture from a spritesheet sub-rect
-static void draw_tex_src(Texture2D* tex, Rectangle srcRect, float x, float y, float w, float h, float rot, Color tint) {
+static void draw_tex_src(Renderer& gfx, Texture2D* tex, Rectangle srcRect, float x, float y, float w, float h,
+                         float rot, Color tint) {
     if (!tex) return;
     Rectangle dst = {x, y, w, h};
     Vector2 origin = {w / 2.0f, h / 2.0f};
-    DrawTexturePro(*tex, srcRect, dst, origin, rot, tint);
+    gfx.texture(*tex, srcRect, dst, origin, rot, tint);
 }
 
 // Helper: get angle in degrees from direction vector
@@ -37,14 +41,9 @@ static float angle_from_dir(Vec2 dir) {
     return std::atan2(dir.y, dir.x) * RAD2DEG;
 }
 
-// Helper: DrawTextEx with the game font, falling back to DrawText
-static void draw_text(AssetManager& a, const char* text, float x, float y, float size, Color color) {
-    Font* font = a.get_font(assets::FONT_MAIN);
-    if (font) {
-        DrawTextEx(*font, text, {x, y}, size, 1.0f, color);
-    } else {
-        DrawText(text, static_cast<int>(x), static_cast<int>(y), static_cast<int>(size), color);
-    }
+// Helper: text in the game font, falling back to raylib's default font
+static void draw_text(Renderer& gfx, AssetManager& a, const char* text, float x, float y, float size, Color color) {
+    gfx.text(a.get_font(assets::FONT_MAIN), text, {x, y}, size, 1.0f, color);
 }
 
 // Helper: MeasureTextEx with font fallback
@@ -56,20 +55,196 @@ static float measure_text(AssetManager& a, const char* text, float size) {
     return static_cast<float>(MeasureText(text, static_cast<int>(size)));
 }
 
+// Helper: path speed after slows and stuns
+static float effective_speed(const entt::registry& reg, entt::entity e, const PathFollower& pf) {
+    float speed = pf.speed;
+    if (auto* eff = reg.try_get<Effect>(e)) {
+        if (eff->type == EffectType::Slow) speed *= eff->slow_factor;
+        if (eff->type == EffectType::Stun) speed = 0.0f;
+    }
+    return speed;
+}
+
+// Helper: where a shot leaving `origin` at `speed` meets `target`, assuming the target keeps walking its
+// path at its current speed. Each pass re-times the flight to the previous guess; enemies are much
+// slower than shots, so a few passes land within a pixel. Targets off a path are aimed at directly.
+static Vec2 lead_target(const entt::registry& reg, entt::entity target, Vec2 origin, float speed) {
+    Vec2 pos = reg.get<Transform>(target).position;
+    auto* pf = reg.try_get<PathFollower>(target);
+    if (!pf || !pf->path || pf->path->empty() || speed <= 0.0f) return pos;
+    auto& path = *pf->path;
+    Vec2 offset = pos - path.at(pf->distance);
+    float walk = effective_speed(reg, target, *pf);
+    Vec2 aim = pos;
+    for (int i = 0; i < LEAD_ITERATIONS; ++i) {
+        aim = path.at(pf->distance + walk * origin.distance_to(aim) / speed) + offset;
+    }
+    return aim;
+}
+
+// ============================================================
+// Simulation tick - every gameplay system in update order
+// ============================================================
+void simulate(Game& game, float dt) {
+    // Clean up dead entities
+    {
+        PROFILE_SCOPE("dead_cleanup");
+        auto view = game.registry.view<Dead>();
+        auto& dead = game.scratch_entities;
+        dead.clear();
+        for (auto e : view) {
+            dead.push_back(e);
+        }
+        for (auto e : dead) {
+            if (game.registry.valid(e)) {
+                // Don't destroy hero
+                if (!game.registry.all_of<Hero>(e)) {
+                    game.registry.destroy(e);
+                }
+            }
+        }
+    }
+
+    hero_system(game, dt);
+    enemy_spawn_system(game, dt);
+    stress_system(game, dt);
+    path_follow_system(game, dt);
+    boss_system(game, dt);
+    movement_system(game, dt);
+    body_collision_system(game, dt);
+    enemy_combat_system(game, dt);
+    tower_targeting_system(game, dt);
+    tower_attack_system(game, dt);
+    projectile_system(game, dt);
+    aura_system(game, dt);
+    effect_system(game, dt);
+    health_system(game, dt);
+    tower_health_system(game, dt);
+    collision_system(game, dt);
+    lifetime_system(game, dt);
+    particle_system(game, dt);
+    coin_system(game, dt);
+    animated_sprite_system(game, dt);
+}
+
+// ============================================================
+// 0. Command System - applies player commands for this tick
+// ============================================================
+static void sell_tower(Game& game, entt::entity e) {
+    auto& ps = game.play;
+    auto& tower = game.registry.get<Tower>(e);
+    int sell_val = tower.cost / 2;
+    ps.gold += sell_val;
+    ps.stats.towers_sold++;
+    ps.towers.remove(game.registry.get<GridCell>(e).pos);
+    game.registry.destroy(e);
+    if (ps.selected_tower == e) ps.selected_tower = entt::null;
+    game.recalculate_path();
+}
+
+static void upgrade_tower(Game& game, entt::entity e) {
+    auto& ps = game.play;
+    auto& tower = game.registry.get<Tower>(e);
+    if (tower.level >= TowerRegistry::MAX_LEVEL) return;
+    int ucost = game.tower_registry.upgrade_cost(tower.type, tower.level);
+    if (ps.gold < ucost) return;
+    ps.gold -= ucost;
+    ps.stats.gold_spent += ucost;
+    tower.level++;
+    auto& new_stats = game.tower_registry.get(tower.type, tower.level);
+    tower.damage = new_stats.damage;
+    tower.range = new_stats.range;
+    tower.fire_rate = new_stats.fire_rate;
+    tower.aoe_radius = new_stats.aoe_radius;
+    tower.chain_count = new_stats.chain_count;
+    tower.pierce = new_stats.pierce;
+    tower.effect = new_stats.effect;
+    tower.effect_duration = new_stats.effect_duration;
+    // Also heal tower to new max HP on upgrade
+    if (game.registry.all_of<Health>(e)) {
+        auto& thp = game.registry.get<Health>(e);
+        int new_max_hp = tower_max_hp(tower.type, tower.level);
+        thp.max = new_max_hp;
+        thp.current = new_max_hp;
+    }
+    auto& spr = game.registry.get<Sprite>(e);
+    spr.color = new_stats.color;
+}
+
+static void repair_tower(Game& game, entt::entity e) {
+    auto& ps = game.play;
+    if (!game.registry.all_of<Health>(e)) return;
+    auto& thp = game.registry.get<Health>(e);
+    if (thp.current >= thp.max) return;
+    int repair_cost = std::max(1, (thp.max - thp.current) / 4); // 4 HP per gold
+    if (ps.gold < repair_cost) return;
+    ps.gold -= repair_cost;
+    ps.stats.gold_spent += repair_cost;
+    thp.current = thp.max;
+    create_floating_text(game.registry, game.registry.get<Transform>(e).position, "REPAIRED!", {70, 200, 255, 255});
+}
+
+void command_system(Game& game) {
+    PROFILE_FUNCTION();
+    auto& ps = game.play;
+    for (auto& cmd : game.input.commands) {
+        switch (cmd.type) {
+        case CommandType::PlaceTower: {
+            if (!game.can_place_tower(cmd.cell)) break;
+            auto& stats = game.tower_registry.get(cmd.tower, 1);
+            if (ps.gold < stats.cost) break;
+            ps.gold -= stats.cost;
+            ps.stats.gold_spent += stats.cost;
+            ps.stats.towers_built++;
+            auto e = create_tower(game.registry, stats, cmd.cell, game.current_map);
+            ps.towers.place(cmd.cell, e);
+            game.recalculate_path();
+            game.registry.emplace<TowerCoverage>(e).refresh(game.enemy_index, game.registry.get<Transform>(e).position,
+                                                            stats.range + TARGET_PATH_SLACK);
+            game.dispatcher.trigger(TowerPlacedEvent{e, cmd.tower, cmd.cell});
+            game.sounds.play(game.sounds.tower_place);
+            break;
+        }
+        case CommandType::UpgradeTower:
+            if (auto e = ps.towers.at(cmd.cell); e != entt::null) upgrade_tower(game, e);
+            break;
+        case CommandType::SellTower:
+            if (auto e = ps.towers.at(cmd.cell); e != entt::null) sell_tower(game, e);
+            break;
+        case CommandType::RepairTower:
+            if (auto e = ps.towers.at(cmd.cell); e != entt::null) repair_tower(game, e);
+            break;
+        case CommandType::StartWave:
+            if (!ps.wave_active && ps.current_wave < MAX_WAVES) ps.wave_timer = 0.0f;
+            break;
+        case CommandType::ToggleSpeed:
+            ps.game_speed_fast = !ps.game_speed_fast;
+            break;
+        case CommandType::SetTargetMode:
+            if (auto e = ps.towers.at(cmd.cell); e != entt::null) {
+                game.registry.get<Tower>(e).target_mode = cmd.target_mode;
+            }
+            break;
+        }
+    }
+}
+
 // ============================================================
 // 1. Hero System - WASD movement, auto-attack, abilities
 // ============================================================
 void hero_system(Game& game, float dt) {
+    PROFILE_FUNCTION();
     auto& reg = game.registry;
+    auto& input = game.input;
     auto view = reg.view<Hero, Transform, Health>();
 
     for (auto [e, hero, tf, hp] : view.each()) {
         // WASD movement - set velocity so animated_sprite_system can detect direction
         Vec2 move{};
-        if (IsKeyDown(KEY_W)) move.y -= 1;
-        if (IsKeyDown(KEY_S)) move.y += 1;
-        if (IsKeyDown(KEY_A)) move.x -= 1;
-        if (IsKeyDown(KEY_D)) move.x += 1;
+        if (input.held(input_bits::MOVE_UP)) move.y -= 1;
+        if (input.held(input_bits::MOVE_DOWN)) move.y += 1;
+        if (input.held(input_bits::MOVE_LEFT)) move.x -= 1;
+        if (input.held(input_bits::MOVE_RIGHT)) move.x += 1;
 
         auto& vel = reg.get<Velocity>(e);
         if (move.length() > 0.01f) {
@@ -101,22 +276,19 @@ void hero_system(Game& game, float dt) {
             }
 
             if (nearest != entt::null) {
-                auto& etf = reg.get<Transform>(nearest);
                 int dmg = HERO_BASE_DAMAGE + game.upgrades.bonus_damage() + hero.level * 3;
                 hero.attack_cooldown = std::max(0.1f, HERO_ATTACK_COOLDOWN - game.upgrades.bonus_cooldown());
 
                 // Fire a visible projectile at the enemy
-                auto proj_e = create_projectile(reg, tf.position, nearest, etf.position, dmg, DamageType::Physical,
-                                                400.0f, 0, EffectType::None, 0.0f, 0, {100, 200, 255, 255});
-
-                // Set projectile sprite
-                if (reg.valid(proj_e) && reg.all_of<Sprite>(proj_e)) {
-                    auto& proj_spr = reg.get<Sprite>(proj_e);
-                    proj_spr.texture_name = assets::PROJ_ARROW;
-                    proj_spr.width = 14.0f;
-                    proj_spr.height = 14.0f;
-                    proj_spr.color = {100, 200, 255, 255};
-                }
+                constexpr float speed = 400.0f;
+                game.play.shots.fire({.target = nearest,
+                                      .origin = tf.position,
+                                      .target_pos = lead_target(reg, nearest, tf.position, speed),
+                                      .speed = speed,
+                                      .damage = dmg,
+                                      .trail_color = {100, 200, 255, 255},
+                                      .sprite = TowerType::Arrow,
+                                      .size = 14.0f});
 
                 game.sounds.play(game.sounds.arrow_fire, 0.4f);
             }
@@ -128,7 +300,7 @@ void hero_system(Game& game, float dt) {
         }
 
         // Q - Fireball
-        if (IsKeyPressed(KEY_Q) && hero.abilities[0].ready()) {
+        if (input.held(input_bits::FIREBALL) && hero.abilities[0].ready()) {
             auto& ab = hero.abilities[0];
             ab.timer = ab.cooldown;
             game.sounds.play(game.sounds.hero_ability);
@@ -142,18 +314,18 @@ void hero_system(Game& game, float dt) {
                     create_floating_text(reg, etf.position, std::to_string(actual), {255, 100, 0, 255});
                     // Fire particles
                     for (int i = 0; i < 5; ++i) {
-                        float angle = static_cast<float>(GetRandomValue(0, 360)) * DEG2RAD;
-                        float spd = static_cast<float>(GetRandomValue(30, 80));
+                        float angle = static_cast<float>(game.rng.vfx.range(0, 360)) * DEG2RAD;
+                        float spd = static_cast<float>(game.rng.vfx.range(30, 80));
                         create_particle(reg, etf.position, {std::cos(angle) * spd, std::sin(angle) * spd},
-                                        {255, static_cast<unsigned char>(GetRandomValue(50, 200)), 0, 255}, 6.0f, 0.5f,
-                                        assets::PART_FLAME);
+                                        {255, static_cast<unsigned char>(game.rng.vfx.range(50, 200)), 0, 255}, 6.0f,
+                                        0.5f, assets::PART_FLAME);
                     }
                 }
             }
         }
 
         // E - Heal Aura
-        if (IsKeyPressed(KEY_E) && hero.abilities[1].ready()) {
+        if (input.held(input_bits::HEAL_AURA) && hero.abilities[1].ready()) {
             auto& ab = hero.abilities[1];
             ab.timer = ab.cooldown;
             game.sounds.play(game.sounds.hero_ability);
@@ -168,11 +340,11 @@ void hero_system(Game& game, float dt) {
         }
 
         // R - Lightning Strike (at mouse)
-        if (IsKeyPressed(KEY_R) && hero.abilities[2].ready()) {
+        if (input.held(input_bits::LIGHTNING) && hero.abilities[2].ready()) {
             auto& ab = hero.abilities[2];
             ab.timer = ab.cooldown;
             game.sounds.play(game.sounds.hero_ability);
-            Vec2 target = game.mouse_world();
+            Vec2 target = input.ability_target;
             auto enemies = reg.view<Enemy, Transform, Health>();
             for (auto [ee, en, etf, ehp] : enemies.each()) {
                 if (reg.all_of<Dead>(ee)) continue;
@@ -185,10 +357,10 @@ void hero_system(Game& game, float dt) {
             }
             // Lightning particles
             for (int i = 0; i < 12; ++i) {
-                float angle = static_cast<float>(GetRandomValue(0, 360)) * DEG2RAD;
-                float spd = static_cast<float>(GetRandomValue(40, 100));
+                float angle = static_cast<float>(game.rng.vfx.range(0, 360)) * DEG2RAD;
+                float spd = static_cast<float>(game.rng.vfx.range(40, 100));
                 create_particle(reg, target, {std::cos(angle) * spd, std::sin(angle) * spd},
-                                {255, 255, static_cast<unsigned char>(GetRandomValue(100, 255)), 255}, 4.0f, 0.4f,
+                                {255, 255, static_cast<unsigned char>(game.rng.vfx.range(100, 255)), 255}, 4.0f, 0.4f,
                                 assets::PART_SPARK);
             }
         }
@@ -218,6 +390,7 @@ void hero_system(Game& game, float dt) {
 // 2. Enemy Spawn System
 // ============================================================
 void enemy_spawn_system(Game& game, float dt) {
+    PROFILE_FUNCTION();
     auto& ps = game.play;
 
     if (!ps.wave_active) {
@@ -268,9 +441,9 @@ void enemy_spawn_system(Game& game, float dt) {
             scaling *= 1.3f;
 
         // Flying enemies use flying_path (shortcut)
-        auto& path = (entry.type == EnemyType::Flying && !ps.flying_path.empty()) ? ps.flying_path : ps.enemy_path;
+        auto& path = (entry.type == EnemyType::Flying && ps.flying_path) ? ps.flying_path : ps.enemy_path;
 
-        if (!path.empty()) {
+        if (path && !path->empty()) {
             create_enemy(game.registry, entry.type, path, scaling, ps.current_wave);
             ps.enemies_alive++;
         }
@@ -285,34 +458,65 @@ void enemy_spawn_system(Game& game, float dt) {
     }
 }
 
+// ============================================================
+// Stress Spawn System - unbounded enemy and tower ramp for stress mode
+// ============================================================
+void stress_system(Game& game, float dt) {
+    PROFILE_FUNCTION();
+    if (!game.stress || game.stress->finished()) return;
+    auto& st = *game.stress;
+    auto& ps = game.play;
+
+    int spawns = st.advance(dt);
+    float scaling = st.enemy_scaling();
+    for (int i = 0; i < spawns; ++i) {
+        auto type = static_cast<EnemyType>(game.rng.gameplay.range(0, static_cast<int>(EnemyType::Flying)));
+        auto& path = (type == EnemyType::Flying && ps.flying_path) ? ps.flying_path : ps.enemy_path;
+        if (!path || path->empty()) break;
+        create_enemy(game.registry, type, path, scaling, ps.current_wave);
+        ps.enemies_alive++;
+    }
+
+    // Fill buildable cells in scan order, replacing towers the enemies destroy
+    int towers = static_cast<int>(game.registry.view<Tower>().size());
+    auto& map = game.current_map;
+    for (int y = 0; y < map.rows && towers < st.tower_target(); ++y) {
+        for (int x = 0; x < map.cols && towers < st.tower_target(); ++x) {
+            if (!game.can_place_tower({x, y})) continue;
+            auto type = static_cast<TowerType>(towers % TOWER_TYPE_COUNT);
+            auto e = create_tower(game.registry, game.tower_registry.get(type, 1), {x, y}, map);
+            ps.towers.place({x, y}, e);
+            ++towers;
+        }
+    }
+}
+
 // ============================================================
 // 3. Path Follow System
 // ============================================================
-void path_follow_system(Game& game, [[maybe_unused]] float dt) {
+// Enemies advance along their path's arc-length table: position is the point `distance` along it,
+// plus any sideways offset bodies and the hero pushed them by since, which drifts back to the path
+// at PATH_RECOVERY of their speed. Effects only change the speed.
+void path_follow_system(Game& game, float dt) {
+    PROFILE_FUNCTION();
     auto& reg = game.registry;
     auto view = reg.view<PathFollower, Transform, Velocity>();
 
     for (auto [e, pf, tf, vel] : view.each()) {
         if (reg.all_of<Dead>(e)) continue;
-        if (pf.current_index >= pf.path.size()) continue;
-
-        Vec2 target = pf.path[pf.current_index];
-        Vec2 dir = target - tf.position;
-        float dist = dir.length();
-
-        // Check for slow effect
-        float speed = pf.speed;
-        if (reg.all_of<Effect>(e)) {
-            auto& eff = reg.get<Effect>(e);
-            if (eff.type == EffectType::Slow) speed *= eff.slow_factor;
-            if (eff.type == EffectType::Stun) speed = 0.0f;
-        }
-
-        if (dist < 4.0f) {
-            pf.current_index++;
-        } else {
-            vel.vel = dir.normalized() * speed;
-        }
+        if (!pf.path || pf.current_index >= pf.path->size()) continue;
+        auto& path = *pf.path;
+
+        float speed = effective_speed(reg, e, pf);
+        Vec2 offset = tf.position - path.at(pf.distance);
+        float off = offset.length();
+        float back = speed * PATH_RECOVERY * dt;
+        offset = off > back ? offset * ((off - back) / off) : Vec2{};
+
+        pf.distance = std::min(pf.distance + speed * dt, path.length());
+        pf.current_index = path.next_index(pf.distance);
+        tf.position = path.at(pf.distance) + offset;
+        vel.vel = path.direction(pf.distance) * speed;
     }
 }
 
@@ -320,7 +524,9 @@ void path_follow_system(Game& game, [[maybe_unused]] float dt) {
 // 4. Movement System
 // ============================================================
 void movement_system(Game& game, float dt) {
-    auto view = game.registry.view<Transform, Velocity>();
+    PROFILE_FUNCTION();
+    // Path followers are placed by path_follow_system
+    auto view = game.registry.view<Transform, Velocity>(entt::exclude<PathFollower>);
     for (auto [e, tf, vel] : view.each()) {
         tf.position = tf.position + vel.vel * dt;
     }
@@ -329,23 +535,140 @@ void movement_system(Game& game, float dt) {
 // ============================================================
 // 5. Tower Targeting System
 // ============================================================
-void tower_targeting_system(Game& game, [[maybe_unused]] float dt) {
+struct TargetPick {
+    entt::entity entity{entt::null};
+    float key{}; // larger is better under the tower's TargetMode
+};
+
+// How much a tower wants `e` under its mode, on the same scale pick_target ranks candidates by.
+// Empty for an enemy it can't rank (no health, or not on an indexed route).
+static std::optional<float> target_key(const entt::registry& reg, const EnemyIndex& index, const Tower& tower,
+                                       entt::entity e, Vec2 pos) {
+    auto epos = reg.get<Transform>(e).position;
+    switch (tower.target_mode) {
+    case TargetMode::First:
+    case TargetMode::Last: {
+        auto* pf = reg.try_get<PathFollower>(e);
+        auto left = pf ? index.remaining(*pf) : std::nullopt;
+        if (!left) return std::nullopt;
+        return tower.target_mode == TargetMode::First ? -*left : *left;
+    }
+    case TargetMode::Strongest:
+    case TargetMode::Weakest: {
+        auto* hp = reg.try_get<Health>(e);
+        if (!hp) return std::nullopt;
+        return tower.target_mode == TargetMode::Strongest ? static_cast<float>(hp->current)
+                                                          : -static_cast<float>(hp->current);
+    }
+    case TargetMode::Nearest:
+        return -epos.distance_to(pos);
+    }
+    return std::nullopt;
+}
+
+// Picks the target for one tower from the enemies on the stretches of path it covers
+static TargetPick pick_target(const entt::registry& reg, const EnemyIndex& index, const TowerCoverage& cov,
+                              const Tower& tower, Vec2 pos) {
+    auto in_range = [&](entt::entity e) { return reg.get<Transform>(e).position.distance_to(pos) < tower.range; };
+    auto& routes = index.routes();
+    TargetPick best;
+    auto offer = [&](entt::entity e, float key) {
+        if (best.entity == entt::null || key > best.key) best = {e, key};
+    };
+
+    if (tower.target_mode == TargetMode::First || tower.target_mode == TargetMode::Last) {
+        // On each route the first in-range enemy met walking the stretches in order is that route's
+        // pick; routes differ in length, so they are compared by distance left to the exit
+        bool first = tower.target_mode == TargetMode::First;
+        for (size_t r = 0; r < routes.size(); ++r) {
+            auto& spans = cov.spans[r];
+            auto visit = [&](const EnemyIndex::Entry& en) {
+                if (!in_range(en.entity)) return true;
+                float left = routes[r].length() - en.progress;
+                offer(en.entity, first ? -left : left);
+                return false;
+            };
+            if (first) {
+                for (auto s = spans.rbegin(); s != spans.rend(); ++s) {
+                    if (!EnemyIndex::for_each_in(routes[r], *s, true, visit)) break;
+                }
+            } else {
+                for (auto& s : spans) {
+                    if (!EnemyIndex::for_each_in(routes[r], s, false, visit)) break;
+                }
+            }
+        }
+        return best;
+    }
+
+    for (size_t r = 0; r < routes.size(); ++r) {
+        for (auto& s : cov.spans[r]) {
+            EnemyIndex::for_each_in(routes[r], s, true, [&](const EnemyIndex::Entry& en) {
+                if (!in_range(en.entity)) return true;
+                if (auto key = target_key(reg, index, tower, en.entity, pos)) offer(en.entity, *key);
+                return true;
+            });
+        }
+    }
+    return best;
+}
+
+// A tower that finds no enemy on its covered stretches of path goes dormant and costs one flag check
+// a tick until the enemy index wakes it, when an enemy walks or spawns onto one of those stretches.
+// Towers keep their target until it dies, leaves range or is out-prioritized. Only a round-robin
+// slice of retarget_budget towers searches for a better one each tick, plus any tower that has lost
+// its target and is about to fire; a tower still cooling down doesn't search at all. A found target
+// replaces a live one only when it is better by more than TARGET_SWITCH_MARGIN, so towers don't
+// flicker between enemies walking in a clump.
+void tower_targeting_system(Game& game, float dt) {
+    PROFILE_FUNCTION();
     auto& reg = game.registry;
-    auto towers = reg.view<Tower, Transform>();
-    auto enemies = reg.view<Enemy, Transform, Health>();
+    auto& index = game.enemy_index;
+    {
+        PROFILE_SCOPE("enemy_index");
+        index.update(reg);
+    }
 
+    auto towers = reg.view<Tower, Transform>();
+    size_t count = towers.size_hint();
+    size_t budget = static_cast<size_t>(std::max(0, game.retarget_budget));
+    size_t slot = 0;
+    bool rewatch = index.watched() != count; // a tower was placed or removed
     for (auto [te, tower, ttf] : towers.each()) {
-        tower.target = entt::null;
-        float best_dist = tower.range;
+        bool in_slice = count > 0 && (slot++ + count - game.play.retarget_cursor % count) % count < budget;
+
+        auto& cov = reg.get_or_emplace<TowerCoverage>(te);
+        // Exact range is checked per enemy
+        if (cov.refresh(index, ttf.position, tower.range + TARGET_PATH_SLACK)) rewatch = true;
+        if (!cov.awake) continue;
+        if (!cov.covers_enemy(index)) {
+            cov.awake = false;
+            tower.target = entt::null;
+            continue;
+        }
 
-        for (auto [ee, en, etf, ehp] : enemies.each()) {
-            if (reg.all_of<Dead>(ee)) continue;
-            float d = ttf.position.distance_to(etf.position);
-            if (d < best_dist) {
-                best_dist = d;
-                tower.target = ee;
-            }
+        auto current = tower.target;
+        bool valid = current != entt::null && reg.valid(current) && !reg.all_of<Dead>(current) &&
+                     reg.all_of<Transform>(current) &&
+                     reg.get<Transform>(current).position.distance_to(ttf.position) < tower.range;
+        if (!valid) tower.target = entt::null;
+        if (tower.cooldown - dt > RETARGET_LEAD) continue;
+        if (valid && !in_slice) continue;
+
+        auto pick = pick_target(reg, index, cov, tower, ttf.position);
+        if (valid && pick.entity != current) {
+            bool by_distance = tower.target_mode != TargetMode::Strongest && tower.target_mode != TargetMode::Weakest;
+            float margin = by_distance ? TARGET_SWITCH_MARGIN : 0.0f;
+            auto key = target_key(reg, index, tower, current, ttf.position);
+            if (key && pick.key <= *key + margin) continue;
         }
+        if (pick.entity != entt::null || !valid) tower.target = pick.entity;
+    }
+    if (count > 0) game.play.retarget_cursor = (game.play.retarget_cursor + budget) % count;
+
+    if (rewatch) {
+        index.clear_watches();
+        for (auto [te, tower, cov] : reg.view<Tower, TowerCoverage>().each()) index.watch(te, cov.spans);
     }
 }
 
@@ -353,6 +676,7 @@ void tower_targeting_system(Game& game, [[maybe_unused]] float dt) {
 // 6. Tower Attack System
 // ============================================================
 void tower_attack_system(Game& game, float dt) {
+    PROFILE_FUNCTION();
     auto& reg = game.registry;
     auto view = reg.view<Tower, Transform>();
 
@@ -364,6 +688,17 @@ void tower_attack_system(Game& game, float dt) {
             if (flash.timer <= 0.0f) reg.remove<AttackFlash>(e);
         }
 
+        // Laser impact sparks every tick the beam is on (spawned here rather than in render so
+        // headless replays create the same entities)
+        if (tower.type == TowerType::Laser && tower.target != entt::null && reg.valid(tower.target) &&
+            reg.all_of<Transform>(tower.target) && !reg.all_of<Dead>(tower.target) && game.rng.vfx.range(0, 2) == 0) {
+            auto impact = reg.get<Transform>(tower.target).position;
+            float angle = static_cast<float>(game.rng.vfx.range(0, 360)) * DEG2RAD;
+            float spd = static_cast<float>(game.rng.vfx.range(20, 50));
+            create_particle(reg, impact, {std::cos(angle) * spd, std::sin(angle) * spd}, {255, 200, 100, 255}, 3.0f,
+                            0.2f, assets::PART_SPARK);
+        }
+
         tower.cooldown -= dt;
         if (tower.cooldown > 0.0f) continue;
         if (tower.target == entt::null || !reg.valid(tower.target)) continue;
@@ -417,40 +752,42 @@ void tower_attack_system(Game& game, float dt) {
                 dtype = DamageType::Magic;
                 game.sounds.play(game.sounds.poison_fire);
                 break;
+            case TowerType::Ballista:
+                proj_color = {170, 130, 80, 255};
+                game.sounds.play(game.sounds.arrow_fire);
+                break;
             default:
                 break;
             }
 
-            auto proj_e = create_projectile(reg, tf.position, tower.target, target_tf.position, tower.damage, dtype,
-                                            PROJECTILE_SPEED, tower.aoe_radius, tower.effect, tower.effect_duration,
-                                            tower.chain_count, proj_color);
-
-            // Set projectile texture name
-            if (reg.valid(proj_e) && reg.all_of<Sprite>(proj_e)) {
-                auto& proj_spr = reg.get<Sprite>(proj_e);
-                switch (tower.type) {
-                case TowerType::Arrow:
-                    proj_spr.texture_name = assets::PROJ_ARROW;
-                    break;
-                case TowerType::Cannon:
-                    proj_spr.texture_name = assets::PROJ_CANNON;
-                    break;
-                case TowerType::Ice:
-                    proj_spr.texture_name = assets::PROJ_ICE;
-                    break;
-                case TowerType::Lightning:
-                    proj_spr.texture_name = assets::PROJ_LIGHTNING;
-                    break;
-                case TowerType::Poison:
-                    proj_spr.texture_name = assets::PROJ_POISON;
-                    break;
-                default:
-                    break;
-                }
-                // Make projectile sprites a bit bigger for visibility
-                proj_spr.width = 12.0f;
-                proj_spr.height = 12.0f;
-            }
+            if (tower.type == TowerType::Ballista) {
+                // Loosed along the line to the target's intercept point; it hits whatever is on that line
+                Vec2 aim = lead_target(reg, tower.target, tf.position, BOLT_SPEED);
+                game.play.bolts.push_back({.position = tf.position,
+                                           .direction = (aim - tf.position).normalized(),
+                                           .speed = BOLT_SPEED,
+                                           .travel = tower.range * BOLT_REACH,
+                                           .radius = BOLT_RADIUS,
+                                           .damage = tower.damage,
+                                           .pierce = std::min(tower.pierce, Bolt::MAX_HITS - 1),
+                                           .color = proj_color});
+                reg.emplace_or_replace<AttackFlash>(e, 0.15f);
+                continue;
+            }
+
+            game.play.shots.fire({.target = tower.target,
+                                  .origin = tf.position,
+                                  .target_pos = lead_target(reg, tower.target, tf.position, PROJECTILE_SPEED),
+                                  .speed = PROJECTILE_SPEED,
+                                  .damage = tower.damage,
+                                  .damage_type = dtype,
+                                  .aoe_radius = tower.aoe_radius,
+                                  .effect = tower.effect,
+                                  .effect_duration = tower.effect_duration,
+                                  .chain_count = tower.chain_count,
+                                  .trail_color = proj_color,
+                                  .sprite = tower.type,
+                                  .size = 12.0f});
 
             // Attack flash
             reg.emplace_or_replace<AttackFlash>(e, 0.15f);
@@ -461,111 +798,202 @@ void tower_attack_system(Game& game, float dt) {
 // ============================================================
 // 7. Projectile System
 // ============================================================
-void projectile_system(Game& game, [[maybe_unused]] float dt) {
+// Distance along a step (from `from`, unit `dir`, `len` long) at which a circle swept along it first
+// touches a circle of `radius` around `center`; empty if the step misses it
+static std::optional<float> sweep_entry(Vec2 from, Vec2 dir, float len, Vec2 center, float radius) {
+    Vec2 f = from - center;
+    float c = f.x * f.x + f.y * f.y - radius * radius;
+    if (c <= 0.0f) return 0.0f; // already touching
+    float b = dir.x * f.x + dir.y * f.y;
+    float disc = b * b - c;
+    if (disc < 0.0f) return std::nullopt;
+    float t = -b - std::sqrt(disc);
+    if (t < 0.0f || t > len) return std::nullopt;
+    return t;
+}
+
+// Buckets every live enemy into game.enemy_grid; returns the largest enemy collision radius
+static float build_enemy_grid(Game& game) {
+    auto& grid = game.enemy_grid;
+    grid.clear();
+    float reach = 0.0f;
+    for (auto [e, en, tf, hp] : game.registry.view<Enemy, Transform, Health>(entt::exclude<Dead>).each()) {
+        grid.insert(e, tf.position);
+        reach = std::max(reach, en.collision_radius);
+    }
+    grid.build(static_cast<float>(TILE_SIZE));
+    return reach;
+}
+
+// Moves every bolt one step and strikes the enemies the step crosses, nearest first, until its pierce
+// runs out. Candidates come from the enemy grid, so a tick costs roughly the enemies near each bolt's
+// path rather than every bolt against every enemy.
+static void sweep_bolts(Game& game, float dt, float reach) {
     auto& reg = game.registry;
-    auto view = reg.view<Projectile, Transform, Velocity>();
-
-    std::vector<entt::entity> to_destroy;
-
-    for (auto [e, proj, tf, vel] : view.each()) {
-        // Update target position if target still alive
-        Vec2 target_pos = proj.target_pos;
-        if (proj.target != entt::null && reg.valid(proj.target) && reg.all_of<Transform>(proj.target)) {
-            target_pos = reg.get<Transform>(proj.target).position;
-            proj.target_pos = target_pos;
-        }
-
-        Vec2 dir = target_pos - tf.position;
-        float dist = dir.length();
-
-        // Spawn trail particle
-        create_particle(reg, tf.position, {0, 0}, proj.trail_color, 3.0f, 0.15f);
-
-        if (dist < 12.0f) {
-            // Hit!
-            if (proj.aoe_radius > 0) {
-                // AoE damage
-                auto enemies = reg.view<Enemy, Transform, Health>();
-                for (auto [ee, en, etf, ehp] : enemies.each()) {
-                    if (reg.all_of<Dead>(ee)) continue;
-                    if (tf.position.distance_to(etf.position) <= proj.aoe_radius) {
-                        int actual = std::max(1, proj.damage - ehp.armor);
-                        ehp.current -= actual;
-                        create_floating_text(reg, etf.position, std::to_string(actual), RED);
-                        if (proj.effect != EffectType::None) {
-                            reg.emplace_or_replace<Effect>(
-                                ee, proj.effect, proj.effect_duration, 0.0f, 0.5f,
-                                proj.effect == EffectType::Poison ? 5 : (proj.effect == EffectType::Burn ? 8 : 0),
-                                proj.effect == EffectType::Slow ? 0.5f : 1.0f);
-                        }
-                    }
-                }
-                // Explosion particles
-                for (int i = 0; i < 8; ++i) {
-                    float angle = static_cast<float>(GetRandomValue(0, 360)) * DEG2RAD;
-                    float spd = static_cast<float>(GetRandomValue(30, 80));
-                    create_particle(reg, tf.position, {std::cos(angle) * spd, std::sin(angle) * spd}, proj.trail_color,
-                                    5.0f, 0.4f, assets::PART_FLAME);
+    auto& bolts = game.play.bolts;
+    auto& grid = game.enemy_grid;
+    auto& hits = game.bolt_hits;
+    size_t kept = 0;
+    for (auto& bolt : bolts) {
+        float step = std::min(bolt.speed * dt, bolt.travel);
+        Vec2 end = bolt.position + bolt.direction * step;
+        auto struck_end = bolt.hit.begin() + bolt.hit_count;
+
+        hits.clear();
+        grid.query_segment(bolt.position, end, bolt.radius + reach, [&](const SpatialGrid::Item& it) {
+            if (std::find(bolt.hit.begin(), struck_end, it.entity) != struck_end) return;
+            if (reg.get<Health>(it.entity).current <= 0) return; // killed earlier this tick
+            float r = reg.get<Enemy>(it.entity).collision_radius + bolt.radius;
+            if (auto t = sweep_entry(bolt.position, bolt.direction, step, it.pos, r)) hits.push_back({*t, it.entity});
+        });
+        std::sort(hits.begin(), hits.end());
+
+        for (auto& [t, target] : hits) {
+            if (bolt.hit_count > bolt.pierce) break;
+            bolt.hit[static_cast<size_t>(bolt.hit_count++)] = target;
+            auto& hp = reg.get<Health>(target);
+            int actual = std::max(1, bolt.damage - hp.armor);
+            hp.current -= actual;
+            create_floating_text(reg, reg.get<Transform>(target).position, std::to_string(actual), RED);
+            game.sounds.play(game.sounds.enemy_hit, 0.5f);
+        }
+
+        bolt.position = end;
+        bolt.travel -= step;
+        if (bolt.hit_count <= bolt.pierce && bolt.travel > 0.0f) bolts[kept++] = bolt;
+    }
+    bolts.resize(kept);
+}
+
+// Runs a lightning shot's whole chain the moment it lands on proj.target. Each hop strikes the nearest
+// live enemy within CHAIN_RANGE of the last one struck that the chain hasn't struck yet, for 3/4 of the
+// previous hop's damage, so a chain never bounces back and costs one grid query per hop. The hops are
+// drawn as a single fading polyline. Expects game.enemy_grid to be built for this tick.
+static void chain_lightning(Game& game, const Projectile& proj, Vec2 impact) {
+    auto& reg = game.registry;
+    ChainArc arc{.count = 1, .life = CHAIN_ARC_LIFE, .color = proj.trail_color};
+    arc.points[0] = impact;
+    std::array<entt::entity, ChainArc::MAX_POINTS> struck{};
+    struck[0] = proj.target;
+
+    Vec2 from = impact;
+    int damage = proj.damage;
+    int hops = std::min(proj.chain_count, ChainArc::MAX_POINTS - 1);
+    while (arc.count <= hops) {
+        auto struck_end = struck.begin() + arc.count;
+        entt::entity next = entt::null;
+        Vec2 next_pos{};
+        float best = CHAIN_RANGE;
+        game.enemy_grid.query(from, CHAIN_RANGE, [&](const SpatialGrid::Item& it) {
+            float d = from.distance_to(it.pos);
+            if (d >= best || std::find(struck.begin(), struck_end, it.entity) != struck_end) return;
+            if (reg.get<Health>(it.entity).current <= 0) return; // killed earlier this tick
+            best = d;
+            next = it.entity;
+            next_pos = it.pos;
+        });
+        if (next == entt::null) break;
+
+        damage = damage * 3 / 4;
+        auto& hp = reg.get<Health>(next);
+        int actual = std::max(1, damage - hp.armor);
+        hp.current -= actual;
+        create_floating_text(reg, next_pos, std::to_string(actual), RED);
+        if (proj.effect != EffectType::None) {
+            reg.emplace_or_replace<Effect>(
+                next, proj.effect, proj.effect_duration, 0.0f, 0.5f,
+                proj.effect == EffectType::Poison ? 5 : (proj.effect == EffectType::Burn ? 8 : 0),
+                proj.effect == EffectType::Slow ? 0.5f : 1.0f);
+        }
+
+        struck[static_cast<size_t>(arc.count)] = next;
+        arc.points[static_cast<size_t>(arc.count++)] = next_pos;
+        from = next_pos;
+    }
+    if (arc.count > 1) game.play.arcs.push_back(arc);
+}
+
+void projectile_system(Game& game, float dt) {
+    PROFILE_FUNCTION();
+    auto& reg = game.registry;
+    auto& shots = game.play.shots;
+
+    auto& arcs = game.play.arcs;
+    for (auto& arc : arcs) arc.life -= dt;
+    std::erase_if(arcs, [](const ChainArc& arc) { return arc.life <= 0.0f; });
+
+    // The enemy grid is built at most once a tick, and only when a blast, a chain or a bolt needs it
+    std::optional<float> reach;
+    auto grid_reach = [&] {
+        if (!reach) reach = build_enemy_grid(game);
+        return *reach;
+    };
+
+    // Shots resolve at their precomputed impact time; the ones still in the air cost nothing here
+    shots.advance(dt);
+    shots.pop_due([&](const Projectile& proj) {
+        Vec2 impact = proj.target_pos;
+        if (proj.aoe_radius > 0) {
+            // AoE damage, to the live enemies the grid has near the blast
+            grid_reach();
+            game.enemy_grid.query(impact, proj.aoe_radius, [&](const SpatialGrid::Item& it) {
+                if (impact.distance_to(it.pos) > proj.aoe_radius) return;
+                auto& ehp = reg.get<Health>(it.entity);
+                int actual = std::max(1, proj.damage - ehp.armor);
+                ehp.current -= actual;
+                create_floating_text(reg, it.pos, std::to_string(actual), RED);
+                if (proj.effect != EffectType::None) {
+                    reg.emplace_or_replace<Effect>(
+                        it.entity, proj.effect, proj.effect_duration, 0.0f, 0.5f,
+                        proj.effect == EffectType::Poison ? 5 : (proj.effect == EffectType::Burn ? 8 : 0),
+                        proj.effect == EffectType::Slow ? 0.5f : 1.0f);
                 }
-                // Screen shake for AoE
-                game.play.shake_intensity = 3.0f;
-                game.play.shake_timer = 0.15f;
-                game.sounds.play(game.sounds.enemy_hit);
-            } else {
-                // Single target
-                if (proj.target != entt::null && reg.valid(proj.target) && reg.all_of<Health>(proj.target)) {
-                    auto& hp = reg.get<Health>(proj.target);
-                    int actual = std::max(1, proj.damage - hp.armor);
-                    hp.current -= actual;
-                    auto& etf = reg.get<Transform>(proj.target);
-                    create_floating_text(reg, etf.position, std::to_string(actual), RED);
-
-                    if (proj.effect != EffectType::None) {
-                        reg.emplace_or_replace<Effect>(
-                            proj.target, proj.effect, proj.effect_duration, 0.0f, 0.5f,
-                            proj.effect == EffectType::Poison ? 5 : (proj.effect == EffectType::Burn ? 8 : 0),
-                            proj.effect == EffectType::Slow ? 0.5f : 1.0f);
-                    }
+            });
+            // Explosion particles
+            for (int i = 0; i < 8; ++i) {
+                float angle = static_cast<float>(game.rng.vfx.range(0, 360)) * DEG2RAD;
+                float spd = static_cast<float>(game.rng.vfx.range(30, 80));
+                create_particle(reg, impact, {std::cos(angle) * spd, std::sin(angle) * spd}, proj.trail_color, 5.0f,
+                                0.4f, assets::PART_FLAME);
+            }
+            // Screen shake for AoE
+            game.play.shake_intensity = 3.0f;
+            game.play.shake_timer = 0.15f;
+            game.sounds.play(game.sounds.enemy_hit);
+        } else {
+            // Single target
+            if (proj.target != entt::null && reg.valid(proj.target) && reg.all_of<Health>(proj.target)) {
+                auto& hp = reg.get<Health>(proj.target);
+                int actual = std::max(1, proj.damage - hp.armor);
+                hp.current -= actual;
+                auto& etf = reg.get<Transform>(proj.target);
+                create_floating_text(reg, etf.position, std::to_string(actual), RED);
+
+                if (proj.effect != EffectType::None) {
+                    reg.emplace_or_replace<Effect>(
+                        proj.target, proj.effect, proj.effect_duration, 0.0f, 0.5f,
+                        proj.effect == EffectType::Poison ? 5 : (proj.effect == EffectType::Burn ? 8 : 0),
+                        proj.effect == EffectType::Slow ? 0.5f : 1.0f);
                 }
+            }
 
-                // Chain lightning
-                if (proj.chain_count > 0 && proj.target != entt::null) {
-                    float chain_range = 100.0f;
-                    entt::entity chain_target = entt::null;
-                    float best = chain_range;
-                    auto enemies = reg.view<Enemy, Transform, Health>();
-                    for (auto [ee, en, etf, ehp] : enemies.each()) {
-                        if (ee == proj.target || reg.all_of<Dead>(ee)) continue;
-                        float d = tf.position.distance_to(etf.position);
-                        if (d < best) {
-                            best = d;
-                            chain_target = ee;
-                        }
-                    }
-                    if (chain_target != entt::null) {
-                        auto& ctf = reg.get<Transform>(chain_target);
-                        create_projectile(reg, tf.position, chain_target, ctf.position, proj.damage * 3 / 4,
-                                          proj.damage_type, proj.speed * 1.5f, 0, proj.effect, proj.effect_duration,
-                                          proj.chain_count - 1, proj.trail_color);
-                    }
-                }
-                game.sounds.play(game.sounds.enemy_hit, 0.5f);
+            // Chain lightning
+            if (proj.chain_count > 0 && proj.target != entt::null) {
+                grid_reach();
+                chain_lightning(game, proj, impact);
             }
-            to_destroy.push_back(e);
-        } else {
-            vel.vel = dir.normalized() * proj.speed;
+            game.sounds.play(game.sounds.enemy_hit, 0.5f);
         }
-    }
+    });
 
-    for (auto e : to_destroy) {
-        if (reg.valid(e)) reg.destroy(e);
-    }
+    if (!game.play.bolts.empty()) sweep_bolts(game, dt, grid_reach());
 }
 
 // ============================================================
 // 8. Aura System
 // ============================================================
 void aura_system(Game& game, float dt) {
+    PROFILE_FUNCTION();
     auto& reg = game.registry;
     auto view = reg.view<Aura, Transform>();
 
@@ -589,10 +1017,12 @@ void aura_system(Game& game, float dt) {
 // 9. Effect System
 // ============================================================
 void effect_system(Game& game, float dt) {
+    PROFILE_FUNCTION();
     auto& reg = game.registry;
     auto view = reg.view<Effect, Health, Transform>();
 
-    std::vector<entt::entity> to_remove;
+    auto& to_remove = game.scratch_entities;
+    to_remove.clear();
 
     for (auto [e, eff, hp, tf] : view.each()) {
         if (reg.all_of<Dead>(e)) continue;
@@ -631,6 +1061,7 @@ void damage_system([[maybe_unused]] Game& game, [[maybe_unused]] float dt) {
 // 11. Health System - Mark dead entities
 // ============================================================
 void health_system(Game& game, [[maybe_unused]] float dt) {
+    PROFILE_FUNCTION();
     auto& reg = game.registry;
     auto view = reg.view<Health>(entt::exclude<Dead, Hero, Tower>);
 
@@ -647,8 +1078,8 @@ void health_system(Game& game, [[maybe_unused]] float dt) {
                 auto& spr = reg.get<Sprite>(e);
                 int count = (en.type == EnemyType::Boss) ? 20 : 8;
                 for (int i = 0; i < count; ++i) {
-                    float angle = static_cast<float>(GetRandomValue(0, 360)) * DEG2RAD;
-                    float spd = static_cast<float>(GetRandomValue(40, 120));
+                    float angle = static_cast<float>(game.rng.vfx.range(0, 360)) * DEG2RAD;
+                    float spd = static_cast<float>(game.rng.vfx.range(40, 120));
                     create_particle(reg, tf.position, {std::cos(angle) * spd, std::sin(angle) * spd}, spr.color,
                                     (en.type == EnemyType::Boss) ? 6.0f : 4.0f, 0.6f, assets::PART_SMOKE);
                 }
@@ -678,12 +1109,13 @@ void economy_system([[maybe_unused]] Game& game, [[maybe_unused]] float dt) {}
 // 13. Collision System - Enemies reaching exit
 // ============================================================
 void collision_system(Game& game, [[maybe_unused]] float dt) {
+    PROFILE_FUNCTION();
     auto& reg = game.registry;
     auto view = reg.view<PathFollower, Transform, Enemy>();
 
     for (auto [e, pf, tf, en] : view.each()) {
         if (reg.all_of<Dead>(e)) continue;
-        if (pf.current_index >= pf.path.size()) {
+        if (!pf.path || pf.current_index >= pf.path->size()) {
             game.dispatcher.trigger(EnemyReachedExitEvent{e, 1});
             reg.emplace_or_replace<Dead>(e);
             game.play.enemies_alive--;
@@ -695,10 +1127,12 @@ void collision_system(Game& game, [[maybe_unused]] float dt) {
 // 14. Lifetime System
 // ============================================================
 void lifetime_system(Game& game, float dt) {
+    PROFILE_FUNCTION();
     auto& reg = game.registry;
     auto view = reg.view<Lifetime>();
 
-    std::vector<entt::entity> to_destroy;
+    auto& to_destroy = game.scratch_entities;
+    to_destroy.clear();
     for (auto [e, lt] : view.each()) {
         lt.remaining -= dt;
         if (lt.remaining <= 0.0f) {
@@ -715,6 +1149,7 @@ void lifetime_system(Game& game, float dt) {
 // 15. Particle System
 // ============================================================
 void particle_system(Game& game, float dt) {
+    PROFILE_FUNCTION();
     auto& reg = game.registry;
     auto view = reg.view<Particle, Lifetime>();
 
@@ -729,6 +1164,7 @@ void particle_system(Game& game, float dt) {
 // Boss System - Boss abilities
 // ============================================================
 void boss_system(Game& game, float dt) {
+    PROFILE_FUNCTION();
     auto& reg = game.registry;
     auto view = reg.view<Boss, Enemy, Transform, Health>();
 
@@ -772,28 +1208,27 @@ void boss_system(Game& game, float dt) {
                 create_floating_text(reg, tf.position, "SPEED!", RED);
                 // Red particles
                 for (int i = 0; i < 6; ++i) {
-                    float angle = static_cast<float>(GetRandomValue(0, 360)) * DEG2RAD;
+                    float angle = static_cast<float>(game.rng.vfx.range(0, 360)) * DEG2RAD;
                     create_particle(reg, tf.position, {std::cos(angle) * 40.0f, std::sin(angle) * 40.0f}, RED, 4.0f,
                                     0.5f, assets::PART_FLAME);
                 }
                 break;
             }
             case AbilityType::SpawnMinions: {
+                TRACE_SCOPE("boss_spawn_minions", "system");
                 create_floating_text(reg, tf.position, "SUMMON!", {255, 200, 50, 255});
                 float scaling = game.wave_manager.scaling(game.play.current_wave);
+                // Minions join the boss's own route at its distance, so the enemy index files them under
+                // a route it already holds instead of registering a new one per cast
+                auto pf = reg.get<PathFollower>(e);
+                if (!pf.path || pf.current_index >= pf.path->size()) break;
                 for (int i = 0; i < 3; ++i) {
-                    // Create minions at boss position - need a small path from boss to exit
-                    auto& pf = reg.get<PathFollower>(e);
-                    std::vector<Vec2> minion_path;
-                    minion_path.push_back(tf.position);
-                    // Add remaining waypoints from boss's current path
-                    for (size_t pi = pf.current_index; pi < pf.path.size(); ++pi) {
-                        minion_path.push_back(pf.path[pi]);
-                    }
-                    if (minion_path.size() > 1) {
-                        create_enemy(reg, EnemyType::Grunt, minion_path, scaling * 0.5f);
-                        game.play.enemies_alive++;
-                    }
+                    auto minion = create_enemy(reg, EnemyType::Grunt, pf.path, scaling * 0.5f);
+                    auto& mpf = reg.get<PathFollower>(minion);
+                    mpf.distance = pf.distance;
+                    mpf.current_index = pf.current_index;
+                    reg.get<Transform>(minion).position = tf.position;
+                    game.play.enemies_alive++;
                 }
                 break;
             }
@@ -812,6 +1247,7 @@ void boss_system(Game& game, float dt) {
 // Enemy Combat System - Enemies attack hero and towers
 // ============================================================
 void enemy_combat_system(Game& game, float dt) {
+    PROFILE_FUNCTION();
     auto& reg = game.registry;
     auto enemies = reg.view<Enemy, Transform>();
 
@@ -831,7 +1267,7 @@ void enemy_combat_system(Game& game, float dt) {
                 en.attack_timer = en.attack_cooldown;
                 create_floating_text(reg, htf.position, "-" + std::to_string(actual), RED);
                 // Hit particles
-                float angle = static_cast<float>(GetRandomValue(0, 360)) * DEG2RAD;
+                float angle = static_cast<float>(game.rng.vfx.range(0, 360)) * DEG2RAD;
                 create_particle(reg, htf.position, {std::cos(angle) * 30.0f, std::sin(angle) * 30.0f}, RED, 3.0f, 0.2f,
                                 assets::PART_SPARK);
                 break; // Only attack one target per tick
@@ -840,19 +1276,18 @@ void enemy_combat_system(Game& game, float dt) {
 
         if (en.attack_timer > 0.0f) continue; // Already attacked hero
 
-        // Tanks and bosses also attack towers in range
+        // Tanks and bosses also attack towers in range, looked up by the cells the range covers
         if (en.type == EnemyType::Tank || en.type == EnemyType::Boss) {
-            auto towers = reg.view<Tower, Transform, Health>();
             float best_dist = en.attack_range + 20.0f;
             entt::entity nearest_tower = entt::null;
-            for (auto [te, tower, ttf, thp] : towers.each()) {
-                if (reg.all_of<Dead>(te)) continue;
-                float d = tf.position.distance_to(ttf.position);
+            game.play.towers.for_each_near(tf.position, best_dist, [&](entt::entity te) {
+                if (!reg.all_of<Health>(te) || reg.all_of<Dead>(te)) return;
+                float d = tf.position.distance_to(reg.get<Transform>(te).position);
                 if (d < best_dist) {
                     best_dist = d;
                     nearest_tower = te;
                 }
-            }
+            });
             if (nearest_tower != entt::null) {
                 auto& thp = reg.get<Health>(nearest_tower);
                 auto& ttf = reg.get<Transform>(nearest_tower);
@@ -863,7 +1298,7 @@ void enemy_combat_system(Game& game, float dt) {
                 // Spark
                 create_particle(
                     reg, ttf.position,
-                    {static_cast<float>(GetRandomValue(-30, 30)), static_cast<float>(GetRandomValue(-30, 30))},
+                    {static_cast<float>(game.rng.vfx.range(-30, 30)), static_cast<float>(game.rng.vfx.range(-30, 30))},
                     {255, 200, 50, 255}, 3.0f, 0.3f);
             }
         }
@@ -874,6 +1309,7 @@ void enemy_combat_system(Game& game, float dt) {
 // Body Collision System - Push hero and enemies apart
 // ============================================================
 void body_collision_system(Game& game, [[maybe_unused]] float dt) {
+    PROFILE_FUNCTION();
     auto& reg = game.registry;
 
     // Hero vs enemies
@@ -902,52 +1338,58 @@ void body_collision_system(Game& game, [[maybe_unused]] float dt) {
         }
     }
 
-    // Enemy vs enemy (very light push - prevent exact overlap but don't disrupt path)
-    auto all_enemies = reg.view<Enemy, Transform, Velocity>();
-    for (auto [e1, en1, tf1, vel1] : all_enemies.each()) {
-        if (reg.all_of<Dead>(e1)) continue;
-        if (reg.all_of<Flying>(e1)) continue;
-        for (auto [e2, en2, tf2, vel2] : all_enemies.each()) {
-            if (e1 >= e2) continue; // avoid double-checking
-            if (reg.all_of<Dead>(e2)) continue;
-            if (reg.all_of<Flying>(e2)) continue;
-
-            // Use smaller effective radius so enemies can pass each other
-            float min_dist = (en1.collision_radius + en2.collision_radius) * 0.5f;
-            Vec2 diff = tf1.position - tf2.position;
-            float dist = diff.length();
-
-            if (dist < min_dist && dist > 0.01f) {
-                // Push perpendicular to average movement direction to avoid disrupting path
-                Vec2 avg_dir = (vel1.vel + vel2.vel);
-                Vec2 push_dir = diff.normalized();
-                if (avg_dir.length() > 0.1f) {
-                    avg_dir = avg_dir.normalized();
-                    // Remove component along path direction
-                    float along = push_dir.x * avg_dir.x + push_dir.y * avg_dir.y;
-                    push_dir.x -= along * avg_dir.x;
-                    push_dir.y -= along * avg_dir.y;
-                    if (push_dir.length() > 0.01f)
-                        push_dir = push_dir.normalized();
-                    else
-                        push_dir = diff.normalized();
-                }
-                Vec2 push = push_dir * ((min_dist - dist) * 0.15f);
-                tf1.position = tf1.position + push;
-                tf2.position = tf2.position - push;
-            }
-        }
+    // Enemy vs enemy (very light push - prevent exact overlap but don't disrupt path). Candidate pairs
+    // come from a uniform grid with cells as wide as the largest push distance.
+    auto& grid = game.body_grid;
+    grid.clear();
+    float reach = 0.0f;
+    for (auto [e, en, tf, vel] : reg.view<Enemy, Transform, Velocity>(entt::exclude<Dead, Flying>).each()) {
+        grid.insert(e, tf.position);
+        reach = std::max(reach, en.collision_radius);
     }
+    grid.build(reach);
+
+    grid.for_each_pair([&](const SpatialGrid::Item& a, const SpatialGrid::Item& b) {
+        auto [en1, tf1, vel1] = reg.get<Enemy, Transform, Velocity>(a.entity);
+        auto [en2, tf2, vel2] = reg.get<Enemy, Transform, Velocity>(b.entity);
+
+        // Use smaller effective radius so enemies can pass each other
+        float min_dist = (en1.collision_radius + en2.collision_radius) * 0.5f;
+        Vec2 diff = tf1.position - tf2.position;
+        float dist = diff.length();
+
+        if (dist < min_dist && dist > 0.01f) {
+            // Push perpendicular to average movement direction to avoid disrupting path
+            Vec2 avg_dir = (vel1.vel + vel2.vel);
+            Vec2 push_dir = diff.normalized();
+            if (avg_dir.length() > 0.1f) {
+                avg_dir = avg_dir.normalized();
+                // Remove component along path direction
+                float along = push_dir.x * avg_dir.x + push_dir.y * avg_dir.y;
+                push_dir.x -= along * avg_dir.x;
+                push_dir.y -= along * avg_dir.y;
+                if (push_dir.length() > 0.01f)
+                    push_dir = push_dir.normalized();
+                else
+                    push_dir = diff.normalized();
+            }
+            Vec2 push = push_dir * ((min_dist - dist) * 0.15f);
+            tf1.position = tf1.position + push;
+            tf2.position = tf2.position - push;
+        }
+    });
 }
 
 // ============================================================
 // Tower Health System - Destroy towers when HP reaches 0
 // ============================================================
 void tower_health_system(Game& game, [[maybe_unused]] float dt) {
+    PROFILE_FUNCTION();
     auto& reg = game.registry;
     auto view = reg.view<Tower, Health, Transform>();
 
-    std::vector<entt::entity> to_destroy;
+    auto& to_destroy = game.scratch_entities;
+    to_destroy.clear();
 
     for (auto [e, tower, hp, tf] : view.each()) {
         if (hp.current <= 0) {
@@ -955,8 +1397,8 @@ void tower_health_system(Game& game, [[maybe_unused]] float dt) {
             // Destruction particles
             auto& spr = reg.get<Sprite>(e);
             for (int i = 0; i < 10; ++i) {
-                float angle = static_cast<float>(GetRandomValue(0, 360)) * DEG2RAD;
-                float spd = static_cast<float>(GetRandomValue(30, 80));
+                float angle = static_cast<float>(game.rng.vfx.range(0, 360)) * DEG2RAD;
+                float spd = static_cast<float>(game.rng.vfx.range(30, 80));
                 create_particle(reg, tf.position, {std::cos(angle) * spd, std::sin(angle) * spd}, spr.color, 5.0f, 0.5f,
                                 assets::PART_SMOKE);
             }
@@ -970,7 +1412,7 @@ void tower_health_system(Game& game, [[maybe_unused]] float dt) {
         if (reg.valid(e)) {
             if (reg.all_of<GridCell>(e)) {
                 auto& gc = reg.get<GridCell>(e);
-                game.play.tower_positions.erase(gc.pos);
+                game.play.towers.remove(gc.pos);
             }
             if (game.play.selected_tower == e) {
                 game.play.selected_tower = entt::null;
@@ -985,6 +1427,7 @@ void tower_health_system(Game& game, [[maybe_unused]] float dt) {
 // Animated Sprite System - Update animation frames
 // ============================================================
 void animated_sprite_system(Game& game, float dt) {
+    PROFILE_FUNCTION();
     auto& reg = game.registry;
     auto view = reg.view<AnimatedSprite, Transform>();
 
@@ -1022,6 +1465,7 @@ void animated_sprite_system(Game& game, float dt) {
 // Coin Pickup System - Hero collects coins
 // ============================================================
 void coin_system(Game& game, float dt) {
+    PROFILE_FUNCTION();
     auto& reg = game.registry;
     auto heroes = reg.view<Hero, Transform>();
     auto coins = reg.view<Coin, Transform>();
@@ -1040,7 +1484,8 @@ void coin_system(Game& game, float dt) {
             }
         }
 
-        std::vector<entt::entity> to_collect;
+        auto& to_collect = game.scratch_entities;
+        to_collect.clear();
         for (auto [ce, coin, ctf] : coins.each()) {
             float dist = htf.position.distance_to(ctf.position);
             if (dist < pickup_radius) {
@@ -1069,8 +1514,10 @@ void coin_system(Game& game, float dt) {
 // ============================================================
 // 16. Render System
 // ============================================================
-void render_system(Game& game) {
-    auto& reg = game.registry;
+
+// Tiles and decorations never change during a match, so they are drawn once into the tile layer
+static void draw_tile_layer(Game& game) {
+    auto& gfx = *game.renderer;
     auto& map = game.current_map;
 
     // Draw tiles (biome-aware)
@@ -1120,7 +1567,7 @@ void render_system(Game& game) {
             if (tile == TileType::Buildable || tile == TileType::Spawn || tile == TileType::Exit) {
                 Texture2D* ground_tex = game.assets.get_texture(theme.ground_tex);
                 if (ground_tex) {
-                    draw_tex(ground_tex, dx, dy, ts, ts, 0, theme.ground_tint);
+                    draw_tex(gfx, ground_tex, dx, dy, ts, ts, 0, theme.ground_tint);
                 }
             }
             Texture2D* tex = tex_name ? game.assets.get_texture(tex_name) : nullptr;
@@ -1130,9 +1577,9 @@ void render_system(Game& game) {
                 if (tile == TileType::Buildable || tile == TileType::Spawn || tile == TileType::Exit) {
                     draw_tint.a = 100;
                 }
-                draw_tex(tex, dx, dy, ts, ts, 0, draw_tint);
+                draw_tex(gfx, tex, dx, dy, ts, ts, 0, draw_tint);
             } else {
-                DrawRectangle(GRID_OFFSET_X + x * TILE_SIZE, GRID_OFFSET_Y + y * TILE_SIZE, TILE_SIZE - 1,
+                gfx.rectangle(GRID_OFFSET_X + x * TILE_SIZE, GRID_OFFSET_Y + y * TILE_SIZE, TILE_SIZE - 1,
                               TILE_SIZE - 1, fallback);
             }
         }
@@ -1148,10 +1595,78 @@ void render_system(Game& game) {
             float dy = static_cast<float>(GRID_OFFSET_Y + deco.pos.y * TILE_SIZE) + TILE_SIZE / 2.0f;
             Texture2D* tex = game.assets.get_texture(deco_names[deco.texture_index]);
             if (tex) {
-                draw_tex(tex, dx, dy, 40.0f, 40.0f, 0, WHITE);
+                draw_tex(gfx, tex, dx, dy, 40.0f, 40.0f, 0, WHITE);
             }
         }
     }
+}
+
+void bake_tile_layer(Game& game) {
+    PROFILE_FUNCTION();
+    unload_tile_layer(game);
+    auto& map = game.current_map;
+    int w = map.cols * TILE_SIZE;
+    int h = map.rows * TILE_SIZE;
+
+    auto& layer = game.tile_layer;
+    layer.full = LoadRenderTexture(w, h);
+    if (layer.full.id == 0) return; // no render target support: render_system draws tiles directly
+    BeginTextureMode(layer.full);
+    ClearBackground(BLANK);
+    draw_tile_layer(game);
+    EndTextureMode();
+    SetTextureFilter(layer.full.texture, TEXTURE_FILTER_BILINEAR);
+
+    // Half-resolution copy used when zoomed out
+    layer.reduced = LoadRenderTexture(w / 2, h / 2);
+    if (layer.reduced.id != 0) {
+        BeginTextureMode(layer.reduced);
+        ClearBackground(BLANK);
+        DrawTexturePro(layer.full.texture, {0, 0, static_cast<float>(w), -static_cast<float>(h)},
+                       {0, 0, w / 2.0f, h / 2.0f}, {0, 0}, 0, WHITE);
+        EndTextureMode();
+        SetTextureFilter(layer.reduced.texture, TEXTURE_FILTER_BILINEAR);
+    }
+    layer.baked = true;
+}
+
+void unload_tile_layer(Game& game) {
+    auto& layer = game.tile_layer;
+    if (layer.full.id != 0) UnloadRenderTexture(layer.full);
+    if (layer.reduced.id != 0) UnloadRenderTexture(layer.reduced);
+    layer = {};
+}
+
+void render_system(Game& game) {
+    PROFILE_FUNCTION();
+    auto& gfx = *game.renderer;
+    auto& reg = game.registry;
+    auto& map = game.current_map;
+    auto& theme = get_biome_theme(map.name);
+    LodLevel lod = lod_for_zoom(game.camera.zoom);
+
+    // Visible world rect (with margin) for culling entities outside the view
+    Vector2 view_min = GetScreenToWorld2D({0, 0}, game.camera);
+    Vector2 view_max = GetScreenToWorld2D({static_cast<float>(SCREEN_WIDTH), static_cast<float>(SCREEN_HEIGHT)},
+                                          game.camera);
+    auto on_screen = [&](Vec2 p) {
+        constexpr float margin = 64.0f;
+        return p.x > view_min.x - margin && p.x < view_max.x + margin && p.y > view_min.y - margin &&
+               p.y < view_max.y + margin;
+    };
+
+    // Tile layer: baked texture (half resolution when zoomed out), or per-tile fallback
+    if (game.tile_layer.baked) {
+        auto& rt = (lod == LodLevel::Minimal && game.tile_layer.reduced.id != 0) ? game.tile_layer.reduced
+                                                                                 : game.tile_layer.full;
+        float tw = static_cast<float>(rt.texture.width);
+        float th = static_cast<float>(rt.texture.height);
+        gfx.texture(rt.texture, {0, 0, tw, -th},
+                    {0, 0, static_cast<float>(map.cols * TILE_SIZE), static_cast<float>(map.rows * TILE_SIZE)}, {0, 0},
+                    0, WHITE);
+    } else {
+        draw_tile_layer(game);
+    }
 
     // Grid overlay for placement
     if (game.play.placing_tower.has_value()) {
@@ -1165,14 +1680,14 @@ void render_system(Game& game) {
             // Draw biome ground base tile
             Texture2D* ground_tex = game.assets.get_texture(theme.ground_tex);
             if (ground_tex) {
-                draw_tex(ground_tex, tx + ts / 2.0f, ty + ts / 2.0f, ts, ts, 0, theme.ground_tint);
+                draw_tex(gfx, ground_tex, tx + ts / 2.0f, ty + ts / 2.0f, ts, ts, 0, theme.ground_tint);
             }
 
             // Pulsing semi-transparent border
             float pulse_alpha = 0.4f + 0.3f * std::sin(static_cast<float>(GetTime()) * 4.0f);
             Color border_color = valid ? Color{0, 255, 0, static_cast<unsigned char>(255 * pulse_alpha)}
                                        : Color{255, 0, 0, static_cast<unsigned char>(255 * pulse_alpha)};
-            DrawRectangleLinesEx({tx, ty, ts, ts}, 2.0f, border_color);
+            gfx.rectangle_lines({tx, ty, ts, ts}, 2.0f, border_color);
 
             // Tower weapon preview at 50% alpha when valid
             if (valid) {
@@ -1196,11 +1711,14 @@ void render_system(Game& game) {
                 case TowerType::Laser:
                     weapon_tex_name = assets::TOWER_LASER;
                     break;
+                case TowerType::Ballista:
+                    weapon_tex_name = assets::TOWER_BALLISTA;
+                    break;
                 }
                 if (weapon_tex_name) {
                     Texture2D* weapon_tex = game.assets.get_texture(weapon_tex_name);
                     if (weapon_tex) {
-                        draw_tex(weapon_tex, tx + ts / 2.0f, ty + ts / 2.0f, ts * 0.7f, ts * 0.7f, 0,
+                        draw_tex(gfx, weapon_tex, tx + ts / 2.0f, ty + ts / 2.0f, ts * 0.7f, ts * 0.7f, 0,
                                  {255, 255, 255, 128});
                     }
                 }
@@ -1208,7 +1726,38 @@ void render_system(Game& game) {
                 // Range indicator
                 auto& stats = game.tower_registry.get(*game.play.placing_tower, 1);
                 auto world = map.grid_to_world(gp);
-                DrawCircleLines(static_cast<int>(world.x), static_cast<int>(world.y), stats.range, {255, 255, 255, 80});
+                gfx.circle_lines(static_cast<int>(world.x), static_cast<int>(world.y), stats.range,
+                                 {255, 255, 255, 80});
+
+                // Path coverage: highlight the stretches of each route in range, and how much ground path
+                // the spot would cover. Flying enemies take the straight spawn-to-exit line.
+                TowerCoverage cov;
+                cov.refresh(game.enemy_index, world, stats.range);
+                auto& routes = game.enemy_index.routes();
+                float ground = 0.0f;
+                bool air = false;
+                for (size_t r = 0; r < routes.size(); ++r) {
+                    bool flying = game.play.flying_path && *routes[r].path == *game.play.flying_path;
+                    if (flying) {
+                        air = air || !cov.spans[r].empty();
+                    } else {
+                        ground = std::max(ground, cov.covered(r));
+                    }
+                    Color col = flying ? Color{180, 120, 255, 110} : Color{255, 220, 80, 110};
+                    auto& path = *routes[r].path;
+                    for (auto& span : cov.spans[r]) {
+                        Vec2 from = path.at(span.from);
+                        for (size_t i = 0; i < path.size(); ++i) {
+                            if (path.arc(i) <= span.from || path.arc(i) >= span.to) continue;
+                            gfx.line(from.to_raylib(), path[i].to_raylib(), 6.0f, col);
+                            from = path[i];
+                        }
+                        gfx.line(from.to_raylib(), path.at(span.to).to_raylib(), 6.0f, col);
+                    }
+                }
+                auto label = std::format("{:.1f} tiles of path{}", ground / TILE_SIZE, air ? " + air" : "");
+                Color label_col = ground > 0.0f || air ? Color{255, 230, 150, 220} : Color{255, 120, 120, 220};
+                draw_text(gfx, game.assets, label.c_str(), tx, ty + ts + 2, 12, label_col);
             }
         }
     }
@@ -1217,8 +1766,8 @@ void render_system(Game& game) {
     if (game.play.selected_tower != entt::null && reg.valid(game.play.selected_tower)) {
         auto& tower = reg.get<Tower>(game.play.selected_tower);
         auto& tf = reg.get<Transform>(game.play.selected_tower);
-        DrawCircleLines(static_cast<int>(tf.position.x), static_cast<int>(tf.position.y), tower.range,
-                        {255, 255, 255, 100});
+        gfx.circle_lines(static_cast<int>(tf.position.x), static_cast<int>(tf.position.y), tower.range,
+                         {255, 255, 255, 100});
     }
 
     // Enhanced Laser beams (3-layer beam)
@@ -1229,25 +1778,21 @@ void render_system(Game& game) {
                 reg.all_of<Transform>(tower.target) && !reg.all_of<Dead>(tower.target)) {
                 auto& etf = reg.get<Transform>(tower.target);
                 // 3-layer beam: thick dark, medium red, thin white core
-                DrawLineEx(tf.position.to_raylib(), etf.position.to_raylib(), 6.0f, {100, 0, 0, 150});
-                DrawLineEx(tf.position.to_raylib(), etf.position.to_raylib(), 3.0f, RED);
-                DrawLineEx(tf.position.to_raylib(), etf.position.to_raylib(), 1.0f, WHITE);
-                // Spark particles at impact
-                if (GetRandomValue(0, 2) == 0) {
-                    float angle = static_cast<float>(GetRandomValue(0, 360)) * DEG2RAD;
-                    float spd = static_cast<float>(GetRandomValue(20, 50));
-                    create_particle(reg, etf.position, {std::cos(angle) * spd, std::sin(angle) * spd},
-                                    {255, 200, 100, 255}, 3.0f, 0.2f, assets::PART_SPARK);
-                }
+                gfx.line(tf.position.to_raylib(), etf.position.to_raylib(), 6.0f, {100, 0, 0, 150});
+                gfx.line(tf.position.to_raylib(), etf.position.to_raylib(), 3.0f, RED);
+                gfx.line(tf.position.to_raylib(), etf.position.to_raylib(), 1.0f, WHITE);
             }
         }
     }
 
     // Draw entities sorted by layer
-    // Particles
+    // Particles (decimated at lower detail tiers)
     {
+        auto stride = static_cast<uint32_t>(lod_particle_stride(lod));
         auto view = reg.view<Particle, Transform, Lifetime>();
         for (auto [e, p, tf, lt] : view.each()) {
+            if (stride > 1 && entt::to_integral(e) % stride != 0) continue;
+            if (!on_screen(tf.position)) continue;
             float alpha = std::clamp(p.decay, 0.0f, 1.0f);
             Texture2D* tex = nullptr;
             if (!p.particle_texture.empty()) {
@@ -1255,11 +1800,11 @@ void render_system(Game& game) {
             }
             if (tex) {
                 Color tint = ColorAlpha(WHITE, alpha);
-                draw_tex(tex, tf.position.x, tf.position.y, p.size * 2.0f, p.size * 2.0f, 0, tint);
+                draw_tex(gfx, tex, tf.position.x, tf.position.y, p.size * 2.0f, p.size * 2.0f, 0, tint);
             } else {
                 auto c = p.color;
                 c.a = static_cast<unsigned char>(255.0f * alpha);
-                DrawCircleV(tf.position.to_raylib(), p.size, c);
+                gfx.circle(tf.position.to_raylib(), p.size, c);
             }
         }
     }
@@ -1269,8 +1814,16 @@ void render_system(Game& game) {
         auto view = reg.view<Enemy, Transform, Sprite>();
         for (auto [e, en, tf, spr] : view.each()) {
             if (reg.all_of<Dead>(e) || !spr.visible) continue;
+            if (!on_screen(tf.position)) continue;
             float hw = spr.width / 2, hh = spr.height / 2;
 
+            // Zoomed far out: a single flat quad per enemy
+            if (lod == LodLevel::Minimal) {
+                gfx.rectangle(static_cast<int>(tf.position.x - hw), static_cast<int>(tf.position.y - hh),
+                              static_cast<int>(spr.width), static_cast<int>(spr.height), spr.color);
+                continue;
+            }
+
             // Display size for textures - large enough to be clearly visible
             float display_size;
             switch (en.type) {
@@ -1345,7 +1898,7 @@ void render_system(Game& game) {
 
             Texture2D* tex = tex_name ? game.assets.get_texture(tex_name) : nullptr;
             if (tex) {
-                draw_tex(tex, tf.position.x, tf.position.y, display_size, display_size, rot, tint);
+                draw_tex(gfx, tex, tf.position.x, tf.position.y, display_size, display_size, rot, tint);
             } else {
                 // Procedural fallback
                 Color c = spr.color;
@@ -1361,26 +1914,26 @@ void render_system(Game& game) {
                     Vec2 perp = {-dir.y, dir.x};
                     Vec2 left = tf.position - dir * (hw * 0.5f) + perp * (hh * 0.6f);
                     Vec2 right = tf.position - dir * (hw * 0.5f) - perp * (hh * 0.6f);
-                    DrawTriangle(tip.to_raylib(), left.to_raylib(), right.to_raylib(), c);
+                    gfx.triangle(tip.to_raylib(), left.to_raylib(), right.to_raylib(), c);
                     break;
                 }
                 case EnemyType::Tank: {
-                    DrawRectangle(static_cast<int>(tf.position.x - hw), static_cast<int>(tf.position.y - hh),
+                    gfx.rectangle(static_cast<int>(tf.position.x - hw), static_cast<int>(tf.position.y - hh),
                                   static_cast<int>(spr.width), static_cast<int>(spr.height), c);
                     Color inner = {static_cast<unsigned char>(c.r * 0.6f), static_cast<unsigned char>(c.g * 0.6f),
                                    static_cast<unsigned char>(c.b * 0.6f), 255};
                     float pad = 4.0f;
-                    DrawRectangle(static_cast<int>(tf.position.x - hw + pad),
+                    gfx.rectangle(static_cast<int>(tf.position.x - hw + pad),
                                   static_cast<int>(tf.position.y - hh + pad), static_cast<int>(spr.width - pad * 2),
                                   static_cast<int>(spr.height - pad * 2), inner);
                     break;
                 }
                 case EnemyType::Healer: {
-                    DrawCircleV(tf.position.to_raylib(), hw, c);
+                    gfx.circle(tf.position.to_raylib(), hw, c);
                     Color cross = {50, 255, 50, 255};
                     float cs = hw * 0.5f;
-                    DrawLineEx({tf.position.x - cs, tf.position.y}, {tf.position.x + cs, tf.position.y}, 2.0f, cross);
-                    DrawLineEx({tf.position.x, tf.position.y - cs}, {tf.position.x, tf.position.y + cs}, 2.0f, cross);
+                    gfx.line({tf.position.x - cs, tf.position.y}, {tf.position.x + cs, tf.position.y}, 2.0f, cross);
+                    gfx.line({tf.position.x, tf.position.y - cs}, {tf.position.x, tf.position.y + cs}, 2.0f, cross);
                     break;
                 }
                 case EnemyType::Flying: {
@@ -1388,12 +1941,12 @@ void render_system(Game& game) {
                                      {tf.position.x + hw, tf.position.y},
                                      {tf.position.x, tf.position.y + hh},
                                      {tf.position.x - hw, tf.position.y}};
-                    DrawTriangle(pts[0], pts[2], pts[1], c);
-                    DrawTriangle(pts[0], pts[3], pts[2], c);
+                    gfx.triangle(pts[0], pts[2], pts[1], c);
+                    gfx.triangle(pts[0], pts[3], pts[2], c);
                     break;
                 }
                 default: {
-                    DrawRectangle(static_cast<int>(tf.position.x - hw), static_cast<int>(tf.position.y - hh),
+                    gfx.rectangle(static_cast<int>(tf.position.x - hw), static_cast<int>(tf.position.y - hh),
                                   static_cast<int>(spr.width), static_cast<int>(spr.height), c);
                     break;
                 }
@@ -1405,15 +1958,15 @@ void render_system(Game& game) {
                 float boss_r = display_size / 2.0f;
                 float pulse = 0.5f + 0.5f * std::sin(static_cast<float>(GetTime()) * 4.0f);
                 auto glow_alpha = static_cast<unsigned char>(60 + 100 * pulse);
-                DrawCircleV(tf.position.to_raylib(), boss_r + 6, {255, 200, 50, glow_alpha});
-                DrawCircleLines(static_cast<int>(tf.position.x), static_cast<int>(tf.position.y), boss_r + 3, GOLD);
+                gfx.circle(tf.position.to_raylib(), boss_r + 6, {255, 200, 50, glow_alpha});
+                gfx.circle_lines(static_cast<int>(tf.position.x), static_cast<int>(tf.position.y), boss_r + 3, GOLD);
                 if (reg.all_of<Boss>(e)) {
                     auto& boss = reg.get<Boss>(e);
                     if (boss.ability_active && boss.boss_ability == AbilityType::DamageAura) {
                         auto aura_alpha = static_cast<unsigned char>(40 + 40 * pulse);
-                        DrawCircleV(tf.position.to_raylib(), 120.0f, {255, 0, 0, aura_alpha});
-                        DrawCircleLines(static_cast<int>(tf.position.x), static_cast<int>(tf.position.y), 120.0f,
-                                        {255, 50, 50, static_cast<unsigned char>(100 + 100 * pulse)});
+                        gfx.circle(tf.position.to_raylib(), 120.0f, {255, 0, 0, aura_alpha});
+                        gfx.circle_lines(static_cast<int>(tf.position.x), static_cast<int>(tf.position.y), 120.0f,
+                                         {255, 50, 50, static_cast<unsigned char>(100 + 100 * pulse)});
                     }
                 }
             }
@@ -1421,43 +1974,89 @@ void render_system(Game& game) {
             // Healer aura ring
             if (en.type == EnemyType::Healer && reg.all_of<Aura>(e)) {
                 auto& aura = reg.get<Aura>(e);
-                DrawCircleLines(static_cast<int>(tf.position.x), static_cast<int>(tf.position.y), aura.radius,
-                                {50, 255, 50, 60});
+                gfx.circle_lines(static_cast<int>(tf.position.x), static_cast<int>(tf.position.y), aura.radius,
+                                 {50, 255, 50, 60});
             }
 
             // Health bar - sized to match display_size
-            if (reg.all_of<Health>(e)) {
+            if (lod == LodLevel::Full && reg.all_of<Health>(e)) {
                 auto& hp = reg.get<Health>(e);
                 if (hp.current < hp.max) {
                     float bar_w = display_size;
                     float bx = tf.position.x - bar_w / 2;
                     float by = tf.position.y - display_size / 2 - 6;
-                    DrawRectangle(static_cast<int>(bx), static_cast<int>(by), static_cast<int>(bar_w), 3, DARKGRAY);
-                    DrawRectangle(static_cast<int>(bx), static_cast<int>(by), static_cast<int>(bar_w * hp.ratio()), 3,
+                    gfx.rectangle(static_cast<int>(bx), static_cast<int>(by), static_cast<int>(bar_w), 3, DARKGRAY);
+                    gfx.rectangle(static_cast<int>(bx), static_cast<int>(by), static_cast<int>(bar_w * hp.ratio()), 3,
                                   GREEN);
                 }
             }
         }
     }
 
-    // Projectiles
+    // Projectiles, drawn where their straight flight puts them at the current clock
     {
-        auto view = reg.view<Projectile, Transform, Sprite>();
-        for (auto [e, proj, tf, spr] : view.each()) {
-            Texture2D* tex = nullptr;
-            if (!spr.texture_name.empty()) {
-                tex = game.assets.get_texture(spr.texture_name);
+        auto& shots = game.play.shots;
+        for (auto& proj : shots.in_flight()) {
+            Vec2 pos = shots.position(proj);
+            if (!on_screen(pos)) continue;
+            Vec2 dir = (proj.target_pos - proj.origin).normalized();
+            Color trail = proj.trail_color;
+            trail.a = 90;
+            gfx.line((pos - dir * proj.size).to_raylib(), pos.to_raylib(), 3.0f, trail);
+
+            const char* tex_name = nullptr;
+            switch (proj.sprite) {
+            case TowerType::Arrow:
+                tex_name = assets::PROJ_ARROW;
+                break;
+            case TowerType::Cannon:
+                tex_name = assets::PROJ_CANNON;
+                break;
+            case TowerType::Ice:
+                tex_name = assets::PROJ_ICE;
+                break;
+            case TowerType::Lightning:
+                tex_name = assets::PROJ_LIGHTNING;
+                break;
+            case TowerType::Poison:
+                tex_name = assets::PROJ_POISON;
+                break;
+            default:
+                break;
             }
-            if (tex) {
-                // Rotate projectile toward velocity direction
-                float rot = 0.0f;
-                if (reg.all_of<Velocity>(e)) {
-                    auto& vel = reg.get<Velocity>(e);
-                    if (vel.vel.length() > 0.1f) rot = angle_from_dir(vel.vel);
-                }
-                draw_tex(tex, tf.position.x, tf.position.y, spr.width, spr.height, rot, spr.color);
+            if (Texture2D* tex = tex_name ? game.assets.get_texture(tex_name) : nullptr) {
+                draw_tex(gfx, tex, pos.x, pos.y, proj.size, proj.size, angle_from_dir(dir), proj.trail_color);
+            } else {
+                gfx.circle(pos.to_raylib(), proj.size / 2, proj.trail_color);
+            }
+        }
+
+        Texture2D* bolt_tex = game.assets.get_texture(assets::PROJ_BOLT);
+        for (auto& bolt : game.play.bolts) {
+            if (!on_screen(bolt.position)) continue;
+            Color trail = bolt.color;
+            trail.a = 90;
+            gfx.line((bolt.position - bolt.direction * 20.0f).to_raylib(), bolt.position.to_raylib(), 3.0f, trail);
+            if (bolt_tex) {
+                // The rocket sprite points up
+                draw_tex(gfx, bolt_tex, bolt.position.x, bolt.position.y, 18.0f, 18.0f,
+                         angle_from_dir(bolt.direction) + 90.0f, WHITE);
             } else {
-                DrawCircleV(tf.position.to_raylib(), spr.width / 2, spr.color);
+                gfx.circle(bolt.position.to_raylib(), bolt.radius, bolt.color);
+            }
+        }
+
+        // Lightning chains: a coloured stroke with a white core, fading out
+        for (auto& arc : game.play.arcs) {
+            float fade = std::clamp(arc.life / CHAIN_ARC_LIFE, 0.0f, 1.0f);
+            Color glow = arc.color;
+            glow.a = static_cast<unsigned char>(200.0f * fade);
+            Color core = {255, 255, 255, static_cast<unsigned char>(255.0f * fade)};
+            for (int i = 1; i < arc.count; ++i) {
+                auto a = arc.points[static_cast<size_t>(i - 1)].to_raylib();
+                auto b = arc.points[static_cast<size_t>(i)].to_raylib();
+                gfx.line(a, b, 4.0f, glow);
+                gfx.line(a, b, 1.5f, core);
             }
         }
     }
@@ -1502,6 +2101,9 @@ void render_system(Game& game) {
             case TowerType::Laser:
                 weapon_name = assets::TOWER_LASER;
                 break;
+            case TowerType::Ballista:
+                weapon_name = assets::TOWER_BALLISTA;
+                break;
             }
 
             Texture2D* base_tex = base_name ? game.assets.get_texture(base_name) : nullptr;
@@ -1510,7 +2112,7 @@ void render_system(Game& game) {
             if (base_tex && weapon_tex) {
                 // Draw base platform at full tile size
                 float ts = static_cast<float>(TILE_SIZE);
-                draw_tex(base_tex, tf.position.x, tf.position.y, ts, ts, 0, WHITE);
+                draw_tex(gfx, base_tex, tf.position.x, tf.position.y, ts, ts, 0, WHITE);
 
                 // Calculate weapon rotation toward target
                 // Kenney TD weapon sprites face UP (north) by default, so no offset needed
@@ -1525,7 +2127,7 @@ void render_system(Game& game) {
 
                 // Draw weapon on top (90% of tile size for better visibility)
                 float ws = ts * 0.9f;
-                draw_tex(weapon_tex, tf.position.x, tf.position.y, ws, ws, weapon_rot, WHITE);
+                draw_tex(gfx, weapon_tex, tf.position.x, tf.position.y, ws, ws, weapon_rot, WHITE);
             } else {
                 // Procedural fallback
                 switch (tower.type) {
@@ -1533,28 +2135,34 @@ void render_system(Game& game) {
                     Vector2 top = {tf.position.x, tf.position.y - hh};
                     Vector2 bl = {tf.position.x - hw, tf.position.y + hh};
                     Vector2 br = {tf.position.x + hw, tf.position.y + hh};
-                    DrawTriangle(top, bl, br, spr.color);
+                    gfx.triangle(top, bl, br, spr.color);
                     break;
                 }
                 case TowerType::Cannon: {
-                    DrawCircleV(tf.position.to_raylib(), r, spr.color);
-                    DrawCircleV({tf.position.x, tf.position.y - r * 0.6f}, r * 0.3f, {50, 50, 50, 255});
+                    gfx.circle(tf.position.to_raylib(), r, spr.color);
+                    gfx.circle({tf.position.x, tf.position.y - r * 0.6f}, r * 0.3f, {50, 50, 50, 255});
                     break;
                 }
                 case TowerType::Ice:
-                    DrawPoly(tf.position.to_raylib(), 6, r, 0, spr.color);
+                    gfx.poly(tf.position.to_raylib(), 6, r, 0, spr.color);
                     break;
                 case TowerType::Lightning:
-                    DrawPoly(tf.position.to_raylib(), 4, r, 45, spr.color);
+                    gfx.poly(tf.position.to_raylib(), 4, r, 45, spr.color);
                     break;
                 case TowerType::Poison: {
-                    DrawCircleV(tf.position.to_raylib(), r, spr.color);
-                    DrawLineEx({tf.position.x, tf.position.y + r}, {tf.position.x, tf.position.y + r + 6}, 3.0f,
-                               spr.color);
+                    gfx.circle(tf.position.to_raylib(), r, spr.color);
+                    gfx.line({tf.position.x, tf.position.y + r}, {tf.position.x, tf.position.y + r + 6}, 3.0f,
+                             spr.color);
                     break;
                 }
                 case TowerType::Laser:
-                    DrawPoly(tf.position.to_raylib(), 4, r, 0, spr.color);
+                    gfx.poly(tf.position.to_raylib(), 4, r, 0, spr.color);
+                    break;
+                case TowerType::Ballista:
+                    gfx.rectangle(static_cast<int>(tf.position.x - r), static_cast<int>(tf.position.y - r * 0.3f),
+                                  static_cast<int>(r * 2), static_cast<int>(r * 0.6f), spr.color);
+                    gfx.line({tf.position.x, tf.position.y + r}, {tf.position.x, tf.position.y - r}, 4.0f,
+                             spr.color);
                     break;
                 }
             }
@@ -1564,31 +2172,31 @@ void render_system(Game& game) {
                 auto& flash = reg.get<AttackFlash>(e);
                 auto alpha = static_cast<unsigned char>(255 * (flash.timer / 0.15f));
                 Color flashColor = {255, 255, 255, alpha};
-                DrawCircleLinesV(tf.position.to_raylib(), r + 3, flashColor);
+                gfx.circle_lines(tf.position.to_raylib(), r + 3, flashColor);
             }
 
             // Tower level indicator
             if (tower.level > 1) {
                 for (int i = 0; i < tower.level - 1; ++i) {
-                    DrawCircleV({tf.position.x - 8.0f + i * 10.0f, tf.position.y + hh - 4}, 3, GOLD);
+                    gfx.circle({tf.position.x - 8.0f + i * 10.0f, tf.position.y + hh - 4}, 3, GOLD);
                 }
             }
             // Selection highlight
             if (e == game.play.selected_tower) {
-                DrawRectangleLinesEx({tf.position.x - hw - 2, tf.position.y - hh - 2, spr.width + 4, spr.height + 4}, 2,
-                                     WHITE);
+                gfx.rectangle_lines({tf.position.x - hw - 2, tf.position.y - hh - 2, spr.width + 4, spr.height + 4}, 2,
+                                    WHITE);
             }
 
             // Tower health bar
-            if (reg.all_of<Health>(e)) {
+            if (lod == LodLevel::Full && reg.all_of<Health>(e)) {
                 auto& hp = reg.get<Health>(e);
                 if (hp.current < hp.max) {
                     float bw = 40;
                     float bx = tf.position.x - bw / 2;
                     float by = tf.position.y - hh - 8;
-                    DrawRectangle(static_cast<int>(bx), static_cast<int>(by), static_cast<int>(bw), 3, DARKGRAY);
+                    gfx.rectangle(static_cast<int>(bx), static_cast<int>(by), static_cast<int>(bw), 3, DARKGRAY);
                     Color hpc = hp.ratio() > 0.5f ? LIME : (hp.ratio() > 0.25f ? YELLOW : RED);
-                    DrawRectangle(static_cast<int>(bx), static_cast<int>(by), static_cast<int>(bw * hp.ratio()), 3,
+                    gfx.rectangle(static_cast<int>(bx), static_cast<int>(by), static_cast<int>(bw * hp.ratio()), 3,
                                   hpc);
                 }
             }
@@ -1606,13 +2214,15 @@ void render_system(Game& game) {
             }
             float sz = 18.0f;
             if (tex) {
-                draw_tex(tex, tf.position.x, tf.position.y + bob_y, sz, sz, 0, WHITE);
+                draw_tex(gfx, tex, tf.position.x, tf.position.y + bob_y, sz, sz, 0, WHITE);
             } else {
-                DrawCircleV({tf.position.x, tf.position.y + bob_y}, sz / 2, GOLD);
+                gfx.circle({tf.position.x, tf.position.y + bob_y}, sz / 2, GOLD);
             }
             // Gold value text
-            auto val_text = std::format("{}g", coin.value);
-            draw_text(game.assets, val_text.c_str(), tf.position.x - 8, tf.position.y + bob_y - 14, 10, GOLD);
+            if (lod == LodLevel::Full) {
+                auto val_text = std::format("{}g", coin.value);
+                draw_text(gfx, game.assets, val_text.c_str(), tf.position.x - 8, tf.position.y + bob_y - 14, 10, GOLD);
+            }
         }
     }
 
@@ -1633,15 +2243,15 @@ void render_system(Game& game) {
                                          static_cast<float>(row * anim.frame_height),
                                          static_cast<float>(anim.frame_width), static_cast<float>(anim.frame_height)};
                     float ds = anim.display_size;
-                    draw_tex_src(tex, srcRect, tf.position.x, tf.position.y, ds, ds, 0, WHITE);
+                    draw_tex_src(gfx, tex, srcRect, tf.position.x, tf.position.y, ds, ds, 0, WHITE);
                     drew_sprite = true;
                 }
             }
 
             if (!drew_sprite) {
                 // Procedural fallback
-                DrawCircleV(tf.position.to_raylib(), spr.width / 2, spr.color);
-                DrawCircleLinesV(tf.position.to_raylib(), spr.width / 2 + 2, WHITE);
+                gfx.circle(tf.position.to_raylib(), spr.width / 2, spr.color);
+                gfx.circle_lines(tf.position.to_raylib(), spr.width / 2 + 2, WHITE);
             }
 
             // Health bar
@@ -1649,17 +2259,19 @@ void render_system(Game& game) {
             float bw = 40;
             float bx = tf.position.x - bw / 2;
             float by = tf.position.y - display_half - 8;
-            DrawRectangle(static_cast<int>(bx), static_cast<int>(by), static_cast<int>(bw), 4, DARKGRAY);
-            DrawRectangle(static_cast<int>(bx), static_cast<int>(by), static_cast<int>(bw * hp.ratio()), 4, LIME);
+            gfx.rectangle(static_cast<int>(bx), static_cast<int>(by), static_cast<int>(bw), 4, DARKGRAY);
+            gfx.rectangle(static_cast<int>(bx), static_cast<int>(by), static_cast<int>(bw * hp.ratio()), 4, LIME);
 
             // Level text
+            if (lod != LodLevel::Full) continue;
             auto lvl_text = std::format("Lv{}", hero.level);
-            draw_text(game.assets, lvl_text.c_str(), tf.position.x - 8, tf.position.y + display_half + 2, 10, WHITE);
+            draw_text(gfx, game.assets, lvl_text.c_str(), tf.position.x - 8, tf.position.y + display_half + 2, 10,
+                      WHITE);
         }
     }
 
-    // Floating text
-    {
+    // Floating text (dropped when zoomed out)
+    if (lod == LodLevel::Full) {
         auto view = reg.view<FloatingText, Transform, Lifetime>();
         for (auto [e, ft, tf, lt] : view.each()) {
             float alpha = std::clamp(lt.remaining / ft.max_time, 0.0f, 1.0f);
@@ -1667,7 +2279,7 @@ void render_system(Game& game) {
             c.a = static_cast<unsigned char>(255 * alpha);
             float y_off = (ft.max_time - lt.remaining) * ft.speed;
             float tw = measure_text(game.assets, ft.text.c_str(), 14);
-            draw_text(game.assets, ft.text.c_str(), tf.position.x - tw / 2, tf.position.y - y_off, 14, c);
+            draw_text(gfx, game.assets, ft.text.c_str(), tf.position.x - tw / 2, tf.position.y - y_off, 14, c);
         }
     }
 }
@@ -1676,6 +2288,8 @@ void render_system(Game& game) {
 // 17. UI System
 // ============================================================
 void ui_system(Game& game) {
+    PROFILE_FUNCTION();
+    auto& gfx = *game.renderer;
     auto& ps = game.play;
     auto& a = game.assets;
 
@@ -1693,28 +2307,29 @@ void ui_system(Game& game) {
     };
 
     // Top HUD bar
-    DrawRectangle(0, 0, SCREEN_WIDTH, HUD_HEIGHT, {30, 30, 40, 240});
+    gfx.rectangle(0, 0, SCREEN_WIDTH, HUD_HEIGHT, {30, 30, 40, 240});
 
-    draw_text(a, std::format("Gold: {}", ps.gold).c_str(), 10, 14, 20, GOLD);
-    draw_text(a, std::format("Lives: {}", ps.lives).c_str(), 180, 14, 20, ps.lives > 5 ? GREEN : RED);
-    draw_text(a, std::format("Wave: {}/{}", ps.current_wave, MAX_WAVES).c_str(), 340, 14, 20, WHITE);
-    draw_text(a, std::format("Kills: {}", ps.total_kills).c_str(), 520, 14, 20, LIGHTGRAY);
+    draw_text(gfx, a, std::format("Gold: {}", ps.gold).c_str(), 10, 14, 20, GOLD);
+    draw_text(gfx, a, std::format("Lives: {}", ps.lives).c_str(), 180, 14, 20, ps.lives > 5 ? GREEN : RED);
+    draw_text(gfx, a, std::format("Wave: {}/{}", ps.current_wave, MAX_WAVES).c_str(), 340, 14, 20, WHITE);
+    draw_text(gfx, a, std::format("Kills: {}", ps.total_kills).c_str(), 520, 14, 20, LIGHTGRAY);
 
     if (ps.game_speed_fast) {
-        draw_text(a, ">> FAST", 680, 14, 20, YELLOW);
+        draw_text(gfx, a, ">> FAST", 680, 14, 20, YELLOW);
     }
 
     // Difficulty indicator
     const char* diff_names[] = {"EASY", "NORMAL", "HARD"};
     Color diff_colors[] = {GREEN, WHITE, RED};
     int di = static_cast<int>(game.difficulty);
-    draw_text(a, diff_names[di], 680, 30, 12, diff_colors[di]);
+    draw_text(gfx, a, diff_names[di], 680, 30, 12, diff_colors[di]);
 
     // Hero info
     auto heroes = game.registry.view<Hero, Health>();
     for (auto [e, hero, hp] : heroes.each()) {
-        draw_text(a, std::format("Hero HP: {}/{}", hp.current, hp.max).c_str(), 780, 4, 16, LIME);
-        draw_text(a, std::format("XP: {}/{} Lv{}", hero.xp, hero.xp_to_next, hero.level).c_str(), 780, 22, 14, SKYBLUE);
+        draw_text(gfx, a, std::format("Hero HP: {}/{}", hp.current, hp.max).c_str(), 780, 4, 16, LIME);
+        draw_text(gfx, a, std::format("XP: {}/{} Lv{}", hero.xp, hero.xp_to_next, hero.level).c_str(), 780, 22, 14,
+                  SKYBLUE);
 
         // Ability cooldowns
         const char* ability_keys[] = {"Q", "E", "R"};
@@ -1722,34 +2337,38 @@ void ui_system(Game& game) {
         for (int i = 0; i < 3; ++i) {
             int ax = 980 + i * 100;
             Color ac = hero.abilities[i].ready() ? GREEN : DARKGRAY;
-            DrawRectangle(ax, 4, 90, 38, {40, 40, 50, 200});
-            DrawRectangleLinesEx({static_cast<float>(ax), 4, 90, 38}, 1, ac);
-            draw_text(a, std::format("[{}] {}", ability_keys[i], ability_names[i]).c_str(), static_cast<float>(ax + 4),
-                      8, 12, ac);
+            gfx.rectangle(ax, 4, 90, 38, {40, 40, 50, 200});
+            gfx.rectangle_lines({static_cast<float>(ax), 4, 90, 38}, 1, ac);
+            draw_text(gfx, a, std::format("[{}] {}", ability_keys[i], ability_names[i]).c_str(),
+                      static_cast<float>(ax + 4), 8, 12, ac);
             if (!hero.abilities[i].ready()) {
-                draw_text(a, std::format("{:.1f}s", hero.abilities[i].timer).c_str(), static_cast<float>(ax + 20), 24,
-                          12, RED);
+                draw_text(gfx, a, std::format("{:.1f}s", hero.abilities[i].timer).c_str(),
+                          static_cast<float>(ax + 20), 24, 12, RED);
             } else {
-                draw_text(a, "Ready", static_cast<float>(ax + 20), 24, 12, GREEN);
+                draw_text(gfx, a, "Ready", static_cast<float>(ax + 20), 24, 12, GREEN);
             }
         }
     }
 
     // Right panel - tower build menu
     int px = SCREEN_WIDTH - PANEL_WIDTH;
-    DrawRectangle(px, HUD_HEIGHT, PANEL_WIDTH, SCREEN_HEIGHT - HUD_HEIGHT, {30, 30, 40, 220});
-    draw_text(a, "TOWERS", static_cast<float>(px + 70), static_cast<float>(HUD_HEIGHT + 8), 18, WHITE);
+    gfx.rectangle(px, HUD_HEIGHT, PANEL_WIDTH, SCREEN_HEIGHT - HUD_HEIGHT, {30, 30, 40, 220});
+    draw_text(gfx, a, "TOWERS", static_cast<float>(px + 70), static_cast<float>(HUD_HEIGHT + 8), 18, WHITE);
 
-    const TowerType tower_types[] = {TowerType::Arrow,     TowerType::Cannon, TowerType::Ice,
-                                     TowerType::Lightning, TowerType::Poison, TowerType::Laser};
+    const TowerType tower_types[] = {TowerType::Arrow,  TowerType::Cannon, TowerType::Ice,     TowerType::Lightning,
+                                     TowerType::Poison, TowerType::Laser,  TowerType::Ballista};
 
-    const char* tower_descs[] = {
-        "Reliable single-target damage",    "Slow but deals AoE splash damage",      "Slows enemies in range",
-        "Chains lightning between enemies", "Poisons enemies with damage over time", "Continuous laser beam with burn"};
+    const char* tower_descs[] = {"Reliable single-target damage",
+                                 "Slow but deals AoE splash damage",
+                                 "Slows enemies in range",
+                                 "Chains lightning between enemies",
+                                 "Poisons enemies with damage over time",
+                                 "Continuous laser beam with burn",
+                                 "Bolts pierce every enemy in a line"};
 
-    const char* effect_descs[] = {"", "AoE splash", "Slow 50%", "Chain x2", "Poison DoT", "Burn DoT"};
+    const char* effect_descs[] = {"", "AoE splash", "Slow 50%", "Chain x2", "Poison DoT", "Burn DoT", "Pierce x2"};
 
-    for (int i = 0; i < 6; ++i) {
+    for (int i = 0; i < static_cast<int>(std::size(tower_types)); ++i) {
         auto& stats = game.tower_registry.get(tower_types[i], 1);
         int by = HUD_HEIGHT + 35 + i * 55;
         Rectangle btn = {static_cast<float>(px + 10), static_cast<float>(by), PANEL_WIDTH - 20.0f, 50.0f};
@@ -1760,25 +2379,26 @@ void ui_system(Game& game) {
             is_placing ? Color{60, 100, 60, 255} : (affordable ? Color{50, 50, 60, 255} : Color{40, 30, 30, 255});
         Color fg = affordable ? WHITE : DARKGRAY;
 
-        DrawRectangleRec(btn, bg);
-        DrawRectangleLinesEx(btn, 1, fg);
+        gfx.rectangle(btn, bg);
+        gfx.rectangle_lines(btn, 1, fg);
 
         // Tower color preview — use weapon texture if available
         const char* weapon_names[] = {assets::TOWER_ARROW,     assets::TOWER_CANNON, assets::TOWER_ICE,
-                                      assets::TOWER_LIGHTNING, assets::TOWER_POISON, assets::TOWER_LASER};
+                                      assets::TOWER_LIGHTNING, assets::TOWER_POISON, assets::TOWER_LASER,
+                                      assets::TOWER_BALLISTA};
         Texture2D* preview_tex = a.get_texture(weapon_names[i]);
         if (preview_tex) {
-            draw_tex(preview_tex, static_cast<float>(px + 30), static_cast<float>(by + 25), 30, 30, 0, WHITE);
+            draw_tex(gfx, preview_tex, static_cast<float>(px + 30), static_cast<float>(by + 25), 30, 30, 0, WHITE);
         } else {
-            DrawRectangle(px + 15, by + 10, 30, 30, stats.color);
+            gfx.rectangle(px + 15, by + 10, 30, 30, stats.color);
         }
 
-        draw_text(a, stats.name.c_str(), static_cast<float>(px + 52), static_cast<float>(by + 5), 16, fg);
-        draw_text(a, std::format("{}g  Dmg:{}", stats.cost, stats.damage).c_str(), static_cast<float>(px + 52),
+        draw_text(gfx, a, stats.name.c_str(), static_cast<float>(px + 52), static_cast<float>(by + 5), 16, fg);
+        draw_text(gfx, a, std::format("{}g  Dmg:{}", stats.cost, stats.damage).c_str(), static_cast<float>(px + 52),
                   static_cast<float>(by + 22), 12, fg);
         float dps =
             (tower_types[i] == TowerType::Laser) ? stats.damage / stats.fire_rate : stats.damage * stats.fire_rate;
-        draw_text(a, std::format("Rng:{:.0f} DPS:{:.0f}", stats.range, dps).c_str(), static_cast<float>(px + 52),
+        draw_text(gfx, a, std::format("Rng:{:.0f} DPS:{:.0f}", stats.range, dps).c_str(), static_cast<float>(px + 52),
                   static_cast<float>(by + 35), 10, GRAY);
 
         // Hover tooltip
@@ -1786,16 +2406,16 @@ void ui_system(Game& game) {
         if (hovered && !IsMouseButtonPressed(MOUSE_BUTTON_LEFT)) {
             int tx = px - 210;
             int ty = by;
-            DrawRectangle(tx, ty, 200, 90, {20, 20, 30, 240});
-            DrawRectangleLinesEx({static_cast<float>(tx), static_cast<float>(ty), 200, 90}, 1, GOLD);
-            draw_text(a, stats.name.c_str(), static_cast<float>(tx + 8), static_cast<float>(ty + 5), 16, GOLD);
-            draw_text(a, tower_descs[i], static_cast<float>(tx + 8), static_cast<float>(ty + 24), 10, LIGHTGRAY);
-            draw_text(a, std::format("Damage: {}  Range: {:.0f}", stats.damage, stats.range).c_str(),
+            gfx.rectangle(tx, ty, 200, 90, {20, 20, 30, 240});
+            gfx.rectangle_lines({static_cast<float>(tx), static_cast<float>(ty), 200, 90}, 1, GOLD);
+            draw_text(gfx, a, stats.name.c_str(), static_cast<float>(tx + 8), static_cast<float>(ty + 5), 16, GOLD);
+            draw_text(gfx, a, tower_descs[i], static_cast<float>(tx + 8), static_cast<float>(ty + 24), 10, LIGHTGRAY);
+            draw_text(gfx, a, std::format("Damage: {}  Range: {:.0f}", stats.damage, stats.range).c_str(),
                       static_cast<float>(tx + 8), static_cast<float>(ty + 40), 11, WHITE);
-            draw_text(a, std::format("DPS: {:.1f}  Rate: {:.2f}/s", dps, stats.fire_rate).c_str(),
+            draw_text(gfx, a, std::format("DPS: {:.1f}  Rate: {:.2f}/s", dps, stats.fire_rate).c_str(),
                       static_cast<float>(tx + 8), static_cast<float>(ty + 54), 11, WHITE);
             if (i > 0)
-                draw_text(a, effect_descs[i], static_cast<float>(tx + 8), static_cast<float>(ty + 70), 11,
+                draw_text(gfx, a, effect_descs[i], static_cast<float>(tx + 8), static_cast<float>(ty + 70), 11,
                           {200, 200, 100, 255});
         }
 
@@ -1812,13 +2432,14 @@ void ui_system(Game& game) {
         auto& tower = game.registry.get<Tower>(ps.selected_tower);
         auto& tf = game.registry.get<Transform>(ps.selected_tower);
         auto& stats_ref = game.tower_registry.get(tower.type, tower.level);
+        GridPos tower_cell = game.registry.get<GridCell>(ps.selected_tower).pos;
 
         // Convert tower world pos to screen pos
         Vector2 screen_pos = GetWorldToScreen2D(tf.position.to_raylib(), game.camera);
 
         // Popover dimensions
         float pop_w = 210;
-        float pop_h = 170;
+        float pop_h = 196; // stats, targeting row, upgrade/sell row
         bool has_hp = game.registry.all_of<Health>(ps.selected_tower);
         if (has_hp) pop_h += 18;
         // Extra space for repair button when tower is damaged
@@ -1845,36 +2466,39 @@ void ui_system(Game& game) {
         float line_start_y = screen_pos.y;
         float line_end_x = (pop_x < screen_pos.x) ? pop_x + pop_w : pop_x;
         float line_end_y = pop_y + pop_h / 2;
-        DrawLineEx({line_start_x, line_start_y}, {line_end_x, line_end_y}, 1.5f, {255, 255, 255, 60});
+        gfx.line({line_start_x, line_start_y}, {line_end_x, line_end_y}, 1.5f, {255, 255, 255, 60});
 
         // Background with rounded corners effect (draw slightly overlapping rects + border)
-        DrawRectangle(static_cast<int>(pop_x), static_cast<int>(pop_y), static_cast<int>(pop_w),
+        gfx.rectangle(static_cast<int>(pop_x), static_cast<int>(pop_y), static_cast<int>(pop_w),
                       static_cast<int>(pop_h), {22, 24, 32, 235});
-        DrawRectangleLinesEx({pop_x, pop_y, pop_w, pop_h}, 1.5f, {80, 85, 100, 200});
+        gfx.rectangle_lines({pop_x, pop_y, pop_w, pop_h}, 1.5f, {80, 85, 100, 200});
 
         // Header bar with tower name + level
-        DrawRectangle(static_cast<int>(pop_x), static_cast<int>(pop_y), static_cast<int>(pop_w), 28, {35, 38, 50, 255});
-        DrawLineEx({pop_x, pop_y + 28}, {pop_x + pop_w, pop_y + 28}, 1.0f, {80, 85, 100, 200});
+        gfx.rectangle(static_cast<int>(pop_x), static_cast<int>(pop_y), static_cast<int>(pop_w), 28, {35, 38, 50, 255});
+        gfx.line({pop_x, pop_y + 28}, {pop_x + pop_w, pop_y + 28}, 1.0f, {80, 85, 100, 200});
 
         // Tower weapon icon in header
         const char* weapon_names[] = {assets::TOWER_ARROW,     assets::TOWER_CANNON, assets::TOWER_ICE,
-                                      assets::TOWER_LIGHTNING, assets::TOWER_POISON, assets::TOWER_LASER};
+                                      assets::TOWER_LIGHTNING, assets::TOWER_POISON, assets::TOWER_LASER,
+                                      assets::TOWER_BALLISTA};
         int type_idx = static_cast<int>(tower.type);
-        Texture2D* icon_tex = (type_idx >= 0 && type_idx < 6) ? a.get_texture(weapon_names[type_idx]) : nullptr;
+        Texture2D* icon_tex = (type_idx >= 0 && type_idx < static_cast<int>(std::size(weapon_names)))
+                                  ? a.get_texture(weapon_names[type_idx])
+                                  : nullptr;
         if (icon_tex) {
-            draw_tex(icon_tex, pop_x + 16, pop_y + 14, 22, 22, 0, WHITE);
+            draw_tex(gfx, icon_tex, pop_x + 16, pop_y + 14, 22, 22, 0, WHITE);
         }
 
         // Name and level
-        draw_text(a, stats_ref.name.c_str(), pop_x + 30, pop_y + 5, 16, WHITE);
+        draw_text(gfx, a, stats_ref.name.c_str(), pop_x + 30, pop_y + 5, 16, WHITE);
 
         // Level pips
         float pip_x = pop_x + pop_w - 12 - TowerRegistry::MAX_LEVEL * 14;
         for (int p = 0; p < TowerRegistry::MAX_LEVEL; ++p) {
             Color pip_col = (p < tower.level) ? GOLD : Color{50, 52, 60, 255};
-            DrawCircle(static_cast<int>(pip_x + p * 14 + 5), static_cast<int>(pop_y + 14), 5.0f, pip_col);
-            DrawCircleLines(static_cast<int>(pip_x + p * 14 + 5), static_cast<int>(pop_y + 14), 5.0f,
-                            {80, 85, 100, 255});
+            gfx.circle(static_cast<int>(pip_x + p * 14 + 5), static_cast<int>(pop_y + 14), 5.0f, pip_col);
+            gfx.circle_lines(static_cast<int>(pip_x + p * 14 + 5), static_cast<int>(pop_y + 14), 5.0f,
+                             {80, 85, 100, 255});
         }
 
         // Stats section
@@ -1885,16 +2509,16 @@ void ui_system(Game& game) {
         // DPS calculation
         float dps = (tower.type == TowerType::Laser) ? tower.damage / tower.fire_rate : tower.damage * tower.fire_rate;
 
-        draw_text(a, "Damage", label_x, sy, 13, {160, 165, 180, 255});
-        draw_text(a, std::format("{}", tower.damage).c_str(), val_x, sy, 13, WHITE);
+        draw_text(gfx, a, "Damage", label_x, sy, 13, {160, 165, 180, 255});
+        draw_text(gfx, a, std::format("{}", tower.damage).c_str(), val_x, sy, 13, WHITE);
         sy += 17;
 
-        draw_text(a, "Range", label_x, sy, 13, {160, 165, 180, 255});
-        draw_text(a, std::format("{:.0f}", tower.range).c_str(), val_x, sy, 13, WHITE);
+        draw_text(gfx, a, "Range", label_x, sy, 13, {160, 165, 180, 255});
+        draw_text(gfx, a, std::format("{:.0f}", tower.range).c_str(), val_x, sy, 13, WHITE);
         sy += 17;
 
-        draw_text(a, "DPS", label_x, sy, 13, {160, 165, 180, 255});
-        draw_text(a, std::format("{:.1f}", dps).c_str(), val_x, sy, 13, {100, 255, 100, 255});
+        draw_text(gfx, a, "DPS", label_x, sy, 13, {160, 165, 180, 255});
+        draw_text(gfx, a, std::format("{:.1f}", dps).c_str(), val_x, sy, 13, {100, 255, 100, 255});
         sy += 17;
 
         // Effect info
@@ -1919,8 +2543,8 @@ void ui_system(Game& game) {
                 eff_col = WHITE;
                 break;
             }
-            draw_text(a, "Effect", label_x, sy, 13, {160, 165, 180, 255});
-            draw_text(a, std::format("{} {:.1f}s", eff_names[ei], tower.effect_duration).c_str(), val_x, sy, 13,
+            draw_text(gfx, a, "Effect", label_x, sy, 13, {160, 165, 180, 255});
+            draw_text(gfx, a, std::format("{} {:.1f}s", eff_names[ei], tower.effect_duration).c_str(), val_x, sy, 13,
                       eff_col);
             sy += 17;
         }
@@ -1928,17 +2552,17 @@ void ui_system(Game& game) {
         // HP bar if applicable
         if (has_hp) {
             auto& thp = game.registry.get<Health>(ps.selected_tower);
-            draw_text(a, "HP", label_x, sy, 13, {160, 165, 180, 255});
+            draw_text(gfx, a, "HP", label_x, sy, 13, {160, 165, 180, 255});
             // HP bar
             float bar_x = val_x;
             float bar_w = pop_w - val_x + pop_x - 12;
             float bar_h = 10;
-            DrawRectangle(static_cast<int>(bar_x), static_cast<int>(sy + 2), static_cast<int>(bar_w),
+            gfx.rectangle(static_cast<int>(bar_x), static_cast<int>(sy + 2), static_cast<int>(bar_w),
                           static_cast<int>(bar_h), {40, 40, 50, 255});
             Color hp_col = thp.ratio() > 0.5f ? GREEN : (thp.ratio() > 0.25f ? YELLOW : RED);
-            DrawRectangle(static_cast<int>(bar_x), static_cast<int>(sy + 2), static_cast<int>(bar_w * thp.ratio()),
+            gfx.rectangle(static_cast<int>(bar_x), static_cast<int>(sy + 2), static_cast<int>(bar_w * thp.ratio()),
                           static_cast<int>(bar_h), hp_col);
-            draw_text(a, std::format("{}/{}", thp.current, thp.max).c_str(), bar_x + 2, sy, 11, WHITE);
+            draw_text(gfx, a, std::format("{}/{}", thp.current, thp.max).c_str(), bar_x + 2, sy, 11, WHITE);
             sy += 17;
         }
 
@@ -1950,6 +2574,36 @@ void ui_system(Game& game) {
         float btn_margin = 10;
         float btn_area_w = pop_w - btn_margin * 2;
 
+        // Targeting priority row — one toggle per TargetMode
+        {
+            const char* mode_names[] = {"First", "Last", "Strong", "Weak", "Near"};
+            constexpr int mode_count = 5;
+            float mode_gap = 3;
+            float mode_h = 20;
+            float mode_w = (btn_area_w - mode_gap * (mode_count - 1)) / mode_count;
+            for (int m = 0; m < mode_count; ++m) {
+                auto mode = static_cast<TargetMode>(m);
+                bool active = tower.target_mode == mode;
+                Rectangle mbtn = {pop_x + btn_margin + m * (mode_w + mode_gap), sy, mode_w, mode_h};
+                bool m_hover = CheckCollisionPointRec(GetMousePosition(), mbtn);
+
+                Color mbg =
+                    active ? Color{70, 75, 110, 255} : (m_hover ? Color{50, 54, 70, 255} : Color{35, 38, 50, 255});
+                gfx.rectangle(mbtn, mbg);
+                gfx.rectangle_lines(mbtn, 1.0f, active ? Color{140, 150, 220, 220} : Color{70, 70, 80, 200});
+
+                float ml_w = measure_text(a, mode_names[m], 10);
+                draw_text(gfx, a, mode_names[m], mbtn.x + (mbtn.width - ml_w) / 2, mbtn.y + 5, 10,
+                          active ? WHITE : Color{160, 165, 180, 255});
+
+                if (!active && m_hover && IsMouseButtonPressed(MOUSE_BUTTON_LEFT)) {
+                    game.pending_commands.push_back({CommandType::SetTargetMode, tower.type, tower_cell, mode});
+                    play_ui_click();
+                }
+            }
+            sy += mode_h + btn_gap;
+        }
+
         // Repair button row (only if tower is damaged)
         if (has_hp) {
             auto& thp = game.registry.get<Health>(ps.selected_tower);
@@ -1962,19 +2616,16 @@ void ui_system(Game& game) {
 
                 Color rbg = can_repair ? (r_hover ? Color{50, 110, 140, 255} : Color{35, 80, 110, 255})
                                        : Color{50, 50, 55, 255};
-                DrawRectangleRec(rbtn, rbg);
-                DrawRectangleLinesEx(rbtn, 1.0f, can_repair ? Color{70, 160, 200, 200} : Color{70, 70, 80, 200});
+                gfx.rectangle(rbtn, rbg);
+                gfx.rectangle_lines(rbtn, 1.0f, can_repair ? Color{70, 160, 200, 200} : Color{70, 70, 80, 200});
 
                 auto repair_label = std::format("Repair {}g  ({} HP)", repair_cost, missing);
                 float rl_w = measure_text(a, repair_label.c_str(), 12);
-                draw_text(a, repair_label.c_str(), rbtn.x + (rbtn.width - rl_w) / 2, rbtn.y + 7, 12,
+                draw_text(gfx, a, repair_label.c_str(), rbtn.x + (rbtn.width - rl_w) / 2, rbtn.y + 7, 12,
                           can_repair ? WHITE : Color{100, 100, 110, 255});
 
                 if (can_repair && r_hover && IsMouseButtonPressed(MOUSE_BUTTON_LEFT)) {
-                    ps.gold -= repair_cost;
-                    ps.stats.gold_spent += repair_cost;
-                    thp.current = thp.max;
-                    create_floating_text(game.registry, tf.position, "REPAIRED!", {70, 200, 255, 255});
+                    game.pending_commands.push_back({CommandType::RepairTower, tower.type, tower_cell});
                     play_ui_click();
                 }
                 sy += btn_h + btn_gap;
@@ -1991,35 +2642,16 @@ void ui_system(Game& game) {
 
             Color ubg =
                 can_upgrade ? (u_hover ? Color{60, 130, 60, 255} : Color{45, 100, 45, 255}) : Color{50, 50, 55, 255};
-            DrawRectangleRec(ubtn, ubg);
-            DrawRectangleLinesEx(ubtn, 1.0f, can_upgrade ? Color{80, 180, 80, 200} : Color{70, 70, 80, 200});
+            gfx.rectangle(ubtn, ubg);
+            gfx.rectangle_lines(ubtn, 1.0f, can_upgrade ? Color{80, 180, 80, 200} : Color{70, 70, 80, 200});
 
             auto upgrade_label = std::format("Upgrade {}g", ucost);
             float ul_w = measure_text(a, upgrade_label.c_str(), 12);
-            draw_text(a, upgrade_label.c_str(), ubtn.x + (ubtn.width - ul_w) / 2, ubtn.y + 7, 12,
+            draw_text(gfx, a, upgrade_label.c_str(), ubtn.x + (ubtn.width - ul_w) / 2, ubtn.y + 7, 12,
                       can_upgrade ? WHITE : Color{100, 100, 110, 255});
 
             if (can_upgrade && u_hover && IsMouseButtonPressed(MOUSE_BUTTON_LEFT)) {
-                ps.gold -= ucost;
-                ps.stats.gold_spent += ucost;
-                tower.level++;
-                auto& new_stats = game.tower_registry.get(tower.type, tower.level);
-                tower.damage = new_stats.damage;
-                tower.range = new_stats.range;
-                tower.fire_rate = new_stats.fire_rate;
-                tower.aoe_radius = new_stats.aoe_radius;
-                tower.chain_count = new_stats.chain_count;
-                tower.effect = new_stats.effect;
-                tower.effect_duration = new_stats.effect_duration;
-                // Also heal tower to new max HP on upgrade
-                if (game.registry.all_of<Health>(ps.selected_tower)) {
-                    auto& thp = game.registry.get<Health>(ps.selected_tower);
-                    int new_max_hp = tower_max_hp(tower.type, tower.level);
-                    thp.max = new_max_hp;
-                    thp.current = new_max_hp;
-                }
-                auto& spr = game.registry.get<Sprite>(ps.selected_tower);
-                spr.color = new_stats.color;
+                game.pending_commands.push_back({CommandType::UpgradeTower, tower.type, tower_cell});
                 play_ui_click();
             }
 
@@ -2028,48 +2660,38 @@ void ui_system(Game& game) {
             Rectangle sbtn = {pop_x + btn_margin + ubtn_w + btn_gap, sy, sbtn_w, btn_h};
             bool s_hover = CheckCollisionPointRec(GetMousePosition(), sbtn);
 
-            DrawRectangleRec(sbtn, s_hover ? Color{140, 50, 50, 255} : Color{100, 40, 40, 255});
-            DrawRectangleLinesEx(sbtn, 1.0f, {180, 80, 80, 200});
+            gfx.rectangle(sbtn, s_hover ? Color{140, 50, 50, 255} : Color{100, 40, 40, 255});
+            gfx.rectangle_lines(sbtn, 1.0f, {180, 80, 80, 200});
 
             int sell_val = tower.cost / 2;
             auto sell_label = std::format("Sell +{}g", sell_val);
             float sl_w = measure_text(a, sell_label.c_str(), 12);
-            draw_text(a, sell_label.c_str(), sbtn.x + (sbtn.width - sl_w) / 2, sbtn.y + 7, 12, WHITE);
+            draw_text(gfx, a, sell_label.c_str(), sbtn.x + (sbtn.width - sl_w) / 2, sbtn.y + 7, 12, WHITE);
 
             if (s_hover && IsMouseButtonPressed(MOUSE_BUTTON_LEFT)) {
-                ps.gold += sell_val;
-                ps.stats.towers_sold++;
-                auto& gc = game.registry.get<GridCell>(ps.selected_tower);
-                ps.tower_positions.erase(gc.pos);
-                game.registry.destroy(ps.selected_tower);
+                game.pending_commands.push_back({CommandType::SellTower, tower.type, tower_cell});
                 ps.selected_tower = entt::null;
-                game.recalculate_path();
                 play_ui_click();
             }
         } else {
             // Max level — MAXED badge + sell only
-            draw_text(a, "MAX LEVEL", pop_x + btn_margin, sy + 6, 13, GOLD);
+            draw_text(gfx, a, "MAX LEVEL", pop_x + btn_margin, sy + 6, 13, GOLD);
 
             float sbtn_w = btn_area_w * 0.45f;
             Rectangle sbtn = {pop_x + pop_w - btn_margin - sbtn_w, sy, sbtn_w, btn_h};
             bool s_hover = CheckCollisionPointRec(GetMousePosition(), sbtn);
 
-            DrawRectangleRec(sbtn, s_hover ? Color{140, 50, 50, 255} : Color{100, 40, 40, 255});
-            DrawRectangleLinesEx(sbtn, 1.0f, {180, 80, 80, 200});
+            gfx.rectangle(sbtn, s_hover ? Color{140, 50, 50, 255} : Color{100, 40, 40, 255});
+            gfx.rectangle_lines(sbtn, 1.0f, {180, 80, 80, 200});
 
             int sell_val = tower.cost / 2;
             auto sell_label = std::format("Sell +{}g", sell_val);
             float sl_w = measure_text(a, sell_label.c_str(), 12);
-            draw_text(a, sell_label.c_str(), sbtn.x + (sbtn.width - sl_w) / 2, sbtn.y + 7, 12, WHITE);
+            draw_text(gfx, a, sell_label.c_str(), sbtn.x + (sbtn.width - sl_w) / 2, sbtn.y + 7, 12, WHITE);
 
             if (s_hover && IsMouseButtonPressed(MOUSE_BUTTON_LEFT)) {
-                ps.gold += sell_val;
-                ps.stats.towers_sold++;
-                auto& gc = game.registry.get<GridCell>(ps.selected_tower);
-                ps.tower_positions.erase(gc.pos);
-                game.registry.destroy(ps.selected_tower);
+                game.pending_commands.push_back({CommandType::SellTower, tower.type, tower_cell});
                 ps.selected_tower = entt::null;
-                game.recalculate_path();
                 play_ui_click();
             }
         }
@@ -2080,16 +2702,16 @@ void ui_system(Game& game) {
         // Pre-game countdown before first wave
         auto wave_text = std::format("First wave in {:.1f}s", std::max(0.0f, ps.wave_timer));
         float wtw = measure_text(a, wave_text.c_str(), 18);
-        draw_text(a, wave_text.c_str(), SCREEN_WIDTH / 2.0f - wtw / 2, static_cast<float>(SCREEN_HEIGHT - 30), 18,
+        draw_text(gfx, a, wave_text.c_str(), SCREEN_WIDTH / 2.0f - wtw / 2, static_cast<float>(SCREEN_HEIGHT - 30), 18,
                   YELLOW);
         auto space_text = "Press SPACE to start early";
         float stw = measure_text(a, space_text, 14);
-        draw_text(a, space_text, SCREEN_WIDTH / 2.0f - stw / 2, static_cast<float>(SCREEN_HEIGHT - 50), 14, GRAY);
+        draw_text(gfx, a, space_text, SCREEN_WIDTH / 2.0f - stw / 2, static_cast<float>(SCREEN_HEIGHT - 50), 14, GRAY);
     } else if (ps.wave_active) {
         // Show current wave and enemies alive
         auto rem_text = std::format("Wave {}/{}  -  {} enemies alive", ps.current_wave, MAX_WAVES, ps.enemies_alive);
         float rw = measure_text(a, rem_text.c_str(), 14);
-        draw_text(a, rem_text.c_str(), SCREEN_WIDTH / 2.0f - rw / 2, static_cast<float>(SCREEN_HEIGHT - 30), 14,
+        draw_text(gfx, a, rem_text.c_str(), SCREEN_WIDTH / 2.0f - rw / 2, static_cast<float>(SCREEN_HEIGHT - 30), 14,
                   {200, 200, 200, 200});
     }
 
@@ -2101,7 +2723,8 @@ void ui_system(Game& game) {
         float tw = measure_text(a, ps.banner.text.c_str(), font_size);
         Color c = ps.banner.color;
         c.a = static_cast<unsigned char>(255 * alpha);
-        draw_text(a, ps.banner.text.c_str(), SCREEN_WIDTH / 2.0f - tw / 2, SCREEN_HEIGHT / 2.0f - 80, font_size, c);
+        draw_text(gfx, a, ps.banner.text.c_str(), SCREEN_WIDTH / 2.0f - tw / 2, SCREEN_HEIGHT / 2.0f - 80, font_size,
+                  c);
     }
 
     // Tutorial overlay
@@ -2115,18 +2738,119 @@ void ui_system(Game& game) {
         float tw = measure_text(a, hints[step], 16);
         float tx = SCREEN_WIDTH / 2.0f - tw / 2.0f - 10;
         float ty = SCREEN_HEIGHT / 2.0f + 40;
-        DrawRectangle(static_cast<int>(tx - 5), static_cast<int>(ty - 5), static_cast<int>(tw + 20), 30,
+        gfx.rectangle(static_cast<int>(tx - 5), static_cast<int>(ty - 5), static_cast<int>(tw + 20), 30,
                       {0, 0, 0, 180});
-        DrawRectangleLinesEx({tx - 5, ty - 5, tw + 20, 30.0f}, 1, GOLD);
-        draw_text(a, hints[step], tx + 5, ty + 2, 16, GOLD);
+        gfx.rectangle_lines({tx - 5, ty - 5, tw + 20, 30.0f}, 1, GOLD);
+        draw_text(gfx, a, hints[step], tx + 5, ty + 2, 16, GOLD);
         auto dismiss_text = "[TAB to dismiss]";
         float dw = measure_text(a, dismiss_text, 10);
-        draw_text(a, dismiss_text, SCREEN_WIDTH / 2.0f - dw / 2, ty + 28, 10, GRAY);
+        draw_text(gfx, a, dismiss_text, SCREEN_WIDTH / 2.0f - dw / 2, ty + 28, 10, GRAY);
     }
 
     // Controls help
-    draw_text(a, "WASD:Move  Q:Fire  E:Heal  R:Lightning  P:Pause  F:Speed  M:Mute  ESC:Menu", 10,
+    draw_text(gfx, a, "WASD:Move  Q:Fire  E:Heal  R:Lightning  P:Pause  F:Speed  M:Mute  ESC:Menu", 10,
               static_cast<float>(SCREEN_HEIGHT - 18), 12, {150, 150, 150, 180});
 }
 
+// ============================================================
+// 18. Profiler Overlay (F3) - per-system frame times and pool sizes
+// ============================================================
+void profiler_overlay(Game& game) {
+    auto& gfx = *game.renderer;
+    auto& prof = profiler();
+    auto& a = game.assets;
+    static constexpr Color palette[] = {RED,  ORANGE, YELLOW, LIME, GREEN,   SKYBLUE,   BLUE,     PURPLE,
+                                        PINK, BEIGE,  MAROON, GOLD, MAGENTA, DARKGREEN, DARKBLUE, DARKPURPLE};
+    auto slot_color = [](int slot) { return palette[slot % static_cast<int>(std::size(palette))]; };
+
+    constexpr int x0 = 10;
+    constexpr int y0 = HUD_HEIGHT + 50;
+    constexpr int graph_h = 100;
+    constexpr float ms_to_px = graph_h / 33.3f; // 33 ms fills the graph
+    int frames = static_cast<int>(prof.frame_count());
+    int graph_w = static_cast<int>(Profiler::HISTORY) * 2;
+    gfx.rectangle(x0 - 6, y0 - 6, graph_w + 12 + 330, 470, {0, 0, 0, 200});
+
+    // Stacked bars, newest on the right; the grey backdrop is the whole frame
+    int slots = prof.slot_count();
+    for (int age = 0; age < frames; ++age) {
+        auto& f = prof.frame(static_cast<size_t>(age));
+        int x = x0 + graph_w - 2 * (age + 1);
+        int frame_h = std::min(graph_h, static_cast<int>(static_cast<float>(f.total_ns) / 1e6f * ms_to_px));
+        gfx.rectangle(x, y0 + graph_h - frame_h, 2, frame_h, {80, 80, 80, 255});
+        float stacked = 0.0f;
+        for (int sl = 0; sl < slots && stacked < graph_h; ++sl) {
+            float h = static_cast<float>(f.slot_ns[sl]) / 1e6f * ms_to_px;
+            if (h <= 0.0f) continue;
+            h = std::min(h, graph_h - stacked);
+            gfx.rectangle({static_cast<float>(x), y0 + graph_h - stacked - h, 2.0f, h}, slot_color(sl));
+            stacked += h;
+        }
+    }
+    for (float budget : {16.6f, 33.3f}) {
+        int y = y0 + graph_h - static_cast<int>(budget * ms_to_px);
+        gfx.line(x0, y, x0 + graph_w, y, {255, 255, 255, 90});
+        draw_text(gfx, a, std::format("{:.1f} ms", budget).c_str(), static_cast<float>(x0 + graph_w + 4),
+                  static_cast<float>(y - 6), 10, LIGHTGRAY);
+    }
+
+    // Per-system table, heaviest first
+    std::vector<std::pair<int, Profiler::Stats>> rows;
+    for (int sl = 0; sl < slots; ++sl) {
+        auto st = prof.slot_stats(sl);
+        if (st.max_ms > 0.0) rows.push_back({sl, st});
+    }
+    std::sort(rows.begin(), rows.end(), [](auto& l, auto& r) { return l.second.avg_ms > r.second.avg_ms; });
+
+    // Allocation builds add average allocations and KB per frame
+    auto alloc_cols = [](const Profiler::AllocStats& as) {
+        return ALLOC_TRACKING ? std::format("{:>8.1f}{:>8.1f}", as.avg_count, as.avg_bytes / 1024.0) : std::string{};
+    };
+    float ty = static_cast<float>(y0 + graph_h + 10);
+
+    // Last frame's draw calls as raylib batches them
+    auto& ds = gfx.last_frame();
+    auto draws = std::format("draws {} ({} tex, {} text, {} shape)  batches {}  tex switches {}  flushes {}  "
+                             "overdraw {:.2f}x",
+                             ds.draws, ds.texture_draws, ds.text_draws, ds.shape_draws, ds.batches,
+                             ds.texture_switches, ds.flushes, ds.overdraw(SCREEN_WIDTH, SCREEN_HEIGHT));
+    draw_text(gfx, a, draws.c_str(), static_cast<float>(x0), ty, 12, SKYBLUE);
+    ty += 18;
+
+    auto fs = prof.frame_stats();
+    auto header = std::format("{:<24}{:>8}{:>8}{:>8}{:>8}", "ms", "min", "avg", "max", "p99");
+    if (ALLOC_TRACKING) header += std::format("{:>8}{:>8}", "allocs", "KB");
+    draw_text(gfx, a, header.c_str(), static_cast<float>(x0), ty, 12, GRAY);
+    ty += 14;
+    auto frame_row = std::format("{:<24}{:>8.2f}{:>8.2f}{:>8.2f}{:>8.2f}", "frame", fs.min_ms, fs.avg_ms, fs.max_ms,
+                                 fs.p99_ms) +
+                     alloc_cols(prof.frame_alloc_stats());
+    draw_text(gfx, a, frame_row.c_str(), static_cast<float>(x0), ty, 12, WHITE);
+    ty += 14;
+    for (auto& [sl, st] : rows) {
+        if (ty > y0 + 450) break;
+        gfx.rectangle(x0, static_cast<int>(ty) + 2, 8, 8, slot_color(sl));
+        auto row = std::format("  {:<22}{:>8.2f}{:>8.2f}{:>8.2f}{:>8.2f}", prof.slot_name(sl), st.min_ms, st.avg_ms,
+                               st.max_ms, st.p99_ms) +
+                   alloc_cols(prof.slot_alloc_stats(sl));
+        draw_text(gfx, a, row.c_str(), static_cast<float>(x0), ty, 12, LIGHTGRAY);
+        ty += 14;
+    }
+
+    // Component churn: creations and destructions per frame, busiest first, with pool sizes
+    float px = static_cast<float>(x0 + graph_w + 60);
+    float py = static_cast<float>(y0);
+    auto churn_header = std::format("{:<14}{:>7}{:>7}{:>7}{:>7}", "churn", "new/f", "del/f", "size", "cap");
+    draw_text(gfx, a, churn_header.c_str(), px, py, 12, GRAY);
+    py += 14;
+    for (auto& r : game.churn.rows()) {
+        if (py > y0 + 450) break;
+        // Highlight pools that turn over more than a tenth of their population every frame
+        bool hot = r.created > 0.1 * static_cast<double>(std::max<size_t>(r.size, 1));
+        auto row = std::format("{:<14}{:>7.1f}{:>7.1f}{:>7}{:>7}", r.name, r.created, r.destroyed, r.size, r.capacity);
+        draw_text(gfx, a, row.c_str(), px, py, 12, hot ? ORANGE : LIGHTGRAY);
+        py += 14;
+    }
+}
+
 } // namespace ls::systems
@@ -7,8 +7,13 @@ struct Game;
 
 namespace ls::systems {
 
+// One simulation tick: dead-entity cleanup, then every gameplay system below in update order
+void simulate(Game& game, float dt);
+
+void command_system(Game& game);
 void hero_system(Game& game, float dt);
 void enemy_spawn_system(Game& game, float dt);
+void stress_system(Game& game, float dt);
 void path_follow_system(Game& game, float dt);
 void movement_system(Game& game, float dt);
 void tower_targeting_system(Game& game, float dt);
@@ -28,7 +33,10 @@ void body_collision_system(Game& game, float dt);
 void tower_health_system(Game& game, float dt);
 void animated_sprite_system(Game& game, float dt);
 void coin_system(Game& game, float dt);
+void bake_tile_layer(Game& game);
+void unload_tile_layer(Game& game);
 void render_system(Game& game);
 void ui_system(Game& game);
+void profiler_overlay(Game& game);
 
 } // namespace ls::systems
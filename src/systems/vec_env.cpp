@@ -0,0 +1,219 @@
+#include "vec_env.hpp"
+#include "core/game.hpp"
+#include "core/profiler.hpp"
+#include "match.hpp"
+#include "systems.hpp"
+#include <algorithm>
+#include <format>
+
+namespace ls {
+
+struct EnvInstance {
+    Game game;
+    size_t index{};
+    uint32_t episode{};
+    EnvStatus status{EnvStatus::Running};
+    std::vector<std::pair<float, entt::entity>> ranked; // live enemies by path progress, reused every step
+};
+
+static void on_game_over(EnvInstance& inst, const GameOverEvent&) { inst.status = EnvStatus::Lost; }
+
+static void on_victory(EnvInstance& inst, const VictoryEvent&) { inst.status = EnvStatus::Won; }
+
+static VecEnvConfig normalized(VecEnvConfig c) {
+    c.instances = std::max(1, c.instances);
+    c.threads = std::clamp(c.threads, 1, c.instances);
+    c.ticks_per_step = std::max(1, c.ticks_per_step);
+    return c;
+}
+
+// Fraction of its route an enemy has covered, 0 at the spawn and 1 at the exit
+static float path_progress(const PathFollower& pf) {
+    if (!pf.path || pf.path->length() <= 0.0f) return 0.0f;
+    return std::clamp(pf.distance / pf.path->length(), 0.0f, 1.0f);
+}
+
+VecEnv::VecEnv(const MapData& map, VecEnvConfig config)
+    : map_(map), config_(normalized(config)), start_(config_.threads + 1), finish_(config_.threads + 1) {
+    instances_.reserve(static_cast<size_t>(config_.instances));
+    for (int i = 0; i < config_.instances; ++i) {
+        auto& inst = *instances_.emplace_back(std::make_unique<EnvInstance>());
+        inst.index = static_cast<size_t>(i);
+        inst.game.current_map = map_;
+        inst.game.difficulty = config_.difficulty;
+        inst.ranked.reserve(256);
+        connect_match_events(inst.game);
+        inst.game.dispatcher.sink<GameOverEvent>().connect<&on_game_over>(inst);
+        inst.game.dispatcher.sink<VictoryEvent>().connect<&on_victory>(inst);
+    }
+    if (config_.threads > 1) {
+        workers_.reserve(static_cast<size_t>(config_.threads));
+        for (int t = 0; t < config_.threads; ++t) workers_.emplace_back([this, t] { worker(t); });
+    }
+}
+
+VecEnv::~VecEnv() {
+    if (workers_.empty()) return;
+    stopping_.store(true, std::memory_order_relaxed);
+    start_.arrive_and_wait(); // the workers see stopping_ and return; jthread joins them
+}
+
+const Game& VecEnv::game(int instance) const { return instances_[static_cast<size_t>(instance)]->game; }
+
+std::expected<void, std::string> VecEnv::check(const EnvObservations& obs) const {
+    auto n = static_cast<size_t>(config_.instances);
+    auto fits = [&](size_t have, size_t per_instance, const char* name) -> std::expected<void, std::string> {
+        if (have >= per_instance * n) return {};
+        return std::unexpected(std::format("{} buffer holds {} values, {} needed", name, have, per_instance * n));
+    };
+    if (auto r = fits(obs.grid.size(), grid_size(), "grid"); !r) return r;
+    if (auto r = fits(obs.enemies.size(), enemies_size(), "enemies"); !r) return r;
+    if (auto r = fits(obs.globals.size(), globals_size(), "globals"); !r) return r;
+    return fits(obs.done.size(), 1, "done");
+}
+
+std::expected<void, std::string> VecEnv::reset(const EnvObservations& obs) {
+    if (auto r = check(obs); !r) return r;
+    resetting_ = true;
+    obs_ = &obs;
+    run();
+    return {};
+}
+
+std::expected<void, std::string> VecEnv::step(std::span<const EnvAction> actions, const EnvObservations& obs) {
+    if (actions.size() != static_cast<size_t>(config_.instances)) {
+        return std::unexpected(std::format("{} actions for {} instances", actions.size(), config_.instances));
+    }
+    if (auto r = check(obs); !r) return r;
+    resetting_ = false;
+    actions_ = actions;
+    obs_ = &obs;
+    run();
+    return {};
+}
+
+void VecEnv::run() {
+    if (workers_.empty()) {
+        run_slice(0, config_.instances);
+        return;
+    }
+    start_.arrive_and_wait();
+    finish_.arrive_and_wait();
+}
+
+void VecEnv::run_slice(int first, int last) {
+    for (int i = first; i < last; ++i) {
+        auto& inst = *instances_[static_cast<size_t>(i)];
+        if (resetting_) {
+            start_episode(inst);
+        } else {
+            advance(inst, actions_[static_cast<size_t>(i)]);
+        }
+        observe(inst, *obs_);
+    }
+}
+
+void VecEnv::worker(int index) {
+    profile_this_thread = false;
+    int n = config_.instances;
+    int first = n * index / config_.threads;
+    int last = n * (index + 1) / config_.threads;
+    for (;;) {
+        start_.arrive_and_wait();
+        if (stopping_.load(std::memory_order_relaxed)) return;
+        run_slice(first, last);
+        finish_.arrive_and_wait();
+    }
+}
+
+void VecEnv::start_episode(EnvInstance& inst) {
+    auto& g = inst.game;
+    reset_match(g);
+    setup_new_match(g);
+    g.rng.seed(config_.seed + inst.episode * static_cast<uint32_t>(config_.instances) +
+               static_cast<uint32_t>(inst.index));
+    g.input.buttons = 0;
+    g.input.commands.clear();
+    inst.status = EnvStatus::Running;
+    ++inst.episode;
+}
+
+void VecEnv::advance(EnvInstance& inst, const EnvAction& action) {
+    if (inst.status != EnvStatus::Running) start_episode(inst);
+    auto& g = inst.game;
+    auto& in = g.input;
+    in.buttons = action.buttons;
+    in.ability_target = action.ability_target;
+    in.commands.clear();
+    if (action.command) in.commands.push_back(*action.command);
+    for (int t = 0; t < config_.ticks_per_step && inst.status == EnvStatus::Running; ++t) {
+        systems::command_system(g);
+        in.commands.clear();
+        systems::simulate(g, TICK);
+    }
+}
+
+void VecEnv::observe(EnvInstance& inst, const EnvObservations& obs) {
+    auto& g = inst.game;
+    auto& reg = g.registry;
+    auto& ps = g.play;
+    auto& map = g.current_map;
+    float world_w = static_cast<float>(map.cols * TILE_SIZE);
+    float world_h = static_cast<float>(map.rows * TILE_SIZE);
+
+    auto grid = obs.grid.subspan(inst.index * grid_size(), grid_size());
+    auto cell = [&](GridPos p) { return grid.subspan(static_cast<size_t>((p.y * map.cols + p.x) * GRID_CHANNELS)); };
+    std::fill(grid.begin(), grid.end(), 0.0f);
+    for (int y = 0; y < map.rows; ++y) {
+        for (int x = 0; x < map.cols; ++x) {
+            auto c = cell({x, y});
+            auto tile = map.tile_at({x, y});
+            c[0] = g.can_place_tower({x, y}) ? 1.0f : 0.0f;
+            c[1] = tile == TileType::Path || tile == TileType::Spawn || tile == TileType::Exit ? 1.0f : 0.0f;
+        }
+    }
+    for (auto [e, tower, gc] : reg.view<Tower, GridCell>().each()) {
+        if (map.in_bounds(gc.pos)) cell(gc.pos)[2] = static_cast<float>(tower.level) / TowerRegistry::MAX_LEVEL;
+    }
+
+    inst.ranked.clear();
+    for (auto [e, enemy, tf, pf] : reg.view<Enemy, Transform, PathFollower>(entt::exclude<Dead>).each()) {
+        if (auto gp = map.world_to_grid(tf.position); map.in_bounds(gp)) cell(gp)[3] += 1.0f;
+        inst.ranked.push_back({path_progress(pf), e});
+    }
+    auto shown = std::min(inst.ranked.size(), static_cast<size_t>(MAX_ENEMIES));
+    std::partial_sort(inst.ranked.begin(), inst.ranked.begin() + static_cast<std::ptrdiff_t>(shown), inst.ranked.end(),
+                      [](auto& a, auto& b) { return a.first > b.first; });
+    auto enemies = obs.enemies.subspan(inst.index * enemies_size(), enemies_size());
+    std::fill(enemies.begin(), enemies.end(), 0.0f);
+    for (size_t i = 0; i < shown; ++i) {
+        auto [progress, e] = inst.ranked[i];
+        auto row = enemies.subspan(i * ENEMY_FEATURES, ENEMY_FEATURES);
+        auto pos = reg.get<Transform>(e).position;
+        auto* hp = reg.try_get<Health>(e);
+        row[0] = 1.0f;
+        row[1] = pos.x / world_w;
+        row[2] = pos.y / world_h;
+        row[3] = hp ? hp->ratio() : 1.0f;
+        row[4] = static_cast<float>(reg.get<Enemy>(e).type);
+        row[5] = progress;
+    }
+
+    auto globals = obs.globals.subspan(inst.index * globals_size(), globals_size());
+    std::fill(globals.begin(), globals.end(), 0.0f);
+    globals[0] = static_cast<float>(ps.gold);
+    globals[1] = static_cast<float>(ps.lives);
+    globals[2] = static_cast<float>(ps.current_wave);
+    globals[3] = static_cast<float>(ps.enemies_alive);
+    if (reg.valid(ps.hero)) {
+        auto pos = reg.get<Transform>(ps.hero).position;
+        globals[4] = pos.x / world_w;
+        globals[5] = pos.y / world_h;
+        globals[6] = reg.get<Health>(ps.hero).ratio();
+    }
+    globals[7] = ps.wave_active ? 1.0f : 0.0f;
+
+    obs.done[inst.index] = static_cast<uint8_t>(inst.status);
+}
+
+} // namespace ls
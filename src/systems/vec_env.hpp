@@ -0,0 +1,106 @@
+#pragma once
+#include "core/input.hpp"
+#include "core/types.hpp"
+#include "managers/map_manager.hpp"
+#include <atomic>
+#include <barrier>
+#include <cstdint>
+#include <expected>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace ls {
+
+struct Game;
+struct EnvInstance;
+
+// What an agent does in one environment step. The buttons are held for every tick of the step; the
+// command (place, upgrade, sell, repair, targeting, start wave) is applied on the first tick only.
+struct EnvAction {
+    uint8_t buttons{};     // input_bits: hero movement and abilities
+    Vec2 ability_target{}; // world position
+    std::optional<InputCommand> command;
+};
+
+// Caller-owned observation buffers for the whole batch, instance after instance. Sizes are given by
+// VecEnv::grid_size() etc. times the number of instances.
+struct EnvObservations {
+    std::span<float> grid;    // per tile, row-major: GRID_CHANNELS floats
+    std::span<float> enemies; // MAX_ENEMIES rows of ENEMY_FEATURES, furthest along the path first
+    std::span<float> globals; // GLOBAL_FEATURES
+    std::span<uint8_t> done;  // EnvStatus after the step
+};
+
+enum class EnvStatus : uint8_t { Running, Lost, Won };
+
+struct VecEnvConfig {
+    int instances{16};
+    int threads{1};        // workers stepping instances in parallel; 1 steps on the calling thread
+    int ticks_per_step{4}; // fixed 1/60 s simulation ticks per step
+    Difficulty difficulty{Difficulty::Normal};
+    uint32_t seed{1}; // episode k of instance i is seeded with seed + k * instances + i
+};
+
+// N independent matches on one map (each with its own registry, play state and copy of the map),
+// stepped in lockstep from an action batch for bots and training. Observations are written straight
+// into the caller's flat buffers, and a steady-state step doesn't allocate. An instance that ended
+// reports its status once, then starts its next episode at the following step.
+class VecEnv {
+  public:
+    static constexpr int GRID_CHANNELS = 4; // free buildable cell, path, tower level / 3, enemies on the tile
+    static constexpr int MAX_ENEMIES = 32;
+    static constexpr int ENEMY_FEATURES = 6;  // present, x and y (0..1 of the map), health ratio, type, path progress
+    static constexpr int GLOBAL_FEATURES = 8; // gold, lives, wave, enemies alive, hero x, y, health ratio, wave active
+    static constexpr float TICK = 1.0f / 60.0f;
+
+    VecEnv(const MapData& map, VecEnvConfig config);
+    ~VecEnv();
+    VecEnv(const VecEnv&) = delete;
+    VecEnv& operator=(const VecEnv&) = delete;
+
+    int size() const { return config_.instances; }
+    const VecEnvConfig& config() const { return config_; }
+
+    // Floats per instance in each observation buffer
+    size_t grid_size() const { return static_cast<size_t>(map_.rows * map_.cols * GRID_CHANNELS); }
+    static constexpr size_t enemies_size() { return MAX_ENEMIES * ENEMY_FEATURES; }
+    static constexpr size_t globals_size() { return GLOBAL_FEATURES; }
+
+    // Starts a fresh episode on every instance and writes the first observations
+    std::expected<void, std::string> reset(const EnvObservations& obs);
+
+    // One action per instance
+    std::expected<void, std::string> step(std::span<const EnvAction> actions, const EnvObservations& obs);
+
+    // For tests and tools that need more than the observations
+    const Game& game(int instance) const;
+
+  private:
+    MapData map_;
+    VecEnvConfig config_;
+    std::vector<std::unique_ptr<EnvInstance>> instances_;
+
+    // The call the workers are carrying out
+    std::span<const EnvAction> actions_;
+    const EnvObservations* obs_{nullptr};
+    bool resetting_{false};
+
+    std::barrier<> start_;
+    std::barrier<> finish_;
+    std::atomic<bool> stopping_{false};
+    std::vector<std::jthread> workers_;
+
+    std::expected<void, std::string> check(const EnvObservations& obs) const;
+    void run(); // fans the current call out over the workers, or runs it here
+    void run_slice(int first, int last);
+    void worker(int index);
+    void start_episode(EnvInstance& inst);
+    void advance(EnvInstance& inst, const EnvAction& action);
+    void observe(EnvInstance& inst, const EnvObservations& obs);
+};
+
+} // namespace ls
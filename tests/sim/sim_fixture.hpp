@@ -0,0 +1,24 @@
+// Setup shared by the whole-game simulation tests: the forest map, loaded once per test
+#pragma once
+#include "core/game.hpp"
+#include <catch2/catch_test_macros.hpp>
+#include <memory>
+
+namespace ls::sim {
+
+inline MapData forest_map() {
+    MapManager maps;
+    auto map = maps.load(LASTSTAND_ASSET_DIR "/maps/forest.json");
+    REQUIRE(map.has_value());
+    return std::move(*map);
+}
+
+// A game on the forest map with its routes computed and registered, and nothing placed or spawned
+inline std::unique_ptr<Game> forest_game() {
+    auto game = std::make_unique<Game>();
+    game->current_map = forest_map();
+    game->recalculate_path();
+    return game;
+}
+
+} // namespace ls::sim
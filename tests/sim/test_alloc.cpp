@@ -0,0 +1,102 @@
+// Runs the real simulation with the counting operator new from src/core/alloc_hooks.cpp linked in
+#include "core/alloc_tracker.hpp"
+#include "core/snapshot.hpp"
+#include "factory/hero_factory.hpp"
+#include "factory/tower_factory.hpp"
+#include "sim_fixture.hpp"
+#include "systems/match.hpp"
+#include "systems/systems.hpp"
+#include <algorithm>
+#include <catch2/catch_test_macros.hpp>
+#include <memory>
+
+using namespace ls;
+
+template <typename... Component>
+static void reserve_pools(entt::registry& reg, size_t n, entt::type_list<Component...>) {
+    (reg.storage<Component>().reserve(n), ...);
+}
+
+template <typename... Event>
+static void create_event_queues(EventDispatcher& dispatcher) {
+    (static_cast<void>(dispatcher.sink<Event>()), ...);
+}
+
+// Mid-wave match on the forest map: every tower type beside the path, and a hero and towers
+// that can't die, so nothing but the wave itself changes between ticks
+static std::unique_ptr<Game> wave_in_progress(WaveNum wave) {
+    auto game = sim::forest_game();
+    game->rng.seed(7);
+
+    auto& reg = game->registry;
+    auto& ps = game->play;
+    auto& m = game->current_map;
+    ps.lives = 1'000'000;
+    ps.current_wave = wave;
+    ps.wave_active = true;
+    ps.hero = create_hero(reg, m.grid_to_world(m.spawn));
+    reg.get<Health>(ps.hero).current = reg.get<Health>(ps.hero).max = 1'000'000;
+
+    for (int i = 0; i < 12; ++i) {
+        auto cell = nearest_free_cell_to_path(*game);
+        if (!cell) break;
+        auto t = create_tower(reg, game->tower_registry.get(static_cast<TowerType>(i % TOWER_TYPE_COUNT), 2), *cell, m);
+        reg.get<Health>(t).current = reg.get<Health>(t).max = 1'000'000;
+        ps.towers.place(*cell, t);
+    }
+
+    // One-time setup that a long-running match has long since paid for: component pools sized
+    // for the peak population, and the dispatcher's per-event queues
+    reserve_pools(reg, 4096, SnapshotComponents{});
+    reg.storage<entt::entity>().reserve(4096);
+    reg.storage<InEnemyIndex>().reserve(4096);
+    reg.storage<TowerCoverage>().reserve(64);
+    game->enemy_index.reserve(4096);
+    game->play.shots.reserve(1024);
+    game->play.bolts.reserve(256);
+    game->bolt_hits.reserve(256);
+    game->play.arcs.reserve(256);
+    game->body_grid.reserve(4096, 4096);
+    game->enemy_grid.reserve(4096, 4096);
+    create_event_queues<EnemyDeathEvent, EnemyReachedExitEvent, TowerPlacedEvent, WaveStartEvent, WaveCompleteEvent,
+                        DamageDealtEvent, HeroLevelUpEvent, VictoryEvent>(game->dispatcher);
+    return game;
+}
+
+TEST_CASE("A steady-state wave tick does not allocate", "[alloc]") {
+    constexpr float dt = 1.0f / 60.0f;
+    constexpr WaveNum wave = 19; // long non-boss wave: spawning continues through the whole window
+    auto game = wave_in_progress(wave);
+
+    for (int i = 0; i < 240; ++i) systems::simulate(*game, dt);
+
+    uint64_t allocs = 0, bytes = 0;
+    int noisy_ticks = 0;
+    size_t peak_bolts = 0;
+    for (int i = 0; i < 360; ++i) {
+        AllocCounters before = alloc_counters;
+        systems::simulate(*game, dt);
+        uint64_t n = alloc_counters.count - before.count;
+        peak_bolts = std::max(peak_bolts, game->play.bolts.size());
+        allocs += n;
+        bytes += alloc_counters.bytes - before.bytes;
+        if (n > 0) ++noisy_ticks;
+    }
+
+    // The window must have exercised a live wave, not an empty field
+    REQUIRE(game->play.current_wave == wave);
+    REQUIRE(game->play.enemies_alive > 0);
+    REQUIRE(game->play.shots.size() > 0);
+    REQUIRE(peak_bolts > 0); // the Ballista fired, so bolt sweeps ran
+
+    INFO(noisy_ticks << " ticks allocated " << bytes << " bytes");
+    CHECK(allocs == 0);
+}
+
+TEST_CASE("Allocation counters see heap allocations on this thread", "[alloc]") {
+    AllocCounters before = alloc_counters;
+    void* p = ::operator new(256); // a direct call, which unlike a new-expression can't be elided
+    CHECK(alloc_counters.count == before.count + 1);
+    CHECK(alloc_counters.bytes == before.bytes + 256);
+    ::operator delete(p);
+}
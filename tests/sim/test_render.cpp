@@ -0,0 +1,65 @@
+// The real render system drawing into a RecordingRenderer. Nothing is loaded headless; enemy sprites
+// get stub textures (the recorder only reads their ids) so the frame switches textures the way a real
+// one does, and everything else takes its procedural fallback.
+#include "core/asset_paths.hpp"
+#include "core/renderer.hpp"
+#include "factory/enemy_factory.hpp"
+#include "sim_fixture.hpp"
+#include "systems/systems.hpp"
+#include <catch2/catch_test_macros.hpp>
+
+using namespace ls;
+
+static DrawStats render_frame(Game& game) {
+    game.renderer->begin_frame();
+    game.renderer->begin_world(game.camera);
+    systems::render_system(game);
+    game.renderer->end_world();
+    game.renderer->end_frame();
+    return game.renderer->last_frame();
+}
+
+// Stub enemy sprite textures, taken back out before the asset manager would unload them
+struct StubEnemyTextures {
+    static constexpr const char* NAMES[] = {assets::ENEMY_GRUNT, assets::ENEMY_TANK};
+    AssetManager& assets;
+
+    explicit StubEnemyTextures(AssetManager& a) : assets(a) {
+        unsigned id = 100;
+        for (auto* name : NAMES) assets.add_texture(name, {.id = id++, .width = 64, .height = 64, .mipmaps = 1});
+    }
+    ~StubEnemyTextures() { for (auto* name : NAMES) assets.release_texture(name); }
+};
+
+TEST_CASE("A 200-enemy frame from the render system stays within its batch budget", "[render]") {
+    constexpr int ENEMIES = 200;
+    // Each enemy draws its sprite and then its health bar from the shapes texture, so the enemy pass
+    // costs a sprite batch and a bar batch per enemy; the slack covers merging with its neighbours
+    constexpr int ENEMY_BATCHES = 2 * ENEMIES + 2;
+
+    auto game = sim::forest_game();
+    game->camera.zoom = 1.0f;
+    RecordingRenderer recorder;
+    game->renderer = &recorder;
+    StubEnemyTextures textures(game->assets);
+
+    auto empty = render_frame(*game);
+
+    // A grid of wounded enemies across the screen, so each draws its sprite and a health bar
+    auto& reg = game->registry;
+    for (int i = 0; i < ENEMIES; ++i) {
+        auto type = i % 2 == 0 ? EnemyType::Grunt : EnemyType::Tank;
+        auto e = create_enemy(reg, type, game->play.enemy_path, 1.0f);
+        reg.get<Transform>(e).position = {40.0f + static_cast<float>(i % 20) * 60.0f,
+                                          40.0f + static_cast<float>(i / 20) * 60.0f};
+        auto& hp = reg.get<Health>(e);
+        hp.current = hp.max / 2;
+    }
+    auto full = render_frame(*game);
+
+    INFO(full.batches << " batches, " << empty.batches << " with no enemies");
+    CHECK(full.texture_draws == empty.texture_draws + ENEMIES);
+    CHECK(full.draws >= empty.draws + 3 * ENEMIES);
+    CHECK(full.texture_switches >= empty.texture_switches + 2 * ENEMIES - 1);
+    CHECK(full.batches <= empty.batches + ENEMY_BATCHES);
+}
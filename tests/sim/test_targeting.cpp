@@ -0,0 +1,327 @@
+// Tower targeting against the real systems: priorities, target hysteresis and time-sliced searches
+#include "factory/enemy_factory.hpp"
+#include "factory/tower_factory.hpp"
+#include "sim_fixture.hpp"
+#include "systems/match.hpp"
+#include "systems/systems.hpp"
+#include <algorithm>
+#include <catch2/catch_test_macros.hpp>
+#include <memory>
+
+using namespace ls;
+
+constexpr float dt = 1.0f / 60.0f;
+
+struct Range {
+    std::unique_ptr<Game> game;
+    entt::entity tower{entt::null};
+    float centre{}; // distance along the enemy path closest to the tower
+};
+
+// A forest match with one Arrow tower on the buildable cell nearest the path, and no enemies yet
+static Range arrow_range() {
+    Range r{sim::forest_game()};
+    auto& g = *r.game;
+    auto& m = g.current_map;
+    auto& path = *g.play.enemy_path;
+    auto cell = nearest_free_cell_to_path(g);
+    REQUIRE(cell.has_value());
+    r.tower = create_tower(g.registry, g.tower_registry.get(TowerType::Arrow, 1), *cell, m);
+    g.play.towers.place(*cell, r.tower);
+
+    auto tower_pos = m.grid_to_world(*cell);
+    float best = 1e30f;
+    for (float s = 0.0f; s < path.length(); s += 1.0f) {
+        if (float d = path.at(s).distance_to(tower_pos); d < best) {
+            best = d;
+            r.centre = s;
+        }
+    }
+    return r;
+}
+
+static void move_to(Range& r, entt::entity e, float offset) {
+    auto& reg = r.game->registry;
+    auto& path = *r.game->play.enemy_path;
+    auto& pf = reg.get<PathFollower>(e);
+    pf.distance = std::clamp(r.centre + offset, 0.0f, path.length());
+    pf.current_index = path.next_index(pf.distance);
+    reg.get<Transform>(e).position = path.at(pf.distance);
+}
+
+// An enemy `offset` px further along the path than the point nearest the tower
+static entt::entity walker(Range& r, float offset, EnemyType type = EnemyType::Grunt) {
+    auto& g = *r.game;
+    auto e = create_enemy(g.registry, type, g.play.enemy_path, 1.0f);
+    move_to(r, e, offset);
+    return e;
+}
+
+static entt::entity target(Range& r) {
+    systems::tower_targeting_system(*r.game, dt);
+    return r.game->registry.get<Tower>(r.tower).target;
+}
+
+TEST_CASE("Towers pick enemies by their targeting priority", "[targeting]") {
+    auto r = arrow_range();
+    auto behind = walker(r, -40.0f, EnemyType::Tank);
+    auto middle = walker(r, 0.0f);
+    auto ahead = walker(r, 40.0f, EnemyType::Runner);
+    auto& tower = r.game->registry.get<Tower>(r.tower);
+
+    CHECK(tower.target_mode == TargetMode::First);
+    CHECK(target(r) == ahead);
+
+    auto pick = [&](TargetMode mode) {
+        tower.target_mode = mode;
+        tower.target = entt::null;
+        return target(r);
+    };
+    CHECK(pick(TargetMode::Last) == behind);
+    CHECK(pick(TargetMode::Strongest) == behind);
+    CHECK(pick(TargetMode::Weakest) == ahead);
+    CHECK(pick(TargetMode::Nearest) == middle);
+
+    // Enemies outside the range are never picked, however far along they are
+    auto tower_pos = r.game->registry.get<Transform>(r.tower).position;
+    r.game->registry.get<Transform>(ahead).position = tower_pos + Vec2{tower.range + 10.0f, 0.0f};
+    CHECK(pick(TargetMode::First) == middle);
+}
+
+TEST_CASE("A tower keeps its target until it is clearly out-prioritized", "[targeting]") {
+    auto r = arrow_range();
+    auto& g = *r.game;
+    auto a = walker(r, 20.0f);
+    auto b = walker(r, 0.0f);
+    REQUIRE(target(r) == a);
+
+    // Every tower searches every tick, so only the switch margin keeps the target
+    g.retarget_budget = 100;
+    move_to(r, b, 20.0f + TARGET_SWITCH_MARGIN * 0.5f);
+    CHECK(target(r) == a);
+    move_to(r, b, 20.0f + TARGET_SWITCH_MARGIN * 2.0f);
+    CHECK(target(r) == b);
+
+    // Outside the search slice a live target is kept whatever happens around it...
+    g.retarget_budget = 0;
+    move_to(r, a, 60.0f);
+    CHECK(target(r) == b);
+
+    // ...but a dead one is replaced straight away
+    g.registry.emplace<Dead>(b);
+    CHECK(target(r) == a);
+}
+
+TEST_CASE("A tower still cooling down doesn't search", "[targeting]") {
+    auto r = arrow_range();
+    auto e = walker(r, 0.0f);
+    auto& tower = r.game->registry.get<Tower>(r.tower);
+
+    tower.cooldown = 0.5f;
+    CHECK(target(r) == entt::null);
+    tower.cooldown = RETARGET_LEAD;
+    CHECK(target(r) == e);
+
+    // Its target leaving range clears it even mid-cooldown
+    tower.cooldown = 0.5f;
+    auto tower_pos = r.game->registry.get<Transform>(r.tower).position;
+    r.game->registry.get<Transform>(e).position = tower_pos + Vec2{0.0f, tower.range + 10.0f};
+    CHECK(target(r) == entt::null);
+}
+
+TEST_CASE("Tower shots lead a walking target", "[targeting]") {
+    auto r = arrow_range();
+    auto& g = *r.game;
+    auto e = walker(r, -60.0f);
+    REQUIRE(target(r) == e);
+    systems::tower_attack_system(g, dt);
+    auto& shots = g.play.shots;
+    REQUIRE(shots.size() == 1);
+    auto shot = shots.in_flight().front();
+    CHECK(shot.target_pos != g.registry.get<Transform>(e).position);
+
+    // The enemy walks into the point the shot was fired at, arriving when the shot does
+    while (g.play.shots.clock + dt <= shot.impact_time) {
+        g.play.shots.advance(dt);
+        systems::path_follow_system(g, dt);
+    }
+    CHECK(g.registry.get<Transform>(e).position.distance_to(shot.target_pos) < 4.0f);
+}
+
+TEST_CASE("Ballista bolts strike enemies in line order up to their pierce, however long the step",
+          "[targeting]") {
+    auto r = arrow_range();
+    auto& g = *r.game;
+    auto& reg = g.registry;
+
+    // Four enemies strung along a horizontal line, well clear of each other
+    std::vector<entt::entity> line;
+    for (int i = 0; i < 4; ++i) {
+        auto e = create_enemy(reg, EnemyType::Tank, g.play.enemy_path, 1.0f);
+        reg.get<Transform>(e).position = {100.0f + 60.0f * static_cast<float>(i), 300.0f};
+        line.push_back(e);
+    }
+    auto bystander = create_enemy(reg, EnemyType::Tank, g.play.enemy_path, 1.0f);
+    reg.get<Transform>(bystander).position = {160.0f, 360.0f};
+
+    auto hp = [&](entt::entity e) { return reg.get<Health>(e).current; };
+    std::vector<int> before;
+    for (auto e : line) before.push_back(hp(e));
+    int bystander_hp = hp(bystander);
+
+    // Fired from behind the line at pierce 2; one half-second step covers the whole line
+    g.play.bolts.push_back({.position = {40.0f, 300.0f},
+                            .direction = {1.0f, 0.0f},
+                            .speed = BOLT_SPEED,
+                            .travel = 1000.0f,
+                            .radius = BOLT_RADIUS,
+                            .damage = 50,
+                            .pierce = 2});
+    systems::projectile_system(g, 0.5f);
+
+    CHECK(hp(line[0]) < before[0]);
+    CHECK(hp(line[1]) < before[1]);
+    CHECK(hp(line[2]) < before[2]);
+    CHECK(hp(line[3]) == before[3]);
+    CHECK(hp(bystander) == bystander_hp);
+    CHECK(g.play.bolts.empty()); // spent
+
+    // A first-hit bolt stops at the nearest enemy and never strikes the same one twice
+    g.play.bolts.push_back({.position = {40.0f, 300.0f},
+                            .direction = {1.0f, 0.0f},
+                            .speed = BOLT_SPEED,
+                            .travel = 1000.0f,
+                            .radius = BOLT_RADIUS,
+                            .damage = 50});
+    int first = hp(line[0]);
+    int second = hp(line[1]);
+    systems::projectile_system(g, 0.5f);
+    CHECK(hp(line[0]) < first);
+    CHECK(hp(line[1]) == second);
+    CHECK(g.play.bolts.empty());
+}
+
+TEST_CASE("A bolt passes over an enemy another bolt killed earlier in the tick", "[targeting]") {
+    auto r = arrow_range();
+    auto& g = *r.game;
+    auto& reg = g.registry;
+
+    auto weak = create_enemy(reg, EnemyType::Tank, g.play.enemy_path, 1.0f);
+    reg.get<Transform>(weak).position = {200.0f, 300.0f};
+    reg.get<Health>(weak).current = 10;
+    auto behind = create_enemy(reg, EnemyType::Tank, g.play.enemy_path, 1.0f);
+    reg.get<Transform>(behind).position = {300.0f, 300.0f};
+    int behind_hp = reg.get<Health>(behind).current;
+
+    // Two first-hit bolts down the same line in one step: the first kills `weak`, the second must not
+    // spend itself on the corpse
+    for (int i = 0; i < 2; ++i) {
+        g.play.bolts.push_back({.position = {40.0f, 300.0f},
+                                .direction = {1.0f, 0.0f},
+                                .speed = BOLT_SPEED,
+                                .travel = 1000.0f,
+                                .radius = BOLT_RADIUS,
+                                .damage = 50});
+    }
+    systems::projectile_system(g, 0.5f);
+
+    int armor = reg.get<Health>(weak).armor;
+    CHECK(reg.get<Health>(weak).current == 10 - (50 - armor));
+    CHECK(reg.get<Health>(behind).current == behind_hp - (50 - armor));
+    CHECK(g.play.bolts.empty());
+}
+
+TEST_CASE("Lightning chains hop to the nearest enemy not yet struck, never back", "[targeting]") {
+    auto r = arrow_range();
+    auto& g = *r.game;
+    auto& reg = g.registry;
+
+    // a is struck first. b is its nearest neighbour and a is b's, so a chain that only skips the enemy
+    // it is leaving would bounce a-b-a. c is the only new enemy in reach of b, and d of c.
+    std::vector<entt::entity> chain;
+    for (float x : {100.0f, 160.0f, 240.0f, 320.0f}) {
+        auto e = create_enemy(reg, EnemyType::Tank, g.play.enemy_path, 1.0f);
+        reg.get<Transform>(e).position = {x, 300.0f};
+        chain.push_back(e);
+    }
+    auto hp = [&](entt::entity e) { return reg.get<Health>(e).current; };
+    std::vector<int> before;
+    for (auto e : chain) before.push_back(hp(e));
+    int armor = reg.get<Health>(chain[0]).armor;
+
+    Vec2 a = reg.get<Transform>(chain[0]).position;
+    g.play.shots.fire({.target = chain[0],
+                       .origin = {a.x, a.y - 100.0f},
+                       .target_pos = a,
+                       .speed = PROJECTILE_SPEED,
+                       .damage = 80,
+                       .chain_count = 2});
+    systems::projectile_system(g, 0.5f);
+
+    // Each hop strikes once at 3/4 of the last; the chain stops after two hops with d still in reach
+    CHECK(before[0] - hp(chain[0]) == 80 - armor);
+    CHECK(before[1] - hp(chain[1]) == 60 - armor);
+    CHECK(before[2] - hp(chain[2]) == 45 - armor);
+    CHECK(hp(chain[3]) == before[3]);
+    CHECK(g.play.shots.empty());
+
+    // One polyline through all three, gone once it fades
+    REQUIRE(g.play.arcs.size() == 1);
+    CHECK(g.play.arcs[0].count == 3);
+    CHECK(g.play.arcs[0].points[2].x == 240.0f);
+    systems::projectile_system(g, CHAIN_ARC_LIFE);
+    CHECK(g.play.arcs.empty());
+}
+
+TEST_CASE("A splash shot damages every enemy within its radius of the impact and no others", "[targeting]") {
+    auto r = arrow_range();
+    auto& g = *r.game;
+    auto& reg = g.registry;
+
+    std::vector<entt::entity> enemies;
+    for (float x : {200.0f, 250.0f, 300.0f}) {
+        auto e = create_enemy(reg, EnemyType::Tank, g.play.enemy_path, 1.0f);
+        reg.get<Transform>(e).position = {x, 300.0f};
+        enemies.push_back(e);
+    }
+    auto hp = [&](entt::entity e) { return reg.get<Health>(e).current; };
+    std::vector<int> before;
+    for (auto e : enemies) before.push_back(hp(e));
+
+    g.play.shots.fire({.target = enemies[0],
+                       .origin = {200.0f, 200.0f},
+                       .target_pos = {200.0f, 300.0f},
+                       .speed = PROJECTILE_SPEED,
+                       .damage = 40,
+                       .aoe_radius = 60.0f});
+    systems::projectile_system(g, 0.5f);
+
+    CHECK(hp(enemies[0]) < before[0]);
+    CHECK(hp(enemies[1]) < before[1]);
+    CHECK(hp(enemies[2]) == before[2]);
+}
+
+TEST_CASE("Boss minions join the boss's route instead of adding one to the index", "[targeting]") {
+    auto r = arrow_range();
+    auto& g = *r.game;
+    auto& reg = g.registry;
+    auto boss = walker(r, 0.0f, EnemyType::Boss);
+    target(r);
+    auto version = g.enemy_index.version();
+    auto routes = g.enemy_index.routes().size();
+
+    auto& b = reg.get<Boss>(boss);
+    b.boss_ability = AbilityType::SpawnMinions;
+    b.ability_timer = 0.0f;
+    systems::boss_system(g, dt);
+    target(r);
+
+    CHECK(g.enemy_index.version() == version);
+    CHECK(g.enemy_index.routes().size() == routes);
+    CHECK(g.enemy_index.size() == 4);
+    auto& bpf = reg.get<PathFollower>(boss);
+    for (auto [e, en, pf] : reg.view<Enemy, PathFollower>(entt::exclude<Boss>).each()) {
+        CHECK(pf.path == bpf.path);
+        CHECK(pf.distance == bpf.distance);
+    }
+}
@@ -0,0 +1,73 @@
+// Batched headless matches for agents
+#include "sim_fixture.hpp"
+#include "systems/vec_env.hpp"
+#include <catch2/catch_test_macros.hpp>
+#include <vector>
+
+using namespace ls;
+
+struct Buffers {
+    std::vector<float> grid, enemies, globals;
+    std::vector<uint8_t> done;
+
+    explicit Buffers(const VecEnv& env)
+        : grid(env.grid_size() * static_cast<size_t>(env.size())),
+          enemies(VecEnv::enemies_size() * static_cast<size_t>(env.size())),
+          globals(VecEnv::globals_size() * static_cast<size_t>(env.size())), done(static_cast<size_t>(env.size())) {}
+
+    EnvObservations view() { return {grid, enemies, globals, done}; }
+};
+
+// Every instance holds still except the first, which walks right and casts at the map centre
+static std::vector<EnvAction> actions(const VecEnv& env) {
+    std::vector<EnvAction> a(static_cast<size_t>(env.size()));
+    a[0].buttons = input_bits::MOVE_RIGHT | input_bits::FIREBALL;
+    a[0].ability_target = {GRID_COLS * TILE_SIZE / 2.0f, GRID_ROWS * TILE_SIZE / 2.0f};
+    return a;
+}
+
+TEST_CASE("Observations don't depend on the thread count", "[vec_env]") {
+    auto map = sim::forest_map();
+    VecEnv serial(map, {.instances = 6, .threads = 1, .seed = 3});
+    VecEnv parallel(map, {.instances = 6, .threads = 3, .seed = 3});
+    Buffers a(serial), b(parallel);
+    REQUIRE(serial.reset(a.view()));
+    REQUIRE(parallel.reset(b.view()));
+
+    auto act = actions(serial);
+    for (int i = 0; i < 600; ++i) {
+        REQUIRE(serial.step(act, a.view()));
+        REQUIRE(parallel.step(act, b.view()));
+    }
+    CHECK(serial.game(0).play.current_wave > 0);
+    CHECK(a.grid == b.grid);
+    CHECK(a.enemies == b.enemies);
+    CHECK(a.globals == b.globals);
+    CHECK(a.done == b.done);
+}
+
+TEST_CASE("Observations describe the map, the hero and the enemies", "[vec_env]") {
+    VecEnv env(sim::forest_map(), {.instances = 2, .ticks_per_step = 8});
+    Buffers obs(env);
+    REQUIRE(env.reset(obs.view()));
+
+    // Path tiles are flagged and never buildable
+    size_t path_tiles = 0;
+    for (size_t i = 0; i < env.grid_size(); i += VecEnv::GRID_CHANNELS) {
+        path_tiles += obs.grid[i + 1] > 0.0f;
+        CHECK_FALSE((obs.grid[i] > 0.0f && obs.grid[i + 1] > 0.0f));
+    }
+    CHECK(path_tiles > 0);
+    CHECK(obs.globals[6] == 1.0f); // hero at full health
+
+    auto act = actions(env);
+    float hero_x = obs.globals[4];
+    for (int i = 0; i < 200 && obs.enemies[0] == 0.0f; ++i) REQUIRE(env.step(act, obs.view()));
+    CHECK(obs.globals[4] > hero_x);
+    CHECK(obs.enemies[0] == 1.0f);
+    CHECK(obs.enemies[5] >= obs.enemies[VecEnv::ENEMY_FEATURES + 5]); // furthest along first
+    CHECK(obs.done[0] == static_cast<uint8_t>(EnvStatus::Running));
+
+    std::vector<EnvAction> too_few(1);
+    CHECK_FALSE(env.step(too_few, obs.view()));
+}
@@ -0,0 +1,44 @@
+#include "core/camera.hpp"
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+using namespace ls;
+using Catch::Matchers::WithinAbs;
+
+TEST_CASE("min_zoom fits the whole default map on screen", "[camera]") {
+    float z = min_zoom(GRID_COLS, GRID_ROWS);
+    CHECK(GRID_COLS * TILE_SIZE * z <= SCREEN_WIDTH + 0.01f);
+    CHECK(GRID_ROWS * TILE_SIZE * z <= SCREEN_HEIGHT + 0.01f);
+    CHECK(z < 1.0f);
+}
+
+TEST_CASE("min_zoom never exceeds 1 for small maps", "[camera]") {
+    CHECK_THAT(min_zoom(5, 5), WithinAbs(1.0, 0.001));
+}
+
+TEST_CASE("LOD tiers drop as zoom decreases", "[camera]") {
+    CHECK(lod_for_zoom(1.0f) == LodLevel::Full);
+    CHECK(lod_for_zoom(ZOOM_MAX) == LodLevel::Full);
+    CHECK(lod_for_zoom((LOD_REDUCED_ZOOM + LOD_MINIMAL_ZOOM) / 2.0f) == LodLevel::Reduced);
+    CHECK(lod_for_zoom(min_zoom(GRID_COLS, GRID_ROWS)) == LodLevel::Minimal);
+    CHECK(lod_particle_stride(LodLevel::Full) == 1);
+    CHECK(lod_particle_stride(LodLevel::Minimal) > lod_particle_stride(LodLevel::Reduced));
+}
+
+TEST_CASE("clamp_camera_target keeps view inside world", "[camera]") {
+    float world_w = static_cast<float>(GRID_COLS * TILE_SIZE);
+    float world_h = static_cast<float>(GRID_ROWS * TILE_SIZE);
+    auto t = clamp_camera_target({0, 0}, 1.0f, world_w, world_h);
+    CHECK_THAT(t.x, WithinAbs(SCREEN_WIDTH / 2.0, 0.01));
+    CHECK_THAT(t.y, WithinAbs(SCREEN_HEIGHT / 2.0, 0.01));
+    t = clamp_camera_target({world_w, world_h}, 1.0f, world_w, world_h);
+    CHECK_THAT(t.x, WithinAbs(world_w - SCREEN_WIDTH / 2.0, 0.01));
+}
+
+TEST_CASE("clamp_camera_target centres a world smaller than the view", "[camera]") {
+    float world_w = static_cast<float>(GRID_COLS * TILE_SIZE);
+    float world_h = static_cast<float>(GRID_ROWS * TILE_SIZE);
+    float z = min_zoom(GRID_COLS, GRID_ROWS);
+    auto t = clamp_camera_target({100, 100}, z, world_w, world_h);
+    CHECK_THAT(t.y, WithinAbs(world_h / 2.0, 0.01));
+}
@@ -0,0 +1,68 @@
+#include "core/churn_counters.hpp"
+#include <catch2/catch_test_macros.hpp>
+
+using namespace ls;
+
+static ChurnCounters::Row row_of(const ChurnCounters& churn, std::string_view name) {
+    for (auto& r : churn.rows()) {
+        if (r.name == name) return r;
+    }
+    return {};
+}
+
+TEST_CASE("Churn counters follow construct and destroy signals", "[churn]") {
+    entt::registry reg;
+    ChurnCounters churn;
+    churn.attach(reg);
+
+    for (int i = 0; i < 10; ++i) {
+        auto e = reg.create();
+        reg.emplace<Transform>(e);
+        reg.emplace<Particle>(e);
+    }
+    reg.destroy(reg.view<Particle>().front());
+    reg.emplace_or_replace<Particle>(reg.view<Particle>().front()); // a replacement is not churn
+    churn.end_frame(reg);
+
+    auto p = row_of(churn, "Particle");
+    CHECK(p.total_created == 10);
+    CHECK(p.total_destroyed == 1);
+    CHECK(p.size == 9);
+    CHECK(p.capacity >= 9);
+    CHECK(p.created == 10.0);
+    CHECK(row_of(churn, "entity").size == 9);
+    CHECK(row_of(churn, "Transform").total_destroyed == 1);
+
+    churn.end_frame(reg); // a quiet frame halves the recent average
+    p = row_of(churn, "Particle");
+    CHECK(p.created == 5.0);
+    CHECK(p.peak_created == 10);
+    CHECK(churn.report().find("Particle") != std::string::npos);
+}
+
+TEST_CASE("Churn counters see runtime-only components too", "[churn]") {
+    entt::registry reg;
+    ChurnCounters churn;
+    churn.attach(reg);
+
+    auto e = reg.create();
+    reg.emplace<InEnemyIndex>(e);
+    reg.emplace<TowerCoverage>(e);
+    reg.destroy(e);
+    churn.end_frame(reg);
+
+    CHECK(row_of(churn, "InEnemyIndex").total_created == 1);
+    CHECK(row_of(churn, "InEnemyIndex").total_destroyed == 1);
+    CHECK(row_of(churn, "TowerCoverage").total_created == 1);
+}
+
+TEST_CASE("Detached counters stop counting", "[churn]") {
+    entt::registry reg;
+    ChurnCounters churn;
+    churn.attach(reg);
+    churn.detach(reg);
+    reg.emplace<Coin>(reg.create());
+    churn.end_frame(reg);
+    CHECK(churn.rows().empty());
+    CHECK(churn.frames() == 0);
+}
@@ -0,0 +1,187 @@
+#include "core/enemy_index.hpp"
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <memory>
+#include <vector>
+
+using namespace ls;
+using Catch::Matchers::WithinAbs;
+
+// An L: 300 px right, then 200 px down
+static SharedPath l_path() { return make_path({{0, 0}, {300, 0}, {300, 200}}); }
+
+static entt::entity walker(entt::registry& reg, const SharedPath& path, float distance) {
+    auto e = reg.create();
+    reg.emplace<Enemy>(e);
+    reg.emplace<Transform>(e, path->at(distance));
+    reg.emplace<PathFollower>(e, path, path->next_index(distance), 60.0f, 60.0f, distance);
+    return e;
+}
+
+static std::vector<entt::entity> order(const EnemyIndex::Route& route) {
+    std::vector<entt::entity> out;
+    for (auto& en : route.entries) out.push_back(en.entity);
+    return out;
+}
+
+TEST_CASE("Enemy index orders enemies by distance along their route", "[enemy_index]") {
+    entt::registry reg;
+    EnemyIndex index;
+    auto path = l_path();
+    auto a = walker(reg, path, 100.0f);
+    auto b = walker(reg, path, 350.0f);
+    auto c = walker(reg, path, 250.0f);
+
+    index.update(reg);
+    REQUIRE(index.routes().size() == 1);
+    auto& route = index.routes()[0];
+    CHECK_THAT(route.length(), WithinAbs(500.0f, 0.01));
+    CHECK(order(route) == std::vector{a, c, b});
+    CHECK_THAT(route.entries[2].progress, WithinAbs(350.0f, 0.01));
+
+    // a overtakes c, b dies, and a new enemy on a recalculated copy of the route joins the same route
+    reg.get<PathFollower>(a).distance = 280.0f;
+    reg.emplace<Dead>(b);
+    auto d = walker(reg, l_path(), 0.0f);
+    auto version = index.version();
+    index.update(reg);
+    REQUIRE(index.routes().size() == 1);
+    CHECK(index.version() == version);
+    CHECK(order(index.routes()[0]) == std::vector{d, c, a});
+
+    reg.destroy(a);
+    reg.destroy(c);
+    reg.destroy(d);
+    index.update(reg);
+    CHECK(index.size() == 0);
+    CHECK(index.routes().size() == 1);
+    CHECK(index.version() == version);
+
+    index.clear();
+    CHECK(index.routes().empty());
+    CHECK(index.version() != version);
+}
+
+TEST_CASE("Tower coverage is the stretches of route within range", "[enemy_index]") {
+    entt::registry reg;
+    EnemyIndex index;
+    auto path = l_path();
+    walker(reg, path, 0.0f);
+    index.update(reg);
+    auto& route = index.routes()[0];
+
+    // Centred on the corner: the last 100 px of the first leg and the first 100 px of the second merge
+    std::vector<EnemyIndex::Span> spans;
+    EnemyIndex::coverage(route, {300, 0}, 100.0f, spans);
+    REQUIRE(spans.size() == 1);
+    CHECK_THAT(spans[0].from, WithinAbs(200.0f, 0.01));
+    CHECK_THAT(spans[0].to, WithinAbs(400.0f, 0.01));
+
+    // Inside the L, close to both legs but not the corner: two separate stretches
+    spans.clear();
+    EnemyIndex::coverage(route, {200, 100}, 110.0f, spans);
+    REQUIRE(spans.size() == 2);
+    CHECK(spans[0].to < spans[1].from);
+
+    spans.clear();
+    EnemyIndex::coverage(route, {0, 400}, 50.0f, spans);
+    CHECK(spans.empty());
+}
+
+TEST_CASE("Span lookups walk enemies in progress order and stop early", "[enemy_index]") {
+    entt::registry reg;
+    EnemyIndex index;
+    auto path = l_path();
+    std::vector<entt::entity> enemies;
+    for (float d : {20.0f, 80.0f, 140.0f, 200.0f, 260.0f}) enemies.push_back(walker(reg, path, d));
+    index.update(reg);
+    auto& route = index.routes()[0];
+
+    std::vector<entt::entity> seen;
+    auto collect = [&](const EnemyIndex::Entry& en) {
+        seen.push_back(en.entity);
+        return true;
+    };
+    CHECK(EnemyIndex::for_each_in(route, {70, 210}, true, collect));
+    CHECK(seen == std::vector{enemies[3], enemies[2], enemies[1]});
+
+    seen.clear();
+    CHECK(EnemyIndex::for_each_in(route, {70, 210}, false, collect));
+    CHECK(seen == std::vector{enemies[1], enemies[2], enemies[3]});
+
+    seen.clear();
+    CHECK_FALSE(EnemyIndex::for_each_in(route, {0, 500}, true, [&](const EnemyIndex::Entry& en) {
+        seen.push_back(en.entity);
+        return en.entity != enemies[3];
+    }));
+    CHECK(seen == std::vector{enemies[4], enemies[3]});
+}
+
+TEST_CASE("Tower coverage is precomputed per route and wakes on enemies", "[enemy_index]") {
+    entt::registry reg;
+    EnemyIndex index;
+    auto ground = l_path();
+    auto flying = make_path({{0, 0}, {300, 200}});
+    CHECK(index.add_route(ground) == 0);
+    CHECK(index.add_route(flying) == 1);
+    CHECK(index.add_route(l_path()) == 0); // same waypoints, same route
+
+    // Beside the second leg, clear of the diagonal flying line
+    TowerCoverage cov;
+    cov.refresh(index, {340, 150}, 50.0f);
+    REQUIRE(cov.spans.size() == 2);
+    CHECK(cov.covered(0) > 0.0f);
+    CHECK(cov.spans[1].empty());
+    CHECK_FALSE(cov.covers_enemy(index));
+
+    auto e = walker(reg, ground, 100.0f);
+    index.update(reg);
+    CHECK_FALSE(cov.covers_enemy(index));
+    reg.get<PathFollower>(e).distance = 450.0f;
+    index.update(reg);
+    CHECK(cov.covers_enemy(index));
+
+    // Only a new route or a new radius recomputes the stretches
+    auto version = cov.version;
+    cov.refresh(index, {340, 150}, 50.0f);
+    CHECK(cov.version == version);
+    cov.refresh(index, {340, 150}, 80.0f);
+    CHECK(cov.covered(0) > 100.0f);
+}
+
+TEST_CASE("The index wakes a dormant tower when an enemy walks or spawns onto its stretch", "[enemy_index]") {
+    entt::registry reg;
+    EnemyIndex index;
+    auto path = l_path();
+    index.add_route(path);
+    auto tower = reg.create();
+    reg.emplace<TowerCoverage>(tower).refresh(index, {300, 0}, 100.0f); // 200..400 along the route
+    index.watch(tower, reg.get<TowerCoverage>(tower).spans);
+    CHECK(index.watched() == 1);
+    auto awake = [&] { return reg.get<TowerCoverage>(tower).awake; };
+    auto sleep = [&] { reg.get<TowerCoverage>(tower).awake = false; };
+
+    auto e = walker(reg, path, 50.0f);
+    index.update(reg);
+    sleep();
+    reg.get<PathFollower>(e).distance = 150.0f;
+    index.update(reg);
+    CHECK_FALSE(awake());
+
+    // Stepping clean over the stretch in one tick still wakes it
+    reg.get<PathFollower>(e).distance = 450.0f;
+    index.update(reg);
+    CHECK(awake());
+
+    sleep();
+    walker(reg, path, 300.0f);
+    index.update(reg);
+    CHECK(awake());
+
+    index.clear_watches();
+    CHECK(index.watched() == 0);
+    sleep();
+    walker(reg, path, 250.0f);
+    index.update(reg);
+    CHECK_FALSE(awake());
+}
@@ -0,0 +1,56 @@
+#include "core/impact_queue.hpp"
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <vector>
+
+using namespace ls;
+using Catch::Matchers::WithinAbs;
+
+static Projectile shot(float distance, int damage) {
+    return {.origin = {0, 0}, .target_pos = {distance, 0}, .speed = 100.0f, .damage = damage};
+}
+
+TEST_CASE("Shots land in impact order once the clock reaches them", "[impact_queue]") {
+    ImpactQueue q;
+    q.fire(shot(300.0f, 3));
+    q.fire(shot(100.0f, 1));
+    q.fire(shot(200.0f, 2));
+    REQUIRE(q.size() == 3);
+
+    std::vector<int> landed;
+    auto record = [&](const Projectile& p) { landed.push_back(p.damage); };
+    q.advance(0.5f);
+    q.pop_due(record);
+    CHECK(landed.empty());
+
+    q.advance(1.6f);
+    q.pop_due(record);
+    CHECK(landed == std::vector{1, 2});
+    CHECK(q.size() == 1);
+
+    // Halfway through its flight, the last one is drawn halfway there
+    CHECK_THAT(q.position(q.in_flight().front()).x, WithinAbs(210.0f, 0.01));
+
+    q.clear();
+    CHECK(q.empty());
+    CHECK(q.clock == 0.0f);
+}
+
+TEST_CASE("Shots fired while resolving land in the same pass when due", "[impact_queue]") {
+    ImpactQueue q;
+    q.fire(shot(100.0f, 1));
+    q.advance(2.0f);
+
+    std::vector<int> landed;
+    q.pop_due([&](const Projectile& p) {
+        landed.push_back(p.damage);
+        // A bounce leaving at the moment of impact: 50 px lands at 1.5 s, 500 px at 6 s
+        if (p.damage == 1) {
+            q.fire(shot(50.0f, 2), p.impact_time);
+            q.fire(shot(500.0f, 3), p.impact_time);
+        }
+    });
+    CHECK(landed == std::vector{1, 2});
+    REQUIRE(q.size() == 1);
+    CHECK_THAT(q.in_flight().front().impact_time, WithinAbs(6.0f, 0.001));
+}
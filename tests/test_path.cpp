@@ -0,0 +1,41 @@
+#include "core/path.hpp"
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+using namespace ls;
+using Catch::Matchers::WithinAbs;
+
+TEST_CASE("Path positions are a function of distance travelled", "[path]") {
+    Path p({{0, 0}, {300, 0}, {300, 200}});
+    CHECK_THAT(p.length(), WithinAbs(500.0f, 0.01));
+    CHECK_THAT(p.arc(1), WithinAbs(300.0f, 0.01));
+
+    CHECK(p.at(-10.0f) == Vec2{0, 0});
+    CHECK_THAT(p.at(150.0f).x, WithinAbs(150.0f, 0.01));
+    CHECK_THAT(p.at(350.0f).x, WithinAbs(300.0f, 0.01));
+    CHECK_THAT(p.at(350.0f).y, WithinAbs(50.0f, 0.01));
+    CHECK(p.at(900.0f) == Vec2{300, 200});
+
+    CHECK(p.next_index(0.0f) == 1);
+    CHECK(p.next_index(299.0f) == 1);
+    CHECK(p.next_index(300.0f) == 2);
+    CHECK(p.next_index(500.0f) == 3); // arrived
+
+    CHECK(p.direction(100.0f) == Vec2{1, 0});
+    CHECK(p.direction(400.0f) == Vec2{0, 1});
+    CHECK(p.direction(500.0f) == Vec2{});
+}
+
+TEST_CASE("Path steps add up exactly whatever the step size", "[path]") {
+    Path p({{0, 0}, {96, 0}, {96, 96}, {0, 96}});
+    float coarse = 0.0f, fine = 0.0f;
+    for (int i = 0; i < 4; ++i) coarse += 50.0f * 0.5f;
+    for (int i = 0; i < 120; ++i) fine += 50.0f * (1.0f / 60.0f);
+    CHECK_THAT(p.at(coarse).x, WithinAbs(p.at(fine).x, 0.001));
+    CHECK_THAT(p.at(coarse).y, WithinAbs(p.at(fine).y, 0.001));
+
+    Path single({{5, 5}});
+    CHECK(single.length() == 0.0f);
+    CHECK(single.at(10.0f) == Vec2{5, 5});
+    CHECK(single.next_index(0.0f) == 1);
+}
@@ -0,0 +1,48 @@
+#include "core/perf_stats.hpp"
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+using namespace ls;
+using Catch::Matchers::WithinRel;
+
+TEST_CASE("Histogram buckets round-trip within an eighth", "[perf]") {
+    for (uint32_t us : {0u, 7u, 8u, 15u, 16u, 100u, 16'600u, 33'000u, 250'000u}) {
+        int b = FrameHistogram::bucket_of(us);
+        CHECK(FrameHistogram::bucket_floor(b) <= us);
+        CHECK(us < FrameHistogram::bucket_floor(b) + FrameHistogram::bucket_width(b));
+        CHECK(FrameHistogram::bucket_width(b) * 8 <= std::max(us, 8u));
+    }
+    CHECK(FrameHistogram::bucket_of(4'000'000'000u) == FrameHistogram::BUCKETS - 1);
+}
+
+TEST_CASE("Histogram percentiles pick out the tail", "[perf]") {
+    FrameHistogram h;
+    for (int i = 0; i < 980; ++i) h.record(4.0f);
+    for (int i = 0; i < 19; ++i) h.record(20.0f);
+    h.record(50.0f);
+    CHECK(h.frames() == 1000);
+    CHECK_THAT(h.percentile(0.50f), WithinRel(4.0f, 0.07f));
+    CHECK_THAT(h.percentile(0.99f), WithinRel(20.0f, 0.07f));
+    CHECK(h.max_ms() == 50.0f);
+    CHECK(h.percentile(1.0f) <= 50.0f);
+    CHECK(FrameHistogram{}.percentile(0.5f) == 0.0f);
+}
+
+TEST_CASE("Match perf splits frames and peaks by wave", "[perf]") {
+    MatchPerf perf;
+    perf.record(1, 3.0f, {.enemies = 10, .total = 40});
+    perf.record(1, 4.0f, {.enemies = 5, .projectiles = 30, .total = 60});
+    perf.record(2, 30.0f, {.enemies = 80, .total = 300});
+    REQUIRE(perf.waves().size() == 2);
+    CHECK(perf.waves()[0].frames.frames() == 2);
+    CHECK(perf.waves()[0].peak.enemies == 10);
+    CHECK(perf.waves()[0].peak.projectiles == 30);
+    CHECK(perf.waves()[0].peak.total == 60);
+    CHECK(perf.peak().total == 300);
+    CHECK(perf.overall().frames() == 3);
+    CHECK(perf.worst_waves(1).front()->wave == 2);
+
+    auto csv = perf.to_csv("Forest", "Normal");
+    CHECK(csv.starts_with("map,difficulty,wave,frames,"));
+    CHECK(csv.find("\nForest,Normal,2,1,") != std::string::npos);
+}
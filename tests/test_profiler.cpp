@@ -0,0 +1,72 @@
+#include "core/profiler.hpp"
+#include <catch2/catch_test_macros.hpp>
+#include <string>
+
+using namespace ls;
+
+TEST_CASE("Profiler slots are shared by name", "[profiler]") {
+    Profiler p;
+    std::string copy = "tower_attack_system"; // different pointer, same name
+    int a = p.slot("tower_attack_system");
+    int b = p.slot("projectile_system");
+    CHECK(a != b);
+    CHECK(p.slot(copy.c_str()) == a);
+    CHECK(p.slot_count() == 2);
+}
+
+TEST_CASE("Profiler accumulates scopes into the current frame", "[profiler]") {
+    Profiler p;
+    int s = p.slot("hero_system");
+    p.add(s, 1'000'000);
+    p.add(s, 500'000);
+    p.end_frame();
+    REQUIRE(p.frame_count() == 1);
+    CHECK(p.frame(0).slot_ns[s] == 1'500'000);
+
+    p.end_frame(); // nothing recorded this frame
+    CHECK(p.frame(0).slot_ns[s] == 0);
+    CHECK(p.frame(1).slot_ns[s] == 1'500'000);
+}
+
+TEST_CASE("Profiler ring keeps the last HISTORY frames", "[profiler]") {
+    Profiler p;
+    int s = p.slot("particle_system");
+    for (size_t i = 1; i <= Profiler::HISTORY + 10; ++i) {
+        p.add(s, i * 1'000'000);
+        p.end_frame();
+    }
+    CHECK(p.frame_count() == Profiler::HISTORY);
+    CHECK(p.frame(0).slot_ns[s] == (Profiler::HISTORY + 10) * 1'000'000);
+    CHECK(p.frame(Profiler::HISTORY - 1).slot_ns[s] == 11 * 1'000'000);
+
+    auto st = p.slot_stats(s);
+    CHECK(st.min_ms == 11.0);
+    CHECK(st.max_ms == static_cast<double>(Profiler::HISTORY + 10));
+    CHECK(st.p99_ms >= 245.0);
+    CHECK(st.avg_ms > st.min_ms);
+    CHECK(st.avg_ms < st.max_ms);
+}
+
+TEST_CASE("Slots run out gracefully", "[profiler]") {
+    Profiler p;
+    std::vector<std::string> names;
+    for (int i = 0; i < Profiler::MAX_SLOTS + 1; ++i) names.push_back("slot" + std::to_string(i));
+    for (int i = 0; i < Profiler::MAX_SLOTS; ++i) CHECK(p.slot(names[static_cast<size_t>(i)].c_str()) == i);
+    CHECK(p.slot(names.back().c_str()) == -1);
+    p.add(-1, 123); // ignored
+}
+
+TEST_CASE("Profiler averages allocations per frame", "[profiler]") {
+    Profiler p;
+    int s = p.slot("coin_system");
+    p.add_allocs(s, 3, 96);
+    p.add_allocs(s, 1, 32);
+    p.end_frame();
+    p.end_frame();
+    CHECK(p.frame(1).slot_allocs[s] == 4);
+    CHECK(p.frame(1).slot_alloc_bytes[s] == 128);
+    auto st = p.slot_alloc_stats(s);
+    CHECK(st.avg_count == 2.0);
+    CHECK(st.avg_bytes == 64.0);
+    CHECK(st.max_count == 4);
+}
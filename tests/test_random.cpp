@@ -0,0 +1,66 @@
+#include "core/random.hpp"
+#include <catch2/catch_test_macros.hpp>
+
+using namespace ls;
+
+TEST_CASE("Pcg32 matches the reference sequence", "[random]") {
+    // First outputs of the PCG32 demo (seed 42, stream 54)
+    Pcg32 rng(42u, 54u);
+    CHECK(rng.next() == 0xa15c02b7u);
+    CHECK(rng.next() == 0x7b47f409u);
+    CHECK(rng.next() == 0xba1d3330u);
+}
+
+TEST_CASE("Same seed and stream reproduce the same sequence", "[random]") {
+    Pcg32 a(1234u, rng_stream::VFX);
+    Pcg32 b(1234u, rng_stream::VFX);
+    for (int i = 0; i < 100; ++i) CHECK(a.next() == b.next());
+}
+
+TEST_CASE("Streams from the same seed are independent", "[random]") {
+    RandomStreams streams;
+    streams.seed(99u);
+    Pcg32 gameplay_only(99u, rng_stream::GAMEPLAY);
+    // Heavy VFX use must not shift the gameplay sequence
+    for (int i = 0; i < 1000; ++i) streams.vfx.next();
+    for (int i = 0; i < 100; ++i) CHECK(streams.gameplay.next() == gameplay_only.next());
+}
+
+TEST_CASE("Integer range is inclusive and stays in bounds", "[random]") {
+    Pcg32 rng(7u, 1u);
+    bool saw_lo = false, saw_hi = false;
+    for (int i = 0; i < 10000; ++i) {
+        int v = rng.range(-3, 3);
+        REQUIRE(v >= -3);
+        REQUIRE(v <= 3);
+        saw_lo |= v == -3;
+        saw_hi |= v == 3;
+    }
+    CHECK(saw_lo);
+    CHECK(saw_hi);
+    CHECK(rng.range(5, 5) == 5);
+    int swapped = rng.range(10, 0);
+    CHECK(swapped >= 0);
+    CHECK(swapped <= 10);
+}
+
+TEST_CASE("Float range stays in [lo, hi)", "[random]") {
+    Pcg32 rng(11u, 2u);
+    for (int i = 0; i < 10000; ++i) {
+        float u = rng.uniform();
+        REQUIRE(u >= 0.0f);
+        REQUIRE(u < 1.0f);
+        float v = rng.range(-1.0f, 1.0f);
+        REQUIRE(v >= -1.0f);
+        REQUIRE(v < 1.0f);
+    }
+}
+
+TEST_CASE("split gives a deterministic child stream", "[random]") {
+    Pcg32 a(5u, 1u), b(5u, 1u);
+    auto ca = a.split(100u);
+    auto cb = b.split(100u);
+    for (int i = 0; i < 50; ++i) CHECK(ca.next() == cb.next());
+    // Parent continues independently of the child
+    CHECK(a.next() == b.next());
+}
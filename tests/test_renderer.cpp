@@ -0,0 +1,103 @@
+#include "core/renderer.hpp"
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+using namespace ls;
+using Catch::Matchers::WithinRel;
+
+static Texture2D texture(unsigned id) { return {id, 64, 64, 1, 7}; }
+
+// Sprite centred on (x, y), drawn the way the render system's draw_tex helper does
+static void sprite(Renderer& r, const Texture2D& tex, float x, float y) {
+    r.texture(tex, {0, 0, 64, 64}, {x, y, 32, 32}, {16, 16}, 0, WHITE);
+}
+
+static void health_bar(Renderer& r, float x, float y) {
+    r.rectangle({x - 16, y - 22, 32, 3}, GRAY);
+    r.rectangle({x - 16, y - 22, 24, 3}, GREEN);
+}
+
+TEST_CASE("Draws batch until the texture or primitive type changes", "[renderer]") {
+    RecordingRenderer r;
+    auto grunt = texture(10);
+    auto tank = texture(11);
+
+    r.begin_frame();
+    for (int i = 0; i < 5; ++i) sprite(r, grunt, 100, 100);
+    sprite(r, tank, 100, 100);
+    r.rectangle(0, 0, 10, 10, RED);
+    r.circle({50, 50}, 5, RED);                 // same shapes texture and quads: no break
+    r.circle_lines({50, 50}, 8, RED);           // lines: new draw call, same texture
+    r.line({0, 0}, {10, 0}, 2, RED);            // triangles: new draw call
+    r.text(nullptr, "wave 3", {0, 0}, 10, 1, WHITE);
+    r.end_frame();
+
+    auto& s = r.last_frame();
+    CHECK(s.draws == 11);
+    CHECK(s.texture_draws == 6);
+    CHECK(s.shape_draws == 4);
+    CHECK(s.text_draws == 1);
+    CHECK(s.texture_switches == 3); // grunt -> tank -> shapes -> font
+    CHECK(s.batches == 6);
+    CHECK(s.flushes == 1);
+    REQUIRE(r.commands().size() == 11);
+    CHECK(r.commands().back().text == "wave 3");
+    CHECK(r.commands().back().command.kind == DrawKind::Text);
+
+    r.begin_frame(); // a new frame starts an empty recording
+    CHECK(r.commands().empty());
+    CHECK(r.stats().draws == 0);
+    CHECK(r.last_frame().draws == 11);
+}
+
+TEST_CASE("Camera changes and a full vertex buffer flush the batch", "[renderer]") {
+    RecordingRenderer r;
+    auto tex = texture(10);
+
+    r.begin_frame();
+    r.begin_world({{0, 0}, {0, 0}, 0, 2.0f});
+    sprite(r, tex, 0, 0);
+    r.end_world();
+    sprite(r, tex, 0, 0); // same texture, but the camera change already submitted the batch
+    r.end_frame();
+    CHECK(r.last_frame().batches == 2);
+    CHECK(r.last_frame().flushes == 2);
+    CHECK(r.last_frame().texture_switches == 0);
+    // 32x32 at 2x zoom, then 32x32 on screen
+    CHECK_THAT(r.last_frame().pixels, WithinRel(4.0 * 32 * 32 + 32 * 32, 1e-6));
+    CHECK_THAT(r.last_frame().overdraw(64, 80), WithinRel(1.0, 1e-6));
+
+    r.begin_frame();
+    int quads = Renderer::BATCH_VERTICES / 4;
+    for (int i = 0; i < quads; ++i) sprite(r, tex, 0, 0);
+    r.end_frame();
+    CHECK(r.last_frame().flushes == 2);
+    CHECK(r.last_frame().batches == 2);
+}
+
+TEST_CASE("A 200-enemy frame stays within its batch budget when sprites are grouped", "[renderer]") {
+    constexpr int ENEMIES = 200;
+    Texture2D types[] = {texture(10), texture(11), texture(12), texture(13)};
+    RecordingRenderer r;
+
+    // Interleaving each sprite with its health bar binds a new texture on every draw
+    r.begin_frame();
+    for (int i = 0; i < ENEMIES; ++i) {
+        sprite(r, types[i % 4], static_cast<float>(i), 100);
+        health_bar(r, static_cast<float>(i), 100);
+    }
+    r.end_frame();
+    CHECK(r.last_frame().draws == 3 * ENEMIES);
+    CHECK(r.last_frame().batches == 2 * ENEMIES);
+
+    // Grouped by texture, with the bars drawn afterwards: one draw call per texture plus the bars
+    r.begin_frame();
+    for (auto& tex : types) {
+        for (int i = 0; i < ENEMIES / 4; ++i) sprite(r, tex, static_cast<float>(i), 100);
+    }
+    for (int i = 0; i < ENEMIES; ++i) health_bar(r, static_cast<float>(i), 100);
+    r.end_frame();
+    CHECK(r.last_frame().draws == 3 * ENEMIES);
+    CHECK(r.last_frame().batches <= 5);
+    CHECK(r.last_frame().texture_switches == 4);
+}
@@ -0,0 +1,126 @@
+#include "core/replay.hpp"
+#include <catch2/catch_test_macros.hpp>
+
+using namespace ls;
+
+// What the game does with the recorder's bytes: a new recording starts the file over, the rest appends
+static void write(ReplayRecorder& rec, std::vector<uint8_t>& file) {
+    if (!rec.has_pending()) return;
+    if (rec.starts_file()) file.clear();
+    auto bytes = rec.take();
+    file.insert(file.end(), bytes.begin(), bytes.end());
+}
+
+TEST_CASE("Replay round-trips header, frame times and input", "[replay]") {
+    ReplayRecorder rec("unused.lsr");
+    HeroUpgrades ups;
+    ups.max_hp_level = 3;
+    rec.begin({12345u, "Forest", Difficulty::Hard, ups});
+
+    InputFrame idle;
+    InputFrame moving;
+    moving.buttons = input_bits::MOVE_UP | input_bits::MOVE_LEFT | input_bits::LIGHTNING;
+    moving.ability_target = {320.0f, 96.0f};
+    moving.commands.push_back({CommandType::PlaceTower, TowerType::Cannon, {4, 9}});
+    moving.commands.push_back({CommandType::ToggleSpeed});
+
+    rec.record(0.016f, idle);
+    rec.record(0.017f, moving);
+    rec.record(0.015f, idle);
+    CHECK(rec.ticks() == 3);
+    rec.end();
+    std::vector<uint8_t> file;
+    write(rec, file);
+
+    ReplayPlayer player;
+    REQUIRE(player.load(file).has_value());
+    CHECK(player.header().seed == 12345u);
+    CHECK(player.header().map_name == "Forest");
+    CHECK(player.header().difficulty == Difficulty::Hard);
+    CHECK(player.header().upgrades.max_hp_level == 3);
+
+    float dt{};
+    InputFrame frame;
+    REQUIRE(player.next(dt, frame));
+    CHECK(dt == 0.016f);
+    CHECK(frame.buttons == 0);
+    CHECK(frame.commands.empty());
+
+    REQUIRE(player.next(dt, frame));
+    CHECK(dt == 0.017f);
+    CHECK(frame.held(input_bits::MOVE_UP));
+    CHECK(frame.held(input_bits::LIGHTNING));
+    CHECK_FALSE(frame.held(input_bits::HAS_COMMANDS));
+    CHECK(frame.ability_target == Vec2{320.0f, 96.0f});
+    REQUIRE(frame.commands.size() == 2);
+    CHECK(frame.commands[0].type == CommandType::PlaceTower);
+    CHECK(frame.commands[0].tower == TowerType::Cannon);
+    CHECK(frame.commands[0].cell == GridPos{4, 9});
+    CHECK(frame.commands[1].type == CommandType::ToggleSpeed);
+
+    // Commands from the previous tick must not leak into an idle one
+    REQUIRE(player.next(dt, frame));
+    CHECK(frame.commands.empty());
+    CHECK_FALSE(player.next(dt, frame));
+    CHECK(player.ticks() == 3);
+    CHECK_FALSE(player.truncated());
+}
+
+TEST_CASE("Idle replay ticks stay compact", "[replay]") {
+    ReplayRecorder rec("unused.lsr", 500);
+    rec.begin({1u, "Desert", Difficulty::Normal, {}});
+    std::vector<uint8_t> file;
+    write(rec, file);
+    auto empty_size = file.size();
+    for (int i = 0; i < 1000; ++i) rec.record(1.0f / 60.0f, InputFrame{});
+    write(rec, file);
+    // One float of frame time plus one byte of buttons per tick, and each of the two chunks' framing
+    CHECK(file.size() - empty_size == 1000 * (sizeof(float) + 1) + 2 * REPLAY_CHUNK_HEADER);
+}
+
+TEST_CASE("Replays are handed out chunk by chunk and a cut-off file plays to its last whole chunk", "[replay]") {
+    ReplayRecorder rec("unused.lsr", 4);
+    rec.begin({9u, "Forest", Difficulty::Normal, {}});
+    CHECK(rec.starts_file());
+    std::vector<uint8_t> file;
+    write(rec, file);
+
+    InputFrame moving;
+    moving.buttons = input_bits::MOVE_RIGHT;
+    for (int i = 0; i < 10; ++i) {
+        rec.record(0.016f, moving);
+        CHECK(rec.has_pending() == (i == 3 || i == 7)); // only whole chunks are ready
+        write(rec, file);
+    }
+    CHECK_FALSE(rec.starts_file());
+
+    // The process dies partway through writing the last chunk
+    rec.end();
+    auto last = rec.take();
+    auto crashed = file;
+    crashed.insert(crashed.end(), last.begin(), last.begin() + 6);
+
+    ReplayPlayer player;
+    REQUIRE(player.load(crashed).has_value());
+    float dt{};
+    InputFrame frame;
+    while (player.next(dt, frame)) CHECK(frame.held(input_bits::MOVE_RIGHT));
+    CHECK(player.ticks() == 8);
+    CHECK(player.truncated());
+
+    // A flipped byte inside a chunk stops playback before that chunk
+    auto damaged = file;
+    damaged.back() ^= 0xFF;
+    REQUIRE(player.load(damaged).has_value());
+    while (player.next(dt, frame)) {}
+    CHECK(player.ticks() == 4);
+    CHECK(player.truncated());
+}
+
+TEST_CASE("ReplayPlayer rejects snapshots and garbage", "[replay]") {
+    SnapshotWriter out;
+    out(uint32_t{7});
+    ReplayPlayer player;
+    CHECK_FALSE(player.load(seal_snapshot(out.bytes())).has_value());
+    CHECK_FALSE(player.load({1, 2, 3}).has_value());
+}
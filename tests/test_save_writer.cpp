@@ -0,0 +1,102 @@
+#include "managers/save_writer.hpp"
+#include <catch2/catch_test_macros.hpp>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+
+using namespace ls;
+
+static std::string read_all(const std::filesystem::path& p) {
+    std::ifstream f(p, std::ios::binary);
+    return {std::istreambuf_iterator<char>(f), std::istreambuf_iterator<char>()};
+}
+
+static std::vector<uint8_t> bytes_of(const std::string& s) { return {s.begin(), s.end()}; }
+
+TEST_CASE("write_file_atomic replaces the file and leaves no temp behind", "[save]") {
+    auto path = (std::filesystem::temp_directory_path() / "ls_test_atomic.bin").string();
+    REQUIRE(write_file_atomic(path, bytes_of("first")).has_value());
+    REQUIRE(write_file_atomic(path, bytes_of("second")).has_value());
+    CHECK(read_all(path) == "second");
+    CHECK_FALSE(std::filesystem::exists(path + ".tmp"));
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("write_file_atomic reports unwritable paths", "[save]") {
+    auto path = (std::filesystem::temp_directory_path() / "ls_no_such_dir" / "save.bin").string();
+    CHECK_FALSE(write_file_atomic(path, bytes_of("x")).has_value());
+}
+
+TEST_CASE("SaveWriter writes in the background and flush waits for it", "[save]") {
+    auto dir = std::filesystem::temp_directory_path();
+    auto a = (dir / "ls_test_writer_a.bin").string();
+    auto b = (dir / "ls_test_writer_b.bin").string();
+    SaveWriter writer;
+    writer.submit(a, bytes_of("alpha"));
+    writer.submit(b, bytes_of("beta"));
+    writer.submit(a, bytes_of("alpha2"));
+    writer.flush();
+    CHECK(read_all(a) == "alpha2");
+    CHECK(read_all(b) == "beta");
+    CHECK_FALSE(writer.take_error().has_value());
+    std::filesystem::remove(a);
+    std::filesystem::remove(b);
+}
+
+TEST_CASE("SaveWriter appends after queued writes to the same file, in order", "[save]") {
+    auto path = (std::filesystem::temp_directory_path() / "ls_test_writer_append.bin").string();
+    SaveWriter writer;
+    writer.submit(path, bytes_of("head"));
+    writer.append(path, bytes_of("-a"));
+    writer.append(path, bytes_of("-b"));
+    writer.flush();
+    CHECK(read_all(path) == "head-a-b");
+
+    writer.append(path, bytes_of("-c"));
+    writer.submit(path, bytes_of("new"));
+    writer.append(path, bytes_of("+"));
+    writer.flush();
+    CHECK(read_all(path) == "new+");
+    CHECK_FALSE(writer.take_error().has_value());
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("SaveWriter runs the finish step on submitted bytes only", "[save]") {
+    auto path = (std::filesystem::temp_directory_path() / "ls_test_writer_finish.bin").string();
+    auto bracket = [](std::vector<uint8_t> d) {
+        d.insert(d.begin(), '[');
+        d.push_back(']');
+        return d;
+    };
+    SaveWriter writer;
+    writer.submit(path, bytes_of("x"), bracket);
+    writer.append(path, bytes_of("-tail"));
+    writer.flush();
+    CHECK(read_all(path) == "[x]-tail");
+
+    writer.submit(path, bytes_of("old"), bracket);
+    writer.submit(path, bytes_of("new"));
+    writer.flush();
+    CHECK(read_all(path) == "new");
+    CHECK_FALSE(writer.take_error().has_value());
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("SaveWriter drains pending writes on destruction", "[save]") {
+    auto path = (std::filesystem::temp_directory_path() / "ls_test_writer_drain.bin").string();
+    {
+        SaveWriter writer;
+        writer.submit(path, bytes_of("drained"));
+    }
+    CHECK(read_all(path) == "drained");
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("SaveWriter surfaces background write errors", "[save]") {
+    auto path = (std::filesystem::temp_directory_path() / "ls_no_such_dir" / "save.bin").string();
+    SaveWriter writer;
+    writer.submit(path, bytes_of("x"));
+    writer.flush();
+    CHECK(writer.take_error().has_value());
+    CHECK_FALSE(writer.take_error().has_value());
+}
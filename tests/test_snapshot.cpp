@@ -0,0 +1,99 @@
+#include "core/snapshot.hpp"
+#include <catch2/catch_test_macros.hpp>
+
+using namespace ls;
+
+static std::vector<uint8_t> snapshot_of(const entt::registry& reg) {
+    SnapshotWriter out;
+    save_registry(reg, out);
+    return seal_snapshot(out.bytes());
+}
+
+TEST_CASE("Registry snapshot round-trips components and entity references", "[snapshot]") {
+    entt::registry src;
+    auto enemy = src.create();
+    src.emplace<Transform>(enemy, Vec2{12.0f, 34.0f}, 0.5f, 1.0f);
+    src.emplace<Health>(enemy, 40, 100, 3);
+    src.emplace<Sprite>(enemy, RED, 2, 30.0f, 30.0f, true, std::string("enemy_grunt"));
+    auto path = make_path({{0, 0}, {48, 0}, {48, 96}});
+    src.emplace<PathFollower>(enemy, path, size_t{1}, 80.0f, 80.0f, 30.0f);
+    src.emplace<Flying>(enemy);
+
+    auto tower = src.create();
+    auto& t = src.emplace<Tower>(tower);
+    t.type = TowerType::Ice;
+    t.level = 2;
+    t.target = enemy;
+    src.emplace<GridCell>(tower, GridPos{5, 7});
+
+    auto doomed = src.create();
+    src.destroy(doomed);
+
+    auto bytes = snapshot_of(src);
+    auto payload = open_snapshot(bytes);
+    REQUIRE(payload.has_value());
+
+    entt::registry dst;
+    SnapshotReader in(*payload);
+    load_registry(dst, in);
+    REQUIRE_FALSE(in.failed());
+    CHECK(in.remaining() == 0);
+
+    REQUIRE(dst.valid(enemy));
+    REQUIRE(dst.valid(tower));
+    CHECK_FALSE(dst.valid(doomed));
+    CHECK(dst.get<Transform>(enemy).position == Vec2{12.0f, 34.0f});
+    CHECK(dst.get<Health>(enemy).current == 40);
+    CHECK(dst.get<Sprite>(enemy).texture_name == "enemy_grunt");
+    CHECK(dst.get<Sprite>(enemy).layer == 2);
+    REQUIRE(dst.get<PathFollower>(enemy).path);
+    CHECK(dst.get<PathFollower>(enemy).path->size() == 3);
+    CHECK(dst.get<PathFollower>(enemy).path->length() == 144.0f);
+    CHECK(dst.get<PathFollower>(enemy).current_index == 1);
+    CHECK(dst.get<PathFollower>(enemy).distance == 30.0f);
+    CHECK(dst.all_of<Flying>(enemy));
+    CHECK(dst.get<Tower>(tower).target == enemy);
+    CHECK(dst.get<Tower>(tower).type == TowerType::Ice);
+    CHECK(dst.get<GridCell>(tower).pos == GridPos{5, 7});
+
+    // Entities created after load must not collide with restored ones
+    auto fresh = dst.create();
+    CHECK(fresh != enemy);
+    CHECK(fresh != tower);
+}
+
+TEST_CASE("Snapshot header rejects corrupt or foreign data", "[snapshot]") {
+    entt::registry reg;
+    reg.emplace<Transform>(reg.create());
+    auto bytes = snapshot_of(reg);
+
+    SECTION("truncated") {
+        bytes.resize(bytes.size() - 1);
+        CHECK_FALSE(open_snapshot(bytes).has_value());
+    }
+    SECTION("checksum mismatch") {
+        bytes.back() ^= 0xFF;
+        CHECK_FALSE(open_snapshot(bytes).has_value());
+    }
+    SECTION("wrong version") {
+        bytes[4] = static_cast<uint8_t>(SNAPSHOT_VERSION + 1);
+        CHECK_FALSE(open_snapshot(bytes).has_value());
+    }
+    SECTION("not a snapshot") {
+        bytes[0] = '{';
+        CHECK_FALSE(open_snapshot(bytes).has_value());
+    }
+}
+
+TEST_CASE("SnapshotReader flags reads past the end", "[snapshot]") {
+    SnapshotWriter out;
+    out(std::string("hello"));
+    auto bytes = out.bytes();
+    bytes.resize(bytes.size() - 2);
+
+    SnapshotReader in(bytes);
+    std::string s;
+    in(s);
+    CHECK(in.failed());
+    CHECK(s.empty());
+}
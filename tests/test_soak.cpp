@@ -0,0 +1,71 @@
+#include "core/soak_test.hpp"
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+using namespace ls;
+using Catch::Matchers::WithinAbs;
+
+static SoakSample sample(size_t rss_kb, size_t entities = 40, size_t pool_capacity = 4096, size_t assets = 80,
+                         int gold = 600) {
+    return {.map = "forest",
+            .gold_collected = gold,
+            .rss_kb = rss_kb,
+            .entities = entities,
+            .pool_capacity = pool_capacity,
+            .assets = assets};
+}
+
+TEST_CASE("A flat soak run passes", "[soak]") {
+    SoakTest soak(8);
+    for (size_t rss : {90'000u, 95'000u, 96'000u, 96'500u, 95'800u, 96'200u, 96'100u, 96'300u}) {
+        CHECK_FALSE(soak.finished());
+        soak.record(sample(rss));
+    }
+    CHECK(soak.finished());
+    CHECK(soak.check().has_value());
+    CHECK(soak.report().find("forest") != std::string::npos);
+}
+
+TEST_CASE("Soak matches get consecutive seeds", "[soak]") {
+    SoakTest soak(3, 100);
+    CHECK(soak.match_seed() == 100);
+    soak.record(sample(1000));
+    CHECK(soak.match_seed() == 101);
+}
+
+TEST_CASE("Steady RSS growth fails even below the slack", "[soak]") {
+    SoakTest soak(20);
+    for (size_t i = 0; i < 20; ++i) soak.record(sample(100'000 + i * 512)); // 0.5 MB per match
+    CHECK_THAT(soak.rss_slope_kb(), WithinAbs(512.0, 1e-6));
+    auto result = soak.check();
+    REQUIRE_FALSE(result.has_value());
+    CHECK(result.error().find("per match") != std::string::npos);
+    CHECK(result.error().find("RSS KB") == std::string::npos); // 8.5 MB is still inside the slack
+}
+
+TEST_CASE("Pools, entities and assets are compared with the warm-up baseline", "[soak]") {
+    SoakTest soak(5);
+    for (int i = 0; i < 3; ++i) soak.record(sample(100'000));
+    soak.record(sample(100'000, 40, 8192)); // one more doubling is allowed
+    CHECK(soak.check().has_value());
+
+    soak.record(sample(100'000, 400, 16384, 81));
+    auto result = soak.check();
+    REQUIRE_FALSE(result.has_value());
+    CHECK(result.error().find("pool capacity 16384") != std::string::npos);
+    CHECK(result.error().find("live entities 400") != std::string::npos);
+    CHECK(result.error().find("loaded assets 81") != std::string::npos);
+    CHECK(result.error().find("match 5 (forest)") != std::string::npos);
+}
+
+TEST_CASE("A match where the bot collected no coins fails", "[soak]") {
+    SoakTest soak(5);
+    for (int i = 0; i < 4; ++i) soak.record(sample(100'000));
+    CHECK(soak.check().has_value());
+
+    soak.record(sample(100'000, 40, 4096, 80, 0));
+    auto result = soak.check();
+    REQUIRE_FALSE(result.has_value());
+    CHECK(result.error().find("match 5 (forest): the bot collected no coins") != std::string::npos);
+    CHECK(soak.report().find("gold") != std::string::npos);
+}
@@ -0,0 +1,100 @@
+#include "core/random.hpp"
+#include "core/spatial_grid.hpp"
+#include <algorithm>
+#include <catch2/catch_test_macros.hpp>
+#include <set>
+#include <utility>
+
+using namespace ls;
+
+using Pair = std::pair<uint32_t, uint32_t>;
+
+static Pair key(const SpatialGrid::Item& a, const SpatialGrid::Item& b) {
+    auto x = static_cast<uint32_t>(a.entity), y = static_cast<uint32_t>(b.entity);
+    return {std::min(x, y), std::max(x, y)};
+}
+
+TEST_CASE("Grid pairs include every pair within the cell size, once each", "[spatial_grid]") {
+    Pcg32 rng(9, 1);
+    SpatialGrid grid;
+    std::vector<SpatialGrid::Item> points;
+    for (uint32_t i = 0; i < 400; ++i) {
+        points.push_back({static_cast<entt::entity>(i), {rng.range(0.0f, 900.0f), rng.range(0.0f, 500.0f)}});
+    }
+    // A tight clump, like enemies queued on a path corner
+    for (uint32_t i = 400; i < 460; ++i) {
+        points.push_back({static_cast<entt::entity>(i), {rng.range(300.0f, 310.0f), rng.range(200.0f, 210.0f)}});
+    }
+    constexpr float REACH = 14.0f;
+
+    grid.clear();
+    for (auto& p : points) grid.insert(p.entity, p.pos);
+    grid.build(REACH);
+
+    std::set<Pair> candidates;
+    size_t calls = 0;
+    grid.for_each_pair([&](const SpatialGrid::Item& a, const SpatialGrid::Item& b) {
+        candidates.insert(key(a, b));
+        ++calls;
+    });
+    CHECK(calls == candidates.size()); // no pair twice
+
+    size_t close = 0;
+    for (size_t i = 0; i < points.size(); ++i) {
+        for (size_t j = i + 1; j < points.size(); ++j) {
+            if (points[i].pos.distance_to(points[j].pos) >= REACH) continue;
+            ++close;
+            CHECK(candidates.contains(key(points[i], points[j])));
+        }
+    }
+    CHECK(close > 0);
+    CHECK(candidates.size() < points.size() * points.size() / 20); // far fewer than all pairs
+}
+
+TEST_CASE("Grid queries return the items near a point and survive rebuilds", "[spatial_grid]") {
+    SpatialGrid grid;
+    grid.insert(static_cast<entt::entity>(1), {10, 10});
+    grid.insert(static_cast<entt::entity>(2), {30, 10});
+    grid.insert(static_cast<entt::entity>(3), {500, 500});
+    grid.build(20.0f);
+
+    std::set<uint32_t> near;
+    grid.query({12, 12}, 20.0f, [&](const SpatialGrid::Item& it) { near.insert(static_cast<uint32_t>(it.entity)); });
+    CHECK(near.contains(1));
+    CHECK(near.contains(2));
+    CHECK_FALSE(near.contains(3));
+
+    grid.clear();
+    grid.build(20.0f);
+    size_t calls = 0;
+    grid.for_each_pair([&](auto&, auto&) { ++calls; });
+    grid.query({12, 12}, 100.0f, [&](auto&) { ++calls; });
+    CHECK(calls == 0);
+}
+
+TEST_CASE("Segment queries return the items along a sweep and skip the rest of its bounding box",
+          "[spatial_grid]") {
+    SpatialGrid grid;
+    // A diagonal line of items plus the opposite corners of its bounding box
+    for (uint32_t i = 0; i < 10; ++i) {
+        float p = static_cast<float>(i) * 50.0f;
+        grid.insert(static_cast<entt::entity>(i), {p, p});
+    }
+    grid.insert(static_cast<entt::entity>(100), {450, 0});
+    grid.insert(static_cast<entt::entity>(101), {0, 450});
+    grid.build(20.0f);
+
+    std::set<uint32_t> seen;
+    grid.query_segment({0, 0}, {450, 450}, 10.0f,
+                       [&](const SpatialGrid::Item& it) { seen.insert(static_cast<uint32_t>(it.entity)); });
+    for (uint32_t i = 0; i < 10; ++i) CHECK(seen.contains(i));
+    CHECK_FALSE(seen.contains(100));
+    CHECK_FALSE(seen.contains(101));
+
+    // A zero-length sweep is a point query
+    seen.clear();
+    grid.query_segment({100, 100}, {100, 100}, 5.0f,
+                       [&](const SpatialGrid::Item& it) { seen.insert(static_cast<uint32_t>(it.entity)); });
+    CHECK(seen.contains(2));
+    CHECK_FALSE(seen.contains(0));
+}
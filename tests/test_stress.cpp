@@ -0,0 +1,52 @@
+#include "core/stress_test.hpp"
+#include <catch2/catch_test_macros.hpp>
+
+using namespace ls;
+
+static void feed(StressTest& st, float frame_seconds, float duration, EntityCounts counts) {
+    for (float t = 0.0f; t < duration; t += frame_seconds) st.record_frame(frame_seconds, counts);
+}
+
+TEST_CASE("Fast frames never cross a budget", "[stress]") {
+    StressTest st;
+    feed(st, 1.0f / 120.0f, 5.0f, {.enemies = 10, .total = 40});
+    CHECK_FALSE(st.mark_60fps());
+    CHECK_FALSE(st.mark_30fps());
+    CHECK_FALSE(st.finished());
+    CHECK(st.capacity_score() == 40); // falls back to the peak
+}
+
+TEST_CASE("Budgets are marked in order and the run ends at 33 ms", "[stress]") {
+    StressTest st;
+    feed(st, 1.0f / 120.0f, StressTest::WARMUP + 1.0f, {.total = 100});
+    feed(st, 0.020f, 1.0f, {.enemies = 900, .total = 1000});
+    REQUIRE(st.mark_60fps());
+    CHECK_FALSE(st.mark_30fps());
+    CHECK(st.mark_60fps()->counts.enemies == 900);
+
+    feed(st, 0.040f, 1.0f, {.total = 3000});
+    REQUIRE(st.mark_30fps());
+    CHECK(st.finished());
+    CHECK(st.capacity_score() == 1000);
+
+    // Finished runs ignore further frames
+    feed(st, 0.001f, 1.0f, {.total = 9000});
+    CHECK(st.capacity_score() == 1000);
+}
+
+TEST_CASE("Load hitches during warm-up are ignored", "[stress]") {
+    StressTest st;
+    st.record_frame(0.5f, {.total = 1});
+    feed(st, 1.0f / 120.0f, StressTest::WARMUP, {.total = 1});
+    CHECK_FALSE(st.mark_60fps());
+}
+
+TEST_CASE("Spawn ramp follows the spawn rate", "[stress]") {
+    StressTest st;
+    int spawned = 0;
+    for (int i = 0; i < 600; ++i) spawned += st.advance(1.0f / 60.0f);
+    // Integral of 20 + 20t over 10 s
+    CHECK(spawned >= 1190);
+    CHECK(spawned <= 1215);
+    CHECK(st.elapsed() > 9.99f);
+}
@@ -0,0 +1,55 @@
+#include "core/tower_grid.hpp"
+#include <catch2/catch_test_macros.hpp>
+#include <vector>
+
+using namespace ls;
+
+static entt::entity id(uint32_t n) { return static_cast<entt::entity>(n); }
+
+// World position of a cell centre, as MapData::grid_to_world places towers
+static Vec2 centre(GridPos p) {
+    return {static_cast<float>(GRID_OFFSET_X + p.x * TILE_SIZE + TILE_SIZE / 2),
+            static_cast<float>(GRID_OFFSET_Y + p.y * TILE_SIZE + TILE_SIZE / 2)};
+}
+
+TEST_CASE("Tower grid maps cells to towers", "[tower_grid]") {
+    TowerGrid grid;
+    CHECK(grid.at({3, 4}) == entt::null);
+    CHECK_FALSE(grid.occupied({-1, 0}));
+
+    grid.place({3, 4}, id(7));
+    grid.place({40, 20}, id(8)); // grows without losing the first tower
+    CHECK(grid.at({3, 4}) == id(7));
+    CHECK(grid.at({40, 20}) == id(8));
+    CHECK(grid.occupied({40, 20}));
+    CHECK(grid.size() == 2);
+
+    grid.place({3, 4}, id(9)); // replacing keeps the count
+    CHECK(grid.size() == 2);
+    grid.remove({3, 4});
+    grid.remove({3, 4});
+    grid.remove({100, 100});
+    CHECK(grid.size() == 1);
+    CHECK_FALSE(grid.occupied({3, 4}));
+
+    grid.clear();
+    CHECK(grid.size() == 0);
+    CHECK(grid.at({40, 20}) == entt::null);
+}
+
+TEST_CASE("Radius queries visit only towers on the covered cells", "[tower_grid]") {
+    TowerGrid grid;
+    grid.place({10, 10}, id(1));
+    grid.place({11, 10}, id(2));
+    grid.place({14, 10}, id(3));
+    grid.place({0, 0}, id(4));
+
+    std::vector<entt::entity> seen;
+    grid.for_each_near(centre({10, 10}), TILE_SIZE * 1.5f, [&](entt::entity e) { seen.push_back(e); });
+    CHECK(seen == std::vector<entt::entity>{id(1), id(2)});
+
+    // A circle hanging off the map edge is clamped to the grid
+    seen.clear();
+    grid.for_each_near({0, 0}, TILE_SIZE * 3.0f, [&](entt::entity e) { seen.push_back(e); });
+    CHECK(seen == std::vector<entt::entity>{id(4)});
+}
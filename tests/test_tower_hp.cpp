@@ -10,11 +10,12 @@ TEST_CASE("Tower HP base values per type", "[tower_hp]") {
     CHECK(tower_max_hp(TowerType::Lightning, 1) == 100);
     CHECK(tower_max_hp(TowerType::Poison, 1) == 90);
     CHECK(tower_max_hp(TowerType::Laser, 1) == 120);
+    CHECK(tower_max_hp(TowerType::Ballista, 1) == 110);
 }
 
 TEST_CASE("Tower HP increases +30 per level", "[tower_hp]") {
-    TowerType types[] = {TowerType::Arrow,     TowerType::Cannon, TowerType::Ice,
-                         TowerType::Lightning, TowerType::Poison, TowerType::Laser};
+    TowerType types[] = {TowerType::Arrow,  TowerType::Cannon, TowerType::Ice,     TowerType::Lightning,
+                         TowerType::Poison, TowerType::Laser,  TowerType::Ballista};
     for (auto t : types) {
         int hp1 = tower_max_hp(t, 1);
         int hp2 = tower_max_hp(t, 2);
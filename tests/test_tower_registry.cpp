@@ -5,8 +5,8 @@ using namespace ls;
 
 TEST_CASE("All tower types exist at levels 1-3", "[tower_reg]") {
     TowerRegistry reg;
-    TowerType types[] = {TowerType::Arrow,     TowerType::Cannon, TowerType::Ice,
-                         TowerType::Lightning, TowerType::Poison, TowerType::Laser};
+    TowerType types[] = {TowerType::Arrow,  TowerType::Cannon, TowerType::Ice,     TowerType::Lightning,
+                         TowerType::Poison, TowerType::Laser,  TowerType::Ballista};
     for (auto t : types) {
         for (int lvl = 1; lvl <= 3; ++lvl) {
             auto& stats = reg.get(t, lvl);
@@ -18,8 +18,8 @@ TEST_CASE("All tower types exist at levels 1-3", "[tower_reg]") {
 
 TEST_CASE("Cost increases with level for all towers", "[tower_reg]") {
     TowerRegistry reg;
-    TowerType types[] = {TowerType::Arrow,     TowerType::Cannon, TowerType::Ice,
-                         TowerType::Lightning, TowerType::Poison, TowerType::Laser};
+    TowerType types[] = {TowerType::Arrow,  TowerType::Cannon, TowerType::Ice,     TowerType::Lightning,
+                         TowerType::Poison, TowerType::Laser,  TowerType::Ballista};
     for (auto t : types) {
         CHECK(reg.get(t, 2).cost > reg.get(t, 1).cost);
         CHECK(reg.get(t, 3).cost > reg.get(t, 2).cost);
@@ -35,8 +35,8 @@ TEST_CASE("Arrow L1 cost=50 damage=15", "[tower_reg]") {
 
 TEST_CASE("upgrade_cost at max level returns 0", "[tower_reg]") {
     TowerRegistry reg;
-    TowerType types[] = {TowerType::Arrow,     TowerType::Cannon, TowerType::Ice,
-                         TowerType::Lightning, TowerType::Poison, TowerType::Laser};
+    TowerType types[] = {TowerType::Arrow,  TowerType::Cannon, TowerType::Ice,     TowerType::Lightning,
+                         TowerType::Poison, TowerType::Laser,  TowerType::Ballista};
     for (auto t : types) {
         CHECK(reg.upgrade_cost(t, 3) == 0);
     }
@@ -44,9 +44,17 @@ TEST_CASE("upgrade_cost at max level returns 0", "[tower_reg]") {
 
 TEST_CASE("upgrade_cost at L1 equals L2 cost", "[tower_reg]") {
     TowerRegistry reg;
-    TowerType types[] = {TowerType::Arrow,     TowerType::Cannon, TowerType::Ice,
-                         TowerType::Lightning, TowerType::Poison, TowerType::Laser};
+    TowerType types[] = {TowerType::Arrow,  TowerType::Cannon, TowerType::Ice,     TowerType::Lightning,
+                         TowerType::Poison, TowerType::Laser,  TowerType::Ballista};
     for (auto t : types) {
         CHECK(reg.upgrade_cost(t, 1) == reg.get(t, 2).cost);
     }
 }
+
+TEST_CASE("Ballista bolts pierce more enemies with each level", "[tower_reg]") {
+    TowerRegistry reg;
+    CHECK(reg.get(TowerType::Arrow, 3).pierce == 0);
+    CHECK(reg.get(TowerType::Ballista, 1).pierce > 0);
+    CHECK(reg.get(TowerType::Ballista, 2).pierce > reg.get(TowerType::Ballista, 1).pierce);
+    CHECK(reg.get(TowerType::Ballista, 3).pierce > reg.get(TowerType::Ballista, 2).pierce);
+}
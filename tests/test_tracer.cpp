@@ -0,0 +1,67 @@
+#include "core/tracer.hpp"
+#include <catch2/catch_test_macros.hpp>
+#include <thread>
+
+using namespace ls;
+
+TEST_CASE("Tracer ignores spans until a capture starts", "[tracer]") {
+    Tracer t;
+    auto now = Tracer::Clock::now();
+    t.record("hero_system", "system", now, now);
+    CHECK(t.event_count() == 0);
+
+    t.start();
+    t.record("hero_system", "system", now, now);
+    CHECK(t.event_count() == 1);
+    t.stop();
+    t.record("hero_system", "system", now, now);
+    CHECK(t.event_count() == 1);
+
+    t.start(); // a new capture discards the old one
+    CHECK(t.event_count() == 0);
+}
+
+TEST_CASE("Tracer writes complete events with thread ids", "[tracer]") {
+    Tracer t;
+    t.name_thread("main");
+    t.start();
+    auto begin = Tracer::Clock::now();
+    t.record("recalculate_path", "path", begin, begin + std::chrono::microseconds(250));
+    std::thread worker([&] {
+        t.name_thread("save_writer");
+        auto b = Tracer::Clock::now();
+        t.record("write_file", "save", b, b, "C:\\saves\\\"slot\".bin");
+    });
+    worker.join();
+
+    auto json = t.to_json();
+    CHECK(json.starts_with("{\"displayTimeUnit\":\"ms\",\"traceEvents\":["));
+    CHECK(json.find("\"args\":{\"name\":\"main\"}") != std::string::npos);
+    CHECK(json.find("\"args\":{\"name\":\"save_writer\"}") != std::string::npos);
+    CHECK(json.find("\"name\":\"recalculate_path\",\"cat\":\"path\",\"ph\":\"X\"") != std::string::npos);
+    CHECK(json.find("\"dur\":250.000") != std::string::npos);
+    CHECK(json.find("C:\\\\saves\\\\\\\"slot\\\".bin") != std::string::npos); // escaped detail
+
+    // The worker's events carry its own tid
+    auto tid_of = [&](const std::string& name) {
+        auto pos = json.find("\"name\":\"" + name + "\"");
+        auto tid = json.find("\"tid\":", pos);
+        return json.substr(tid, json.find_first_of(",}", tid) - tid);
+    };
+    CHECK(tid_of("write_file") != tid_of("recalculate_path"));
+}
+
+TEST_CASE("TraceScope records only while tracing", "[tracer]") {
+    auto& t = tracer();
+    t.stop();
+    bool built = false;
+    { TraceScope s("idle", "test", [&] { built = true; return std::string("x"); }); }
+    CHECK_FALSE(built);
+
+    t.start();
+    { TraceScope s("busy", "test", [&] { built = true; return std::string("detail"); }); }
+    t.stop();
+    CHECK(built);
+    CHECK(t.event_count() == 1);
+    CHECK(t.to_json().find("\"detail\":\"detail\"") != std::string::npos);
+}